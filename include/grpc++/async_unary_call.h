@@ -50,8 +50,21 @@ class ClientAsyncResponseReader GRPC_FINAL {
   ClientAsyncResponseReader(ChannelInterface* channel, CompletionQueue* cq,
                     const RpcMethod& method, ClientContext* context,
                     const grpc::protobuf::Message& request, void* tag)
-      : context_(context),
-        call_(channel->CreateCall(method, context, cq)) {
+      : context_(nullptr), call_(nullptr, nullptr, nullptr) {
+    Start(channel, cq, method, context, request, tag);
+  }
+
+  // Creates a reader with no call. Start must be called before any other
+  // method. Lets the caller keep readers in its own storage and reuse them.
+  ClientAsyncResponseReader()
+      : context_(nullptr), call_(nullptr, nullptr, nullptr) {}
+
+  // Start a new call on this reader. Any previous call must have finished.
+  void Start(ChannelInterface* channel, CompletionQueue* cq,
+             const RpcMethod& method, ClientContext* context,
+             const grpc::protobuf::Message& request, void* tag) {
+    context_ = context;
+    call_ = channel->CreateCall(method, context, cq);
     init_buf_.Reset(tag);
     init_buf_.AddSendInitialMetadata(&context->send_initial_metadata_);
     init_buf_.AddSendMessage(request);
@@ -34,6 +34,9 @@
 #ifndef GRPCXX_COMPLETION_QUEUE_H
 #define GRPCXX_COMPLETION_QUEUE_H
 
+#include <chrono>
+
+#include <grpc/support/time.h>
 #include <grpc++/impl/client_unary_call.h>
 
 struct grpc_completion_queue;
@@ -80,6 +83,14 @@ class CompletionQueue {
   // for destruction.
   bool Next(void **tag, bool *ok);
 
+  // Tri-state return for AsyncNext: SHUTDOWN, GOT_EVENT, TIMEOUT
+  enum NextStatus { SHUTDOWN, GOT_EVENT, TIMEOUT };
+
+  // Read from queue, blocking until deadline at the latest.
+  // *tag and *ok are only set if GOT_EVENT is returned.
+  NextStatus AsyncNext(void **tag, bool *ok,
+                       std::chrono::system_clock::time_point deadline);
+
   // Shutdown has to be called, and the CompletionQueue can only be
   // destructed when false is returned from Next().
   void Shutdown();
@@ -109,6 +120,8 @@ class CompletionQueue {
                                   const grpc::protobuf::Message &request,
                                   grpc::protobuf::Message *result);
 
+  NextStatus NextInternal(void **tag, bool *ok, gpr_timespec deadline);
+
   // Wraps grpc_completion_queue_pluck.
   // Cannot be mixed with calls to Next().
   bool Pluck(CompletionQueueTag *tag);
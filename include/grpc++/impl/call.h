@@ -80,11 +80,22 @@ class CallOpBuffer : public CompletionQueueTag {
   bool got_message;
 
  private:
+  // Metadata arrays up to this size are passed to the core from storage in
+  // the buffer instead of being allocated for each batch.
+  static const size_t kInlineMetadata = 4;
+
+  grpc_metadata *FillMetadataArray(
+      std::multimap<grpc::string, grpc::string> *metadata,
+      grpc_metadata *storage);
+  static void ReleaseMetadataArray(grpc_metadata **array,
+                                   grpc_metadata *storage);
+
   void *return_tag_;
   // Send initial metadata
   bool send_initial_metadata_;
   size_t initial_metadata_count_;
   grpc_metadata *initial_metadata_;
+  grpc_metadata initial_metadata_storage_[kInlineMetadata];
   // Recv initial metadta
   std::multimap<grpc::string, grpc::string> *recv_initial_metadata_;
   grpc_metadata_array recv_initial_metadata_arr_;
@@ -107,6 +118,7 @@ class CallOpBuffer : public CompletionQueueTag {
   const Status *send_status_;
   size_t trailing_metadata_count_;
   grpc_metadata *trailing_metadata_;
+  grpc_metadata trailing_metadata_storage_[kInlineMetadata];
   int cancelled_buf_;
   bool *recv_closed_;
 };
@@ -38,6 +38,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <grpc++/completion_queue.h>
 #include <grpc++/config.h>
@@ -75,7 +76,8 @@ class Server GRPC_FINAL : private CallHook,
   class AsyncRequest;
 
   // ServerBuilder use only
-  Server(ThreadPoolInterface* thread_pool, bool thread_pool_owned);
+  Server(ThreadPoolInterface* thread_pool, bool thread_pool_owned,
+         int num_sync_cqs);
   Server() = delete;
   // Register a service. This call does not take ownership of the service.
   // The service must exist for the lifetime of the Server instance.
@@ -87,8 +89,8 @@ class Server GRPC_FINAL : private CallHook,
   bool Start();
 
   void HandleQueueClosed();
-  void RunRpc();
-  void ScheduleCallback();
+  void RunRpc(CompletionQueue* cq);
+  void ScheduleCallback(CompletionQueue* cq);
 
   void PerformOpsOnCall(CallOpBuffer* ops, Call* call) GRPC_OVERRIDE;
 
@@ -96,10 +98,15 @@ class Server GRPC_FINAL : private CallHook,
   void RequestAsyncCall(void* registered_method, ServerContext* context,
                         grpc::protobuf::Message* request,
                         ServerAsyncStreamingInterface* stream,
-                        CompletionQueue* cq, void* tag) GRPC_OVERRIDE;
+                        CompletionQueue* call_cq,
+                        CompletionQueue* notification_cq,
+                        void* tag) GRPC_OVERRIDE;
 
   // Completion queue.
   CompletionQueue cq_;
+  // Completion queues that new sync rpcs are reported on. Each one always has
+  // a thread pool callback waiting on it.
+  std::vector<std::unique_ptr<CompletionQueue>> sync_cqs_;
 
   // Sever status
   std::mutex mu_;
@@ -73,6 +73,21 @@ class ServerBuilder {
   // Does not take ownership.
   void SetThreadPool(ThreadPoolInterface* thread_pool);
 
+  // Set the bounds on the number of threads in the thread pool the builder
+  // creates when no thread pool is set. Threads are added while rpcs are
+  // waiting for a free thread and removed after they have been idle. The
+  // default is one thread per sync completion queue plus one, growing up to
+  // four per core. max_threads is raised to one more than the number of
+  // sync completion queues if it is not already larger.
+  void SetThreadPoolSize(int min_threads, int max_threads);
+
+  // Set the number of completion queues that new synchronous rpcs are
+  // spread across (default 1). Each queue keeps one thread pool thread
+  // waiting on it. A pool given to SetThreadPool must have more threads than
+  // queues; the builder cannot check this, and queues without a spare
+  // thread are not served while their waiting thread runs an rpc.
+  void SetNumSyncCompletionQueues(int num_cqs);
+
   // Return a running server which is ready for processing rpcs.
   std::unique_ptr<Server> BuildAndStart();
 
@@ -88,6 +103,9 @@ class ServerBuilder {
   std::vector<Port> ports_;
   std::shared_ptr<ServerCredentials> creds_;
   ThreadPoolInterface* thread_pool_;
+  int num_sync_cqs_;
+  int min_threads_;
+  int max_threads_;
 };
 
 }  // namespace grpc
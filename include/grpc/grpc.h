@@ -111,6 +111,23 @@ typedef struct {
 #define GRPC_ARG_MAX_CONCURRENT_STREAMS "grpc.max_concurrent_streams"
 /* Maximum message length that the channel can receive */
 #define GRPC_ARG_MAX_MESSAGE_LENGTH "grpc.max_message_length"
+/* Opt-in write coalescing for http2 transports: when set to a positive
+   number of microseconds, writes carrying application data are held back
+   (for no longer than this) so that sends made close together go out in a
+   single write. Trades latency for fewer syscalls; off by default.
+   Even traffic with nothing to merge pays for it, since a held write waits
+   for the next poller iteration; only worth it for bursty senders. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCE_US "grpc.http2.write_coalesce_us"
+/* Largest http2 frame payload the transport will accept, and so advertise
+   to its peer (16384 to 16777215; default 16384). Larger frames cut the
+   per-frame overhead of bulk data. */
+#define GRPC_ARG_HTTP2_MAX_FRAME_SIZE "grpc.http2.max_frame_size"
+/* Comma separated list of (lower case) received metadata keys whose values
+   are expected to be unique per call - request ids, trace spans, tokens - and
+   so should not be cached by the transport. Pseudo-headers, grpc-*, te and
+   content-type are always cached, even if listed. */
+#define GRPC_ARG_HTTP2_UNINTERNED_METADATA_KEYS \
+  "grpc.http2.uninterned_metadata_keys"
 
 /* Result of a grpc call. If the caller satisfies the prerequisites of a
    particular operation, the grpc_call_error returned will be GRPC_CALL_OK.
@@ -380,6 +397,24 @@ grpc_completion_queue *grpc_completion_queue_create(void);
 grpc_event *grpc_completion_queue_next(grpc_completion_queue *cq,
                                        gpr_timespec deadline);
 
+/* A max_events for grpc_completion_queue_next_batch suited to language
+   wrappers that drain a queue from one thread: it amortizes the queue lock and
+   the interpreter lock handoff over many events, and keeps the event array
+   small enough for the stack. */
+#define GRPC_COMPLETION_QUEUE_BATCH_SIZE 32
+
+/* Like grpc_completion_queue_next, but once an event is available also takes
+   any others already queued, up to max_events, under a single acquisition of
+   the queue's lock. Stores the events in events[0..n) and returns n, or 0 on
+   timeout. A shut down and drained queue yields one GRPC_QUEUE_SHUTDOWN
+   event. Each returned event must be passed to grpc_event_finish.
+
+   Callers must not call grpc_completion_queue_next_batch and
+   grpc_completion_queue_pluck simultaneously on the same completion queue. */
+size_t grpc_completion_queue_next_batch(grpc_completion_queue *cq,
+                                        grpc_event **events, size_t max_events,
+                                        gpr_timespec deadline);
+
 /* Blocks until an event with tag 'tag' is available, the completion queue is
    being shutdown or deadline is reached. Returns NULL on timeout, or a pointer
    to the event that occurred. Callers should call grpc_event_finish once they
@@ -575,7 +610,15 @@ void grpc_call_destroy(grpc_call *call);
 grpc_call_error grpc_server_request_call_old(grpc_server *server,
                                              void *tag_new);
 
-/* Request notification of a new call */
+/* The most calls that may be requested on one server and not yet matched
+   with an incoming call, counting grpc_server_request_call and
+   grpc_server_request_registered_call together. Requesting more fails with
+   GRPC_CALL_ERROR_TOO_MANY_OPERATIONS, and tag_new is never returned. */
+#define GRPC_MAX_REQUESTED_CALLS 32768
+
+/* Request notification of a new call. Fails with
+   GRPC_CALL_ERROR_TOO_MANY_OPERATIONS if GRPC_MAX_REQUESTED_CALLS calls are
+   already requested. */
 grpc_call_error grpc_server_request_call(
     grpc_server *server, grpc_call **call, grpc_call_details *details,
     grpc_metadata_array *request_metadata,
@@ -587,18 +630,33 @@ grpc_call_error grpc_server_request_call(
    grpc_server_request_call, but instead be reported by
    grpc_server_request_registered_call when passed the appropriate
    registered_method (as returned by this function).
+   new_call_cq is registered with the server as if by
+   grpc_server_register_completion_queue.
    Must be called before grpc_server_start.
    Returns NULL on failure. */
 void *grpc_server_register_method(grpc_server *server, const char *method,
                                   const char *host,
                                   grpc_completion_queue *new_call_cq);
 
-/* Request notification of a new pre-registered call */
+/* Registers a completion queue that new pre-registered calls may be
+   reported on. The server polls all of its registered completion queues
+   for incoming connections and data.
+   Must be called before grpc_server_start. */
+void grpc_server_register_completion_queue(grpc_server *server,
+                                           grpc_completion_queue *cq);
+
+/* Request notification of a new pre-registered call. The notification is
+   delivered to cq_for_notification, which must have been registered with
+   the server. Requests for the same method may use different notification
+   queues, which lets several threads each wait on their own queue. Fails
+   with GRPC_CALL_ERROR_TOO_MANY_OPERATIONS if GRPC_MAX_REQUESTED_CALLS calls
+   are already requested. */
 grpc_call_error grpc_server_request_registered_call(
     grpc_server *server, void *registered_method, grpc_call **call,
     gpr_timespec *deadline, grpc_metadata_array *request_metadata,
     grpc_byte_buffer **optional_payload,
-    grpc_completion_queue *cq_bound_to_call, void *tag_new);
+    grpc_completion_queue *cq_bound_to_call,
+    grpc_completion_queue *cq_for_notification, void *tag_new);
 
 /* Create a server. Additional configuration for each incoming channel can
    be specified with args. If no additional configuration is needed, args can
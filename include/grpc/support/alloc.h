@@ -35,6 +35,7 @@
 #define GRPC_SUPPORT_ALLOC_H
 
 #include <stddef.h>
+#include <grpc/support/port_platform.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -51,6 +52,18 @@ void *gpr_malloc_aligned(size_t size, size_t alignment_log);
 /* free memory allocated by gpr_malloc_aligned */
 void gpr_free_aligned(void *ptr);
 
+/* Process wide allocation counters. Counting is off by default, so that it
+   costs gpr_malloc no more than an atomic load; benchmarks turn it on to report
+   allocations per operation. gpr_realloc counts as one allocation. */
+typedef struct {
+  gpr_int64 allocs;
+} gpr_alloc_stats;
+
+/* start (enable != 0) or stop counting allocations */
+void gpr_alloc_enable_counting(int enable);
+/* read the counters, which are cumulative since the process started */
+void gpr_alloc_get_stats(gpr_alloc_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,6 +69,30 @@ void gpr_histogram_merge_contents(gpr_histogram *histogram,
                                   double min_seen, double max_seen, double sum,
                                   double sum_of_squares, double count);
 
+/* A histogram that may be added to from many threads concurrently without
+   external locking. Samples are recorded into per-cpu shards whose counters
+   are updated with atomic operations, so recording threads never block each
+   other. The contents are read by merging a snapshot of all shards into a
+   regular gpr_histogram with the same resolution and max_bucket_start. */
+typedef struct gpr_concurrent_histogram gpr_concurrent_histogram;
+
+gpr_concurrent_histogram *gpr_concurrent_histogram_create(
+    double resolution, double max_bucket_start);
+void gpr_concurrent_histogram_destroy(gpr_concurrent_histogram *h);
+void gpr_concurrent_histogram_add(gpr_concurrent_histogram *h, double x);
+
+/* Merges a snapshot of src into dst. Samples added concurrently with the
+   merge may or may not be included. Returns 0 on failure (mismatched
+   buckets or resolution), 1 on success */
+int gpr_histogram_merge_concurrent(gpr_histogram *dst,
+                                   gpr_concurrent_histogram *src);
+
+/* As gpr_histogram_merge_concurrent, but also atomically removes the merged
+   samples from src, so that each sample is reported by exactly one call.
+   This allows periodic collection without pausing recording threads. */
+int gpr_histogram_merge_and_reset_concurrent(gpr_histogram *dst,
+                                             gpr_concurrent_histogram *src);
+
 #ifdef __cplusplus
 }
 #endif
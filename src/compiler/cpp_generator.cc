@@ -173,6 +173,7 @@ std::string GetSourceIncludes() {
 
 void PrintHeaderClientMethod(google::protobuf::io::Printer *printer,
                              const google::protobuf::MethodDescriptor *method,
+                             const Parameters &params,
                              std::map<std::string, std::string> *vars) {
   (*vars)["Method"] = method->name();
   (*vars)["Request"] =
@@ -189,6 +190,14 @@ void PrintHeaderClientMethod(google::protobuf::io::Printer *printer,
         "Async$Method$(::grpc::ClientContext* context, "
         "const $Request$& request, "
         "::grpc::CompletionQueue* cq, void* tag);\n");
+    if (params.in_place_async) {
+      printer->Print(
+          *vars,
+          "void Async$Method$(::grpc::ClientContext* context, "
+          "const $Request$& request, ::grpc::CompletionQueue* cq, "
+          "::grpc::ClientAsyncResponseReader< $Response$>* reader, "
+          "void* tag);\n");
+    }
   } else if (ClientOnlyStreaming(method)) {
     printer->Print(
         *vars,
@@ -296,6 +305,7 @@ void PrintHeaderServerMethodAsync(
 
 void PrintHeaderService(google::protobuf::io::Printer *printer,
                         const google::protobuf::ServiceDescriptor *service,
+                        const Parameters &params,
                         std::map<std::string, std::string> *vars) {
   (*vars)["Service"] = service->name();
 
@@ -310,7 +320,7 @@ void PrintHeaderService(google::protobuf::io::Printer *printer,
       " public:\n");
   printer->Indent();
   for (int i = 0; i < service->method_count(); ++i) {
-    PrintHeaderClientMethod(printer, service->method(i), vars);
+    PrintHeaderClientMethod(printer, service->method(i), params, vars);
   }
   printer->Outdent();
   printer->Print("};\n");
@@ -356,14 +366,15 @@ void PrintHeaderService(google::protobuf::io::Printer *printer,
   printer->Print("};\n");
 }
 
-std::string GetHeaderServices(const google::protobuf::FileDescriptor *file) {
+std::string GetHeaderServices(const google::protobuf::FileDescriptor *file,
+                              const Parameters &params) {
   std::string output;
   google::protobuf::io::StringOutputStream output_stream(&output);
   google::protobuf::io::Printer printer(&output_stream, '$');
   std::map<std::string, std::string> vars;
 
   for (int i = 0; i < file->service_count(); ++i) {
-    PrintHeaderService(&printer, file->service(i), &vars);
+    PrintHeaderService(&printer, file->service(i), params, &vars);
     printer.Print("\n");
   }
   return output;
@@ -371,6 +382,7 @@ std::string GetHeaderServices(const google::protobuf::FileDescriptor *file) {
 
 void PrintSourceClientMethod(google::protobuf::io::Printer *printer,
                              const google::protobuf::MethodDescriptor *method,
+                             const Parameters &params,
                              std::map<std::string, std::string> *vars) {
   (*vars)["Method"] = method->name();
   (*vars)["Request"] =
@@ -401,6 +413,20 @@ void PrintSourceClientMethod(google::protobuf::io::Printer *printer,
                    "::grpc::RpcMethod($Service$_method_names[$Idx$]), "
                    "context, request, tag));\n"
                    "}\n\n");
+    if (params.in_place_async) {
+      printer->Print(
+          *vars,
+          "void $Service$::Stub::Async$Method$("
+          "::grpc::ClientContext* context, const $Request$& request, "
+          "::grpc::CompletionQueue* cq, "
+          "::grpc::ClientAsyncResponseReader< $Response$>* reader, "
+          "void* tag) {\n");
+      printer->Print(*vars,
+                     "  reader->Start(channel(), cq, "
+                     "::grpc::RpcMethod($Service$_method_names[$Idx$]), "
+                     "context, request, tag);\n"
+                     "}\n\n");
+    }
   } else if (ClientOnlyStreaming(method)) {
     printer->Print(*vars,
                    "std::unique_ptr< ::grpc::ClientWriter< $Request$>> "
@@ -592,6 +618,7 @@ void PrintSourceServerAsyncMethod(
 
 void PrintSourceService(google::protobuf::io::Printer *printer,
                         const google::protobuf::ServiceDescriptor *service,
+                        const Parameters &params,
                         std::map<std::string, std::string> *vars) {
   (*vars)["Service"] = service->name();
 
@@ -612,7 +639,7 @@ void PrintSourceService(google::protobuf::io::Printer *printer,
       "}\n\n");
   for (int i = 0; i < service->method_count(); ++i) {
     (*vars)["Idx"] = as_string(i);
-    PrintSourceClientMethod(printer, service->method(i), vars);
+    PrintSourceClientMethod(printer, service->method(i), params, vars);
   }
 
   (*vars)["MethodCount"] = as_string(service->method_count());
@@ -705,7 +732,8 @@ void PrintSourceService(google::protobuf::io::Printer *printer,
   printer->Print("}\n\n");
 }
 
-std::string GetSourceServices(const google::protobuf::FileDescriptor *file) {
+std::string GetSourceServices(const google::protobuf::FileDescriptor *file,
+                              const Parameters &params) {
   std::string output;
   google::protobuf::io::StringOutputStream output_stream(&output);
   google::protobuf::io::Printer printer(&output_stream, '$');
@@ -718,7 +746,7 @@ std::string GetSourceServices(const google::protobuf::FileDescriptor *file) {
   }
 
   for (int i = 0; i < file->service_count(); ++i) {
-    PrintSourceService(&printer, file->service(i), &vars);
+    PrintSourceService(&printer, file->service(i), params, &vars);
     printer.Print("\n");
   }
   return output;
@@ -44,6 +44,17 @@ class FileDescriptor;
 
 namespace grpc_cpp_generator {
 
+// Contains all the parameters that are parsed from the command line.
+struct Parameters {
+  Parameters() : in_place_async(false) {}
+
+  // Also generate async unary methods that start the call in a reader object
+  // provided by the caller, so that the call needs no heap allocation.
+  // Streaming methods are generated as without this option: their readers
+  // and writers are still allocated per call.
+  bool in_place_async;
+};
+
 // Return the includes needed for generated header file.
 std::string GetHeaderIncludes(const google::protobuf::FileDescriptor *file);
 
@@ -51,10 +62,12 @@ std::string GetHeaderIncludes(const google::protobuf::FileDescriptor *file);
 std::string GetSourceIncludes();
 
 // Return the services for generated header file.
-std::string GetHeaderServices(const google::protobuf::FileDescriptor *file);
+std::string GetHeaderServices(const google::protobuf::FileDescriptor *file,
+                              const Parameters &params);
 
 // Return the services for generated source file.
-std::string GetSourceServices(const google::protobuf::FileDescriptor *file);
+std::string GetSourceServices(const google::protobuf::FileDescriptor *file,
+                              const Parameters &params);
 
 }  // namespace grpc_cpp_generator
 
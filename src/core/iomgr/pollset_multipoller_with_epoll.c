@@ -97,13 +97,9 @@ static int multipoll_with_epoll_pollset_maybe_work(
    * here.
    */
 
-  if (gpr_time_cmp(deadline, gpr_inf_future) == 0) {
-    timeout_ms = -1;
-  } else {
-    timeout_ms = gpr_time_to_millis(gpr_time_sub(deadline, now));
-    if (timeout_ms <= 0) {
-      return 1;
-    }
+  timeout_ms = grpc_poll_deadline_to_millis_timeout(deadline, now);
+  if (timeout_ms == 0) {
+    return 1;
   }
   pollset->counter += 1;
   gpr_mu_unlock(&pollset->mu);
@@ -114,13 +114,9 @@ static int multipoll_with_poll_pollset_maybe_work(
     return 0;
   }
   h = pollset->data.ptr;
-  if (gpr_time_cmp(deadline, gpr_inf_future) == 0) {
-    timeout = -1;
-  } else {
-    timeout = gpr_time_to_millis(gpr_time_sub(deadline, now));
-    if (timeout <= 0) {
-      return 1;
-    }
+  timeout = grpc_poll_deadline_to_millis_timeout(deadline, now);
+  if (timeout == 0) {
+    return 1;
   }
   if (h->pfd_capacity < h->fd_count + 1) {
     h->pfd_capacity = GPR_MAX(h->pfd_capacity * 3 / 2, h->fd_count + 1);
@@ -175,6 +175,20 @@ int grpc_pollset_work(grpc_pollset *pollset, gpr_timespec deadline) {
   return pollset->vtable->maybe_work(pollset, deadline, now, 1);
 }
 
+int grpc_poll_deadline_to_millis_timeout(gpr_timespec deadline,
+                                         gpr_timespec now) {
+  gpr_timespec timeout;
+  if (gpr_time_cmp(deadline, gpr_inf_future) == 0) {
+    return -1;
+  }
+  if (gpr_time_cmp(deadline, now) <= 0) {
+    return 0;
+  }
+  timeout = gpr_time_add(gpr_time_sub(deadline, now),
+                         gpr_time_from_nanos(GPR_NS_PER_MS - 1));
+  return gpr_time_to_millis(timeout);
+}
+
 void grpc_pollset_shutdown(grpc_pollset *pollset,
                            void (*shutdown_done)(void *arg),
                            void *shutdown_done_arg) {
@@ -373,13 +387,9 @@ static int unary_poll_pollset_maybe_work(grpc_pollset *pollset,
     become_empty_pollset(pollset);
     return 0;
   }
-  if (gpr_time_cmp(deadline, gpr_inf_future) == 0) {
-    timeout = -1;
-  } else {
-    timeout = gpr_time_to_millis(gpr_time_sub(deadline, now));
-    if (timeout <= 0) {
-      return 1;
-    }
+  timeout = grpc_poll_deadline_to_millis_timeout(deadline, now);
+  if (timeout == 0) {
+    return 1;
   }
   pfd[0].fd = grpc_pollset_kick_pre_poll(&pollset->kick_state);
   if (pfd[0].fd < 0) {
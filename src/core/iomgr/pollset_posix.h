@@ -100,6 +100,14 @@ void grpc_kick_drain(grpc_pollset *p);
    to be relied on. */
 grpc_pollset *grpc_backup_pollset(void);
 
+/* Converts a poll deadline into a timeout in milliseconds for poll() and
+   friends: -1 for an infinite deadline, otherwise rounded up, so that a
+   deadline (an alarm, say) less than a millisecond away waits in poll()
+   rather than returning straight away without servicing any fds. Returns 0
+   once the deadline has passed. */
+int grpc_poll_deadline_to_millis_timeout(gpr_timespec deadline,
+                                         gpr_timespec now);
+
 /* turn a pollset into a multipoller: platform specific */
 void grpc_platform_become_multipoller(grpc_pollset *pollset,
                                       struct grpc_fd **fds, size_t fd_count);
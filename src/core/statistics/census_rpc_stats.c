@@ -41,14 +41,22 @@
 #include "src/core/support/murmur_hash.h"
 #include "src/core/support/string.h"
 #include <grpc/support/alloc.h>
+#include <grpc/support/histogram.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
 
 #define NUM_INTERVALS 3
 #define MINUTE_INTERVAL 0
 #define HOUR_INTERVAL 1
 #define TOTAL_INTERVAL 2
 
+/* Layout of the rpc latency histograms: 1% buckets from 1us up to ten
+   minutes. gpr histograms cannot hold values below 1, so latencies are kept
+   in microseconds. */
+#define LATENCY_RESOLUTION 0.01
+#define LATENCY_MAX_US 600e6
+
 /* for easier typing */
 typedef census_per_method_rpc_stats per_method_stats;
 
@@ -58,8 +66,18 @@ static gpr_once g_stats_store_mu_init = GPR_ONCE_INIT;
 static gpr_mu g_mu;
 static census_ht* g_client_stats_store = NULL;
 static census_ht* g_server_stats_store = NULL;
+/* Latencies of all rpcs, recorded without taking g_mu. Like g_mu, these live
+   for the lifetime of the process. */
+static gpr_concurrent_histogram* g_client_latencies = NULL;
+static gpr_concurrent_histogram* g_server_latencies = NULL;
 
-static void init_mutex(void) { gpr_mu_init(&g_mu); }
+static void init_mutex(void) {
+  gpr_mu_init(&g_mu);
+  g_client_latencies =
+      gpr_concurrent_histogram_create(LATENCY_RESOLUTION, LATENCY_MAX_US);
+  g_server_latencies =
+      gpr_concurrent_histogram_create(LATENCY_RESOLUTION, LATENCY_MAX_US);
+}
 
 static void init_mutex_once(void) {
   gpr_once_init(&g_stats_store_mu_init, init_mutex);
@@ -137,8 +155,9 @@ void census_aggregated_rpc_stats_set_empty(census_aggregated_rpc_stats* data) {
   data->stats = NULL;
 }
 
-static void record_stats(census_ht* store, census_op_id op_id,
-                         const census_rpc_stats* stats) {
+static void record_stats(census_ht* store, gpr_concurrent_histogram* latencies,
+                         census_op_id op_id, const census_rpc_stats* stats) {
+  int recorded = 0;
   gpr_mu_lock(&g_mu);
   if (store != NULL) {
     census_trace_obj* trace = NULL;
@@ -158,21 +177,26 @@ static void record_stats(census_ht* store, census_op_id op_id,
         census_ht_insert(store, key, (void*)window_stats);
       }
       census_window_stats_add(window_stats, gpr_now(), stats);
+      recorded = 1;
     } else {
       census_internal_unlock_trace_store();
     }
   }
   gpr_mu_unlock(&g_mu);
+  if (recorded) {
+    gpr_concurrent_histogram_add(latencies,
+                                 GPR_MAX(stats->elapsed_time_ms * 1e3, 1.0));
+  }
 }
 
 void census_record_rpc_client_stats(census_op_id op_id,
                                     const census_rpc_stats* stats) {
-  record_stats(g_client_stats_store, op_id, stats);
+  record_stats(g_client_stats_store, g_client_latencies, op_id, stats);
 }
 
 void census_record_rpc_server_stats(census_op_id op_id,
                                     const census_rpc_stats* stats) {
-  record_stats(g_server_stats_store, op_id, stats);
+  record_stats(g_server_stats_store, g_server_latencies, op_id, stats);
 }
 
 /* Get stats from input stats store */
@@ -221,6 +245,25 @@ void census_get_server_stats(census_aggregated_rpc_stats* data) {
   get_stats(g_server_stats_store, data);
 }
 
+gpr_histogram* census_rpc_latency_histogram_create(void) {
+  return gpr_histogram_create(LATENCY_RESOLUTION, LATENCY_MAX_US);
+}
+
+static void get_latencies(gpr_concurrent_histogram* src, gpr_histogram* dst) {
+  GPR_ASSERT(dst != NULL);
+  if (src != NULL) {
+    GPR_ASSERT(gpr_histogram_merge_and_reset_concurrent(dst, src));
+  }
+}
+
+void census_get_client_latencies(gpr_histogram* latencies) {
+  get_latencies(g_client_latencies, latencies);
+}
+
+void census_get_server_latencies(gpr_histogram* latencies) {
+  get_latencies(g_server_latencies, latencies);
+}
+
 void census_stats_store_init(void) {
   init_mutex_once();
   gpr_mu_lock(&g_mu);
@@ -35,6 +35,7 @@
 #define GRPC_INTERNAL_CORE_STATISTICS_CENSUS_RPC_STATS_H
 
 #include "src/core/statistics/census_interface.h"
+#include <grpc/support/histogram.h>
 #include <grpc/support/port_platform.h>
 
 #ifdef __cplusplus
@@ -91,6 +92,16 @@ void census_get_server_stats(census_aggregated_rpc_stats* data_map);
    DO NOT CALL from outside of grpc code. */
 void census_get_client_stats(census_aggregated_rpc_stats* data_map);
 
+/* Creates a histogram suitable for passing to census_get_*_latencies. */
+gpr_histogram* census_rpc_latency_histogram_create(void);
+
+/* Merge the elapsed times (in us) of all server/client side rpcs recorded
+   since the previous call into *latencies. Recording is lock free, so these
+   may be polled without stalling rpcs.
+   DO NOT CALL from outside of grpc code. */
+void census_get_server_latencies(gpr_histogram* latencies);
+void census_get_client_latencies(gpr_histogram* latencies);
+
 void census_stats_store_init(void);
 void census_stats_store_shutdown(void);
 
@@ -34,13 +34,59 @@
 #include <grpc/support/alloc.h>
 
 #include <stdlib.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/port_platform.h>
+#include <grpc/support/sync.h>
+
+static gpr_atm g_counting;
+
+#ifdef GPR_ARCH_64
+static gpr_atm g_allocs;
+#else
+/* a 32 bit gpr_atm would wrap after 2^31 allocations, well within a long
+   benchmark run, so the count is kept in 64 bits under a mutex */
+static gpr_once g_allocs_once = GPR_ONCE_INIT;
+static gpr_mu g_allocs_mu;
+static gpr_int64 g_allocs;
+
+static void init_allocs_mu(void) { gpr_mu_init(&g_allocs_mu); }
+#endif
+
+static void count_alloc(void) {
+  if (!gpr_atm_acq_load(&g_counting)) {
+    return;
+  }
+#ifdef GPR_ARCH_64
+  gpr_atm_no_barrier_fetch_add(&g_allocs, 1);
+#else
+  gpr_once_init(&g_allocs_once, init_allocs_mu);
+  gpr_mu_lock(&g_allocs_mu);
+  g_allocs++;
+  gpr_mu_unlock(&g_allocs_mu);
+#endif
+}
+
+void gpr_alloc_enable_counting(int enable) {
+  gpr_atm_rel_store(&g_counting, enable != 0);
+}
+
+void gpr_alloc_get_stats(gpr_alloc_stats *stats) {
+#ifdef GPR_ARCH_64
+  stats->allocs = gpr_atm_acq_load(&g_allocs);
+#else
+  gpr_once_init(&g_allocs_once, init_allocs_mu);
+  gpr_mu_lock(&g_allocs_mu);
+  stats->allocs = g_allocs;
+  gpr_mu_unlock(&g_allocs_mu);
+#endif
+}
 
 void *gpr_malloc(size_t size) {
   void *p = malloc(size);
   if (!p) {
     abort();
   }
+  count_alloc();
   return p;
 }
 
@@ -51,6 +97,7 @@ void *gpr_realloc(void *p, size_t size) {
   if (!p) {
     abort();
   }
+  count_alloc();
   return p;
 }
 
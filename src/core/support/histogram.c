@@ -38,8 +38,11 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/port_platform.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
 #include <grpc/support/useful.h>
 
 /* Histograms are stored with exponentially increasing bucket sizes.
@@ -86,9 +89,9 @@ static double bucket_start(gpr_histogram *h, double x) {
   return pow(h->multiplier, x);
 }
 
-gpr_histogram *gpr_histogram_create(double resolution,
-                                    double max_bucket_start) {
-  gpr_histogram *h = gpr_malloc(sizeof(gpr_histogram));
+/* initialize everything but the bucket storage */
+static void init_layout(gpr_histogram *h, double resolution,
+                        double max_bucket_start) {
   GPR_ASSERT(resolution > 0.0);
   GPR_ASSERT(max_bucket_start > resolution);
   h->sum = 0.0;
@@ -102,6 +105,13 @@ gpr_histogram *gpr_histogram_create(double resolution,
   h->num_buckets = bucket_for_unchecked(h, max_bucket_start) + 1;
   GPR_ASSERT(h->num_buckets > 1);
   GPR_ASSERT(h->num_buckets < 100000000);
+  h->buckets = NULL;
+}
+
+gpr_histogram *gpr_histogram_create(double resolution,
+                                    double max_bucket_start) {
+  gpr_histogram *h = gpr_malloc(sizeof(gpr_histogram));
+  init_layout(h, resolution, max_bucket_start);
   h->buckets = gpr_malloc(sizeof(gpr_uint32) * h->num_buckets);
   memset(h->buckets, 0, sizeof(gpr_uint32) * h->num_buckets);
   return h;
@@ -237,3 +247,244 @@ const gpr_uint32 *gpr_histogram_get_contents(gpr_histogram *h, size_t *size) {
   *size = h->num_buckets;
   return h->buckets;
 }
+
+/* Concurrent histograms.
+
+   Each shard keeps its own bucket counts and running statistics, and a
+   recording thread picks the shard for the cpu it is running on, so that
+   in the common case no two threads touch the same cache lines. To that
+   end each shard and each shard's buckets start on a cache line boundary
+   and are padded to a whole number of lines. Bucket counts are plain atomic
+   counters. The double valued statistics are stored as their bit patterns
+   in gpr_atm cells and updated with compare-and-swap loops; on platforms
+   where a gpr_atm cannot hold a double they fall back to a per-shard
+   mutex. */
+
+typedef struct {
+#ifdef GPR_ARCH_64
+  gpr_atm sum;
+  gpr_atm sum_of_squares;
+  gpr_atm min_seen;
+  gpr_atm max_seen;
+#else
+  gpr_mu mu;
+  double sum;
+  double sum_of_squares;
+  double min_seen;
+  double max_seen;
+#endif
+  gpr_atm *buckets;
+} concurrent_shard;
+
+struct gpr_concurrent_histogram {
+  /* bucket layout; the statistics and buckets fields are unused */
+  gpr_histogram layout;
+  size_t num_shards;
+  concurrent_shard **shards;
+};
+
+/* the values the statistics of a shard are reset to */
+typedef struct {
+  double sum;
+  double sum_of_squares;
+  double min_seen;
+  double max_seen;
+} shard_stats;
+
+#ifdef GPR_ARCH_64
+static gpr_atm double_to_atm(double x) {
+  gpr_atm a;
+  memcpy(&a, &x, sizeof(a));
+  return a;
+}
+
+static double atm_to_double(gpr_atm a) {
+  double x;
+  memcpy(&x, &a, sizeof(x));
+  return x;
+}
+
+static void atm_double_add(gpr_atm *p, double delta) {
+  gpr_atm old;
+  do {
+    old = gpr_atm_acq_load(p);
+  } while (!gpr_atm_no_barrier_cas(p, old,
+                                   double_to_atm(atm_to_double(old) + delta)));
+}
+
+/* store x into *p if pick_less is non-zero and x is less than *p, or if
+   pick_less is zero and x is greater than *p */
+static void atm_double_extreme(gpr_atm *p, double x, int pick_less) {
+  gpr_atm old;
+  double cur;
+  do {
+    old = gpr_atm_acq_load(p);
+    cur = atm_to_double(old);
+    if (pick_less ? !(x < cur) : !(x > cur)) return;
+  } while (!gpr_atm_no_barrier_cas(p, old, double_to_atm(x)));
+}
+
+/* read *p, replacing it with reset_to if reset is non-zero */
+static double atm_double_take(gpr_atm *p, int reset, double reset_to) {
+  gpr_atm old;
+  if (!reset) return atm_to_double(gpr_atm_acq_load(p));
+  do {
+    old = gpr_atm_acq_load(p);
+  } while (!gpr_atm_no_barrier_cas(p, old, double_to_atm(reset_to)));
+  return atm_to_double(old);
+}
+#endif
+
+static void shard_reset_stats(concurrent_shard *s, const shard_stats *init) {
+#ifdef GPR_ARCH_64
+  gpr_atm_rel_store(&s->sum, double_to_atm(init->sum));
+  gpr_atm_rel_store(&s->sum_of_squares, double_to_atm(init->sum_of_squares));
+  gpr_atm_rel_store(&s->min_seen, double_to_atm(init->min_seen));
+  gpr_atm_rel_store(&s->max_seen, double_to_atm(init->max_seen));
+#else
+  s->sum = init->sum;
+  s->sum_of_squares = init->sum_of_squares;
+  s->min_seen = init->min_seen;
+  s->max_seen = init->max_seen;
+#endif
+}
+
+static void shard_add_stats(concurrent_shard *s, double x) {
+#ifdef GPR_ARCH_64
+  atm_double_add(&s->sum, x);
+  atm_double_add(&s->sum_of_squares, x * x);
+  atm_double_extreme(&s->min_seen, x, 1);
+  atm_double_extreme(&s->max_seen, x, 0);
+#else
+  gpr_mu_lock(&s->mu);
+  s->sum += x;
+  s->sum_of_squares += x * x;
+  if (x < s->min_seen) s->min_seen = x;
+  if (x > s->max_seen) s->max_seen = x;
+  gpr_mu_unlock(&s->mu);
+#endif
+}
+
+static void shard_take_stats(concurrent_shard *s, int reset,
+                             const shard_stats *init, shard_stats *out) {
+#ifdef GPR_ARCH_64
+  out->sum = atm_double_take(&s->sum, reset, init->sum);
+  out->sum_of_squares =
+      atm_double_take(&s->sum_of_squares, reset, init->sum_of_squares);
+  out->min_seen = atm_double_take(&s->min_seen, reset, init->min_seen);
+  out->max_seen = atm_double_take(&s->max_seen, reset, init->max_seen);
+#else
+  gpr_mu_lock(&s->mu);
+  out->sum = s->sum;
+  out->sum_of_squares = s->sum_of_squares;
+  out->min_seen = s->min_seen;
+  out->max_seen = s->max_seen;
+  if (reset) shard_reset_stats(s, init);
+  gpr_mu_unlock(&s->mu);
+#endif
+}
+
+static void initial_stats(gpr_concurrent_histogram *h, shard_stats *init) {
+  init->sum = 0.0;
+  init->sum_of_squares = 0.0;
+  init->min_seen = h->layout.max_possible;
+  init->max_seen = 0.0;
+}
+
+/* allocates whole cache lines, so that no other allocation, in particular
+   no other shard, shares a cache line with the returned block */
+static void *cacheline_alloc(size_t size) {
+  size_t rounded = (size + GPR_CACHELINE_SIZE - 1) &
+                   ~(size_t)(GPR_CACHELINE_SIZE - 1);
+  return gpr_malloc_aligned(rounded, GPR_CACHELINE_SIZE_LOG);
+}
+
+gpr_concurrent_histogram *gpr_concurrent_histogram_create(
+    double resolution, double max_bucket_start) {
+  gpr_concurrent_histogram *h = gpr_malloc(sizeof(gpr_concurrent_histogram));
+  shard_stats init;
+  size_t i;
+  init_layout(&h->layout, resolution, max_bucket_start);
+  initial_stats(h, &init);
+  h->num_shards = GPR_MAX(1, gpr_cpu_num_cores());
+  h->shards = gpr_malloc(sizeof(concurrent_shard *) * h->num_shards);
+  for (i = 0; i < h->num_shards; i++) {
+    concurrent_shard *s = cacheline_alloc(sizeof(concurrent_shard));
+#ifndef GPR_ARCH_64
+    gpr_mu_init(&s->mu);
+#endif
+    shard_reset_stats(s, &init);
+    s->buckets = cacheline_alloc(sizeof(gpr_atm) * h->layout.num_buckets);
+    memset(s->buckets, 0, sizeof(gpr_atm) * h->layout.num_buckets);
+    h->shards[i] = s;
+  }
+  return h;
+}
+
+void gpr_concurrent_histogram_destroy(gpr_concurrent_histogram *h) {
+  size_t i;
+  for (i = 0; i < h->num_shards; i++) {
+#ifndef GPR_ARCH_64
+    gpr_mu_destroy(&h->shards[i]->mu);
+#endif
+    gpr_free_aligned(h->shards[i]->buckets);
+    gpr_free_aligned(h->shards[i]);
+  }
+  gpr_free(h->shards);
+  gpr_free(h);
+}
+
+void gpr_concurrent_histogram_add(gpr_concurrent_histogram *h, double x) {
+  concurrent_shard *s = h->shards[gpr_cpu_current_cpu() % h->num_shards];
+  gpr_atm_no_barrier_fetch_add(&s->buckets[bucket_for(&h->layout, x)], 1);
+  shard_add_stats(s, x);
+}
+
+static int merge_concurrent(gpr_histogram *dst, gpr_concurrent_histogram *src,
+                            int reset) {
+  shard_stats init;
+  shard_stats stats;
+  size_t i, j;
+  if ((dst->num_buckets != src->layout.num_buckets) ||
+      (dst->multiplier != src->layout.multiplier)) {
+    /* Fail because these histograms don't match */
+    return 0;
+  }
+  initial_stats(src, &init);
+  for (i = 0; i < src->num_shards; i++) {
+    concurrent_shard *s = src->shards[i];
+    double count = 0.0;
+    for (j = 0; j < dst->num_buckets; j++) {
+      gpr_atm n = gpr_atm_acq_load(&s->buckets[j]);
+      if (n == 0) continue;
+      /* subtracting what was read keeps any increments that race with us */
+      if (reset) gpr_atm_no_barrier_fetch_add(&s->buckets[j], -n);
+      dst->buckets[j] += (gpr_uint32)n;
+      count += (double)n;
+    }
+    /* a shard's statistics may be updated slightly after its bucket, so
+       they are collected even when no bucket counts were seen; the reset
+       values are neutral when merged */
+    shard_take_stats(s, reset, &init, &stats);
+    dst->count += count;
+    dst->sum += stats.sum;
+    dst->sum_of_squares += stats.sum_of_squares;
+    if (stats.min_seen < dst->min_seen) {
+      dst->min_seen = stats.min_seen;
+    }
+    if (stats.max_seen > dst->max_seen) {
+      dst->max_seen = stats.max_seen;
+    }
+  }
+  return 1;
+}
+
+int gpr_histogram_merge_concurrent(gpr_histogram *dst,
+                                   gpr_concurrent_histogram *src) {
+  return merge_concurrent(dst, src, 0);
+}
+
+int gpr_histogram_merge_and_reset_concurrent(gpr_histogram *dst,
+                                             gpr_concurrent_histogram *src) {
+  return merge_concurrent(dst, src, 1);
+}
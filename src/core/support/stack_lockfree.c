@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "src/core/support/stack_lockfree.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/port_platform.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+
+/* The head of the stack is a single atomic word holding the index of the top
+   entry plus a counter that is bumped by every push and pop, so a pop that
+   read a stale head fails its compare and swap (the ABA problem) unless the
+   counter wrapped around in between. Each entry holds the index of the entry
+   below it.
+
+   Entries are allocated in blocks the first time an id in the block is
+   pushed, so a stack that only ever sees a few ids stays small however large
+   max_entries is. Blocks are never freed before the stack is, so a pop racing
+   with a push can always read the link of any id it finds at the head. */
+#ifdef GPR_ARCH_64
+typedef struct lockfree_node_contents {
+  gpr_uint32 index;
+  gpr_uint32 aba_ctr;
+} lockfree_node_contents;
+#define INVALID_ENTRY_INDEX 0xffffffffu
+#else
+typedef struct lockfree_node_contents {
+  gpr_uint16 index;
+  gpr_uint16 aba_ctr;
+} lockfree_node_contents;
+#define INVALID_ENTRY_INDEX 0xffffu
+#endif
+
+typedef union lockfree_node {
+  gpr_atm atm;
+  lockfree_node_contents contents;
+} lockfree_node;
+
+#define ENTRIES_PER_BLOCK 256
+
+struct gpr_stack_lockfree {
+  /* each holds a lockfree_node[ENTRIES_PER_BLOCK], or 0 until first used */
+  gpr_atm *blocks;
+  size_t block_count;
+  lockfree_node head;
+};
+
+gpr_stack_lockfree *gpr_stack_lockfree_create(size_t max_entries) {
+  gpr_stack_lockfree *stack;
+  size_t i;
+
+  GPR_ASSERT(sizeof(lockfree_node_contents) <= sizeof(gpr_atm));
+  GPR_ASSERT(max_entries < INVALID_ENTRY_INDEX);
+
+  stack = gpr_malloc(sizeof(*stack));
+  stack->block_count =
+      (max_entries + ENTRIES_PER_BLOCK - 1) / ENTRIES_PER_BLOCK;
+  stack->blocks = gpr_malloc(sizeof(*stack->blocks) * stack->block_count);
+  for (i = 0; i < stack->block_count; i++) {
+    stack->blocks[i] = 0;
+  }
+  memset(&stack->head, 0, sizeof(stack->head));
+  stack->head.contents.index = INVALID_ENTRY_INDEX;
+  return stack;
+}
+
+void gpr_stack_lockfree_destroy(gpr_stack_lockfree *stack) {
+  size_t i;
+  for (i = 0; i < stack->block_count; i++) {
+    gpr_free((void *)stack->blocks[i]);
+  }
+  gpr_free(stack->blocks);
+  gpr_free(stack);
+}
+
+/* returns the link for entry, allocating its block if nobody has yet */
+static gpr_atm *entry_link(gpr_stack_lockfree *stack, int entry) {
+  gpr_atm *slot = &stack->blocks[entry / ENTRIES_PER_BLOCK];
+  gpr_atm block = gpr_atm_acq_load(slot);
+  lockfree_node *fresh;
+
+  if (block == 0) {
+    fresh = gpr_malloc(sizeof(lockfree_node) * ENTRIES_PER_BLOCK);
+    if (gpr_atm_rel_cas(slot, 0, (gpr_atm)fresh)) {
+      block = (gpr_atm)fresh;
+    } else {
+      /* another push allocated it first */
+      gpr_free(fresh);
+      block = gpr_atm_acq_load(slot);
+    }
+  }
+  return &((lockfree_node *)block)[entry % ENTRIES_PER_BLOCK].atm;
+}
+
+int gpr_stack_lockfree_push(gpr_stack_lockfree *stack, int entry) {
+  lockfree_node head;
+  lockfree_node newhead;
+  lockfree_node link;
+  gpr_atm *entry_atm = entry_link(stack, entry);
+
+  memset(&link, 0, sizeof(link));
+  newhead.contents.index = entry;
+  do {
+    /* point the entry at the current head, then try to swing the head; the
+       caller owns the entry, so nobody else writes its link meanwhile */
+    head.atm = gpr_atm_acq_load(&stack->head.atm);
+    link.contents.index = head.contents.index;
+    gpr_atm_rel_store(entry_atm, link.atm);
+    newhead.contents.aba_ctr = head.contents.aba_ctr + 1;
+  } while (!gpr_atm_rel_cas(&stack->head.atm, head.atm, newhead.atm));
+  return head.contents.index == INVALID_ENTRY_INDEX;
+}
+
+int gpr_stack_lockfree_pop(gpr_stack_lockfree *stack) {
+  lockfree_node head;
+  lockfree_node link;
+  lockfree_node newhead;
+
+  do {
+    head.atm = gpr_atm_acq_load(&stack->head.atm);
+    if (head.contents.index == INVALID_ENTRY_INDEX) {
+      return -1;
+    }
+    /* may be stale if the entry was popped and pushed again meanwhile, in
+       which case the head's counter has moved on and the cas fails */
+    link.atm = gpr_atm_acq_load(entry_link(stack, head.contents.index));
+    newhead.contents.index = link.contents.index;
+    newhead.contents.aba_ctr = head.contents.aba_ctr + 1;
+  } while (!gpr_atm_acq_cas(&stack->head.atm, head.atm, newhead.atm));
+  return head.contents.index;
+}
@@ -278,34 +278,59 @@ static event *create_shutdown_event(void) {
   return ev;
 }
 
+/* Remove and return the oldest queued event, or NULL if there are none.
+   Requires GRPC_POLLSET_MU(&cc->pollset) locked. */
+static event *pop_locked(grpc_completion_queue *cc) {
+  gpr_uintptr bucket;
+  event *ev = cc->queue;
+  if (ev == NULL) return NULL;
+  bucket = ((gpr_uintptr)ev->base.tag) % NUM_TAG_BUCKETS;
+  cc->queue = ev->queue_next;
+  ev->queue_next->queue_prev = ev->queue_prev;
+  ev->queue_prev->queue_next = ev->queue_next;
+  ev->bucket_next->bucket_prev = ev->bucket_prev;
+  ev->bucket_prev->bucket_next = ev->bucket_next;
+  if (ev == cc->buckets[bucket]) {
+    cc->buckets[bucket] = ev->bucket_next;
+    if (ev == cc->buckets[bucket]) {
+      cc->buckets[bucket] = NULL;
+    }
+  }
+  if (cc->queue == ev) {
+    cc->queue = NULL;
+  }
+  return ev;
+}
+
 grpc_event *grpc_completion_queue_next(grpc_completion_queue *cc,
                                        gpr_timespec deadline) {
+  grpc_event *ev = NULL;
+  if (grpc_completion_queue_next_batch(cc, &ev, 1, deadline) == 0) {
+    return NULL;
+  }
+  return ev;
+}
+
+size_t grpc_completion_queue_next_batch(grpc_completion_queue *cc,
+                                        grpc_event **events, size_t max_events,
+                                        gpr_timespec deadline) {
   event *ev = NULL;
+  size_t count = 0;
+  size_t i;
 
+  GPR_ASSERT(max_events > 0);
   gpr_mu_lock(GRPC_POLLSET_MU(&cc->pollset));
   for (;;) {
-    if (cc->queue != NULL) {
-      gpr_uintptr bucket;
-      ev = cc->queue;
-      bucket = ((gpr_uintptr)ev->base.tag) % NUM_TAG_BUCKETS;
-      cc->queue = ev->queue_next;
-      ev->queue_next->queue_prev = ev->queue_prev;
-      ev->queue_prev->queue_next = ev->queue_next;
-      ev->bucket_next->bucket_prev = ev->bucket_prev;
-      ev->bucket_prev->bucket_next = ev->bucket_next;
-      if (ev == cc->buckets[bucket]) {
-        cc->buckets[bucket] = ev->bucket_next;
-        if (ev == cc->buckets[bucket]) {
-          cc->buckets[bucket] = NULL;
-        }
-      }
-      if (cc->queue == ev) {
-        cc->queue = NULL;
+    if ((ev = pop_locked(cc)) != NULL) {
+      events[count++] = &ev->base;
+      while (count < max_events && (ev = pop_locked(cc)) != NULL) {
+        events[count++] = &ev->base;
       }
       break;
     }
     if (cc->shutdown) {
       ev = create_shutdown_event();
+      events[count++] = &ev->base;
       break;
     }
     if (cc->allow_polling && grpc_pollset_work(&cc->pollset, deadline)) {
@@ -314,12 +339,14 @@ grpc_event *grpc_completion_queue_next(grpc_completion_queue *cc,
     if (gpr_cv_wait(GRPC_POLLSET_CV(&cc->pollset),
                     GRPC_POLLSET_MU(&cc->pollset), deadline)) {
       gpr_mu_unlock(GRPC_POLLSET_MU(&cc->pollset));
-      return NULL;
+      return 0;
     }
   }
   gpr_mu_unlock(GRPC_POLLSET_MU(&cc->pollset));
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cc, &ev->base);
-  return &ev->base;
+  for (i = 0; i < count; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cc, events[i]);
+  }
+  return count;
 }
 
 static event *pluck_event(grpc_completion_queue *cc, void *tag) {
@@ -40,6 +40,7 @@
 #include "src/core/channel/channel_args.h"
 #include "src/core/channel/connected_channel.h"
 #include "src/core/iomgr/iomgr.h"
+#include "src/core/support/stack_lockfree.h"
 #include "src/core/support/string.h"
 #include "src/core/surface/call.h"
 #include "src/core/surface/channel.h"
@@ -47,10 +48,17 @@
 #include "src/core/surface/init.h"
 #include "src/core/transport/metadata.h"
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include <grpc/support/useful.h>
 
-typedef enum { PENDING_START, ALL_CALLS, CALL_LIST_COUNT } call_list;
+typedef enum { PENDING_START, CALL_LIST_COUNT } call_list;
+
+/* the most calls that may be requested (and not yet matched) at once; ids
+   must fit the 16 bit indices of gpr_stack_lockfree */
+#define MAX_REQUESTED_CALLS GRPC_MAX_REQUESTED_CALLS
+/* requested call storage grows in blocks of this many calls */
+#define REQUESTED_CALLS_PER_BLOCK 256
 
 typedef struct listener {
   void *arg;
@@ -83,6 +91,7 @@ typedef struct {
     } batch;
     struct {
       grpc_completion_queue *cq_bind;
+      grpc_completion_queue *cq_new;
       grpc_call **call;
       registered_method *registered_method;
       gpr_timespec *deadline;
@@ -92,18 +101,21 @@ typedef struct {
   } data;
 } requested_call;
 
+/* Matches incoming calls for one registered method (or for all unregistered
+   methods) against calls requested by the application. Requests are ids into
+   the server's requested call storage kept on a lock-free stack, so queueing a
+   request or starting a call that finds one waiting takes no locks; calls
+   that arrive before any request wait on the pending list (under
+   grpc_server.mu_call). */
 typedef struct {
-  requested_call *calls;
-  size_t count;
-  size_t capacity;
-} requested_call_array;
+  call_data *pending;
+  gpr_stack_lockfree *requests;
+} request_matcher;
 
 struct registered_method {
   char *method;
   char *host;
-  call_data *pending;
-  requested_call_array requested;
-  grpc_completion_queue *cq;
+  request_matcher request_matcher;
   registered_method *next;
 };
 
@@ -136,16 +148,28 @@ struct grpc_server {
   grpc_pollset **pollsets;
   size_t cq_count;
 
-  gpr_mu mu;
+  /* protects the channel list and shutdown tags */
+  gpr_mu mu_global;
+  /* protects the pending lists of the request matchers */
+  gpr_mu mu_call;
 
   registered_method *registered_methods;
-  requested_call_array requested_calls;
-
-  gpr_uint8 shutdown;
+  request_matcher unregistered_request_matcher;
+  /* storage for requested calls, indexed by the ids that move between
+     request_freelist and the request matchers; blocks are added under
+     mu_call as more calls are requested at once than ever before */
+  requested_call *requested_call_blocks[MAX_REQUESTED_CALLS /
+                                        REQUESTED_CALLS_PER_BLOCK];
+  int requested_call_count;
+  gpr_stack_lockfree *request_freelist;
+
+  gpr_atm shutdown;
   size_t num_shutdown_tags;
+  size_t num_shutdown_tags_published;
   void **shutdown_tags;
 
-  call_data *lists[CALL_LIST_COUNT];
+  /* number of calls alive on this server */
+  gpr_atm num_calls;
   channel_data root_channel_data;
 
   listener *listeners;
@@ -170,6 +194,8 @@ typedef struct legacy_data {
 struct call_data {
   grpc_call *call;
 
+  /* protects state */
+  gpr_mu mu_state;
   call_state state;
   gpr_timespec deadline;
   grpc_mdstr *path;
@@ -238,20 +264,63 @@ static int call_list_remove(call_data *call, call_list list) {
   return 1;
 }
 
-static void requested_call_array_destroy(requested_call_array *array) {
-  gpr_free(array->calls);
+static requested_call *requested_call_at(grpc_server *server, int id) {
+  return &server->requested_call_blocks[id / REQUESTED_CALLS_PER_BLOCK]
+                                       [id % REQUESTED_CALLS_PER_BLOCK];
 }
 
-static requested_call *requested_call_array_add(requested_call_array *array) {
-  requested_call *rc;
-  if (array->count == array->capacity) {
-    array->capacity = GPR_MAX(array->capacity + 8, array->capacity * 2);
-    array->calls =
-        gpr_realloc(array->calls, sizeof(requested_call) * array->capacity);
+/* returns an unused requested call id, or -1 if MAX_REQUESTED_CALLS are
+   already outstanding */
+static int alloc_request_id(grpc_server *server) {
+  int id = gpr_stack_lockfree_pop(server->request_freelist);
+  if (id != -1) return id;
+  gpr_mu_lock(&server->mu_call);
+  if (server->requested_call_count < MAX_REQUESTED_CALLS) {
+    id = server->requested_call_count++;
+    if (id % REQUESTED_CALLS_PER_BLOCK == 0) {
+      server->requested_call_blocks[id / REQUESTED_CALLS_PER_BLOCK] =
+          gpr_malloc(sizeof(requested_call) * REQUESTED_CALLS_PER_BLOCK);
+    }
+  }
+  gpr_mu_unlock(&server->mu_call);
+  return id;
+}
+
+static void request_matcher_init(request_matcher *rm) {
+  rm->pending = NULL;
+  rm->requests = gpr_stack_lockfree_create(MAX_REQUESTED_CALLS);
+}
+
+static void request_matcher_destroy(request_matcher *rm) {
+  GPR_ASSERT(gpr_stack_lockfree_pop(rm->requests) == -1);
+  gpr_stack_lockfree_destroy(rm->requests);
+}
+
+/* fail every request queued on rm */
+static void fail_requests(grpc_server *server, request_matcher *rm) {
+  int request_id;
+  while ((request_id = gpr_stack_lockfree_pop(rm->requests)) != -1) {
+    fail_call(server, requested_call_at(server, request_id));
+    gpr_stack_lockfree_push(server->request_freelist, request_id);
+  }
+}
+
+/* publish any shutdown tags not yet published, once the server is shut down
+   and all its calls are gone; call with mu_global held */
+static void maybe_finish_shutdown(grpc_server *server) {
+  size_t i;
+  if (!gpr_atm_acq_load(&server->shutdown) ||
+      gpr_atm_acq_load(&server->num_calls) != 0) {
+    return;
+  }
+  for (; server->num_shutdown_tags_published < server->num_shutdown_tags;
+       server->num_shutdown_tags_published++) {
+    for (i = 0; i < server->cq_count; i++) {
+      grpc_cq_end_server_shutdown(
+          server->cqs[i],
+          server->shutdown_tags[server->num_shutdown_tags_published]);
+    }
   }
-  rc = &array->calls[array->count++];
-  memset(rc, 0, sizeof(*rc));
-  return rc;
 }
 
 static void server_ref(grpc_server *server) {
@@ -260,18 +329,24 @@ static void server_ref(grpc_server *server) {
 
 static void server_unref(grpc_server *server) {
   registered_method *rm;
+  size_t i;
   if (gpr_unref(&server->internal_refcount)) {
     grpc_channel_args_destroy(server->channel_args);
-    gpr_mu_destroy(&server->mu);
+    gpr_mu_destroy(&server->mu_global);
+    gpr_mu_destroy(&server->mu_call);
     gpr_free(server->channel_filters);
-    requested_call_array_destroy(&server->requested_calls);
+    request_matcher_destroy(&server->unregistered_request_matcher);
     while ((rm = server->registered_methods) != NULL) {
       server->registered_methods = rm->next;
       gpr_free(rm->method);
       gpr_free(rm->host);
-      requested_call_array_destroy(&rm->requested);
+      request_matcher_destroy(&rm->request_matcher);
       gpr_free(rm);
     }
+    gpr_stack_lockfree_destroy(server->request_freelist);
+    for (i = 0; i < GPR_ARRAY_SIZE(server->requested_call_blocks); i++) {
+      gpr_free(server->requested_call_blocks[i]);
+    }
     gpr_free(server->cqs);
     gpr_free(server->pollsets);
     gpr_free(server->shutdown_tags);
@@ -304,22 +379,32 @@ static void destroy_channel(channel_data *chand) {
   grpc_iomgr_add_callback(finish_destroy_channel, chand);
 }
 
-static void finish_start_new_rpc_and_unlock(grpc_server *server,
-                                            grpc_call_element *elem,
-                                            call_data **pending_root,
-                                            requested_call_array *array) {
-  requested_call rc;
+static void finish_start_new_rpc(grpc_server *server, grpc_call_element *elem,
+                                 request_matcher *rm) {
   call_data *calld = elem->call_data;
-  if (array->count == 0) {
-    calld->state = PENDING;
-    call_list_join(pending_root, calld, PENDING_START);
-    gpr_mu_unlock(&server->mu);
-  } else {
-    rc = array->calls[--array->count];
-    calld->state = ACTIVATED;
-    gpr_mu_unlock(&server->mu);
-    begin_call(server, calld, &rc);
+  int request_id;
+
+  request_id = gpr_stack_lockfree_pop(rm->requests);
+  gpr_mu_lock(&calld->mu_state);
+  if (request_id == -1) {
+    /* look again under mu_call: a request queued meanwhile either shows up
+       here, or its queue_call_request will find this call pending */
+    gpr_mu_lock(&server->mu_call);
+    request_id = gpr_stack_lockfree_pop(rm->requests);
+    if (request_id == -1) {
+      calld->state = PENDING;
+      call_list_join(&rm->pending, calld, PENDING_START);
+    }
+    gpr_mu_unlock(&server->mu_call);
   }
+  if (request_id == -1) {
+    gpr_mu_unlock(&calld->mu_state);
+    return;
+  }
+  calld->state = ACTIVATED;
+  gpr_mu_unlock(&calld->mu_state);
+  begin_call(server, calld, requested_call_at(server, request_id));
+  gpr_stack_lockfree_push(server->request_freelist, request_id);
 }
 
 static void start_new_rpc(grpc_call_element *elem) {
@@ -330,7 +415,6 @@ static void start_new_rpc(grpc_call_element *elem) {
   gpr_uint32 hash;
   channel_registered_method *rm;
 
-  gpr_mu_lock(&server->mu);
   if (chand->registered_methods && calld->path && calld->host) {
     /* TODO(ctiller): unify these two searches */
     /* check for an exact match with host */
@@ -341,9 +425,8 @@ static void start_new_rpc(grpc_call_element *elem) {
       if (!rm) break;
       if (rm->host != calld->host) continue;
       if (rm->method != calld->path) continue;
-      finish_start_new_rpc_and_unlock(server, elem,
-                                      &rm->server_registered_method->pending,
-                                      &rm->server_registered_method->requested);
+      finish_start_new_rpc(server, elem,
+                           &rm->server_registered_method->request_matcher);
       return;
     }
     /* check for a wildcard method definition (no host set) */
@@ -354,14 +437,12 @@ static void start_new_rpc(grpc_call_element *elem) {
       if (!rm) break;
       if (rm->host != NULL) continue;
       if (rm->method != calld->path) continue;
-      finish_start_new_rpc_and_unlock(server, elem,
-                                      &rm->server_registered_method->pending,
-                                      &rm->server_registered_method->requested);
+      finish_start_new_rpc(server, elem,
+                           &rm->server_registered_method->request_matcher);
       return;
     }
   }
-  finish_start_new_rpc_and_unlock(server, elem, &server->lists[PENDING_START],
-                                  &server->requested_calls);
+  finish_start_new_rpc(server, elem, &server->unregistered_request_matcher);
 }
 
 static void kill_zombie(void *elem, int success) {
@@ -371,12 +452,18 @@ static void kill_zombie(void *elem, int success) {
 static void stream_closed(grpc_call_element *elem) {
   call_data *calld = elem->call_data;
   channel_data *chand = elem->channel_data;
-  gpr_mu_lock(&chand->server->mu);
+  int removed;
+  gpr_mu_lock(&calld->mu_state);
   switch (calld->state) {
     case ACTIVATED:
       break;
     case PENDING:
-      call_list_remove(calld, PENDING_START);
+      gpr_mu_lock(&chand->server->mu_call);
+      removed = call_list_remove(calld, PENDING_START);
+      gpr_mu_unlock(&chand->server->mu_call);
+      /* if it was already taken off the pending list, it is about to be
+         activated */
+      if (!removed) break;
     /* fallthrough intended */
     case NOT_STARTED:
       calld->state = ZOMBIED;
@@ -385,14 +472,13 @@ static void stream_closed(grpc_call_element *elem) {
     case ZOMBIED:
       break;
   }
-  gpr_mu_unlock(&chand->server->mu);
+  gpr_mu_unlock(&calld->mu_state);
   grpc_call_stream_closed(elem);
 }
 
 static void read_closed(grpc_call_element *elem) {
   call_data *calld = elem->call_data;
-  channel_data *chand = elem->channel_data;
-  gpr_mu_lock(&chand->server->mu);
+  gpr_mu_lock(&calld->mu_state);
   switch (calld->state) {
     case ACTIVATED:
     case PENDING:
@@ -405,7 +491,7 @@ static void read_closed(grpc_call_element *elem) {
     case ZOMBIED:
       break;
   }
-  gpr_mu_unlock(&chand->server->mu);
+  gpr_mu_unlock(&calld->mu_state);
 }
 
 static void call_op(grpc_call_element *elem, grpc_call_element *from_elemn,
@@ -466,10 +552,10 @@ static void channel_op(grpc_channel_element *elem,
     case GRPC_TRANSPORT_CLOSED:
       /* if the transport is closed for a server channel, we destroy the
          channel */
-      gpr_mu_lock(&server->mu);
+      gpr_mu_lock(&server->mu_global);
       server_ref(server);
       destroy_channel(chand);
-      gpr_mu_unlock(&server->mu);
+      gpr_mu_unlock(&server->mu_global);
       server_unref(server);
       break;
     case GRPC_TRANSPORT_GOAWAY:
@@ -505,10 +591,9 @@ static void init_call_elem(grpc_call_element *elem,
   memset(calld, 0, sizeof(call_data));
   calld->deadline = gpr_inf_future;
   calld->call = grpc_call_from_top_element(elem);
+  gpr_mu_init(&calld->mu_state);
 
-  gpr_mu_lock(&chand->server->mu);
-  call_list_join(&chand->server->lists[ALL_CALLS], calld, ALL_CALLS);
-  gpr_mu_unlock(&chand->server->mu);
+  gpr_atm_no_barrier_fetch_add(&chand->server->num_calls, 1);
 
   server_ref(chand->server);
 }
@@ -516,21 +601,20 @@ static void init_call_elem(grpc_call_element *elem,
 static void destroy_call_elem(grpc_call_element *elem) {
   channel_data *chand = elem->channel_data;
   call_data *calld = elem->call_data;
-  size_t i, j;
 
-  gpr_mu_lock(&chand->server->mu);
-  for (i = 0; i < CALL_LIST_COUNT; i++) {
-    call_list_remove(elem->call_data, i);
+  gpr_mu_lock(&calld->mu_state);
+  if (calld->state == PENDING) {
+    gpr_mu_lock(&chand->server->mu_call);
+    call_list_remove(calld, PENDING_START);
+    gpr_mu_unlock(&chand->server->mu_call);
   }
-  if (chand->server->shutdown && chand->server->lists[ALL_CALLS] == NULL) {
-    for (i = 0; i < chand->server->num_shutdown_tags; i++) {
-      for (j = 0; j < chand->server->cq_count; j++) {
-        grpc_cq_end_server_shutdown(chand->server->cqs[j],
-                                    chand->server->shutdown_tags[i]);
-      }
-    }
+  gpr_mu_unlock(&calld->mu_state);
+
+  if (gpr_atm_full_fetch_add(&chand->server->num_calls, -1) == 1) {
+    gpr_mu_lock(&chand->server->mu_global);
+    maybe_finish_shutdown(chand->server);
+    gpr_mu_unlock(&chand->server->mu_global);
   }
-  gpr_mu_unlock(&chand->server->mu);
 
   if (calld->host) {
     grpc_mdstr_unref(calld->host);
@@ -544,6 +628,8 @@ static void destroy_call_elem(grpc_call_element *elem) {
     gpr_free(calld->legacy);
   }
 
+  gpr_mu_destroy(&calld->mu_state);
+
   server_unref(chand->server);
 }
 
@@ -577,11 +663,11 @@ static void destroy_channel_elem(grpc_channel_element *elem) {
     gpr_free(chand->registered_methods);
   }
   if (chand->server) {
-    gpr_mu_lock(&chand->server->mu);
+    gpr_mu_lock(&chand->server->mu_global);
     chand->next->prev = chand->prev;
     chand->prev->next = chand->next;
     chand->next = chand->prev = chand;
-    gpr_mu_unlock(&chand->server->mu);
+    gpr_mu_unlock(&chand->server->mu_global);
     grpc_mdstr_unref(chand->path_key);
     grpc_mdstr_unref(chand->authority_key);
     server_unref(chand->server);
@@ -619,7 +705,11 @@ grpc_server *grpc_server_create_from_filters(grpc_completion_queue *cq,
   memset(server, 0, sizeof(grpc_server));
   if (cq) addcq(server, cq);
 
-  gpr_mu_init(&server->mu);
+  gpr_mu_init(&server->mu_global);
+  gpr_mu_init(&server->mu_call);
+
+  request_matcher_init(&server->unregistered_request_matcher);
+  server->request_freelist = gpr_stack_lockfree_create(MAX_REQUESTED_CALLS);
 
   server->unregistered_cq = cq;
   /* decremented by grpc_server_destroy */
@@ -676,12 +766,18 @@ void *grpc_server_register_method(grpc_server *server, const char *method,
   memset(m, 0, sizeof(*m));
   m->method = gpr_strdup(method);
   m->host = gpr_strdup(host);
+  request_matcher_init(&m->request_matcher);
   m->next = server->registered_methods;
-  m->cq = cq_new_rpc;
   server->registered_methods = m;
   return m;
 }
 
+void grpc_server_register_completion_queue(grpc_server *server,
+                                           grpc_completion_queue *cq) {
+  GPR_ASSERT(server->pollsets == NULL);
+  addcq(server, cq);
+}
+
 void grpc_server_start(grpc_server *server) {
   listener *l;
   size_t i;
@@ -770,11 +866,11 @@ grpc_transport_setup_result grpc_server_setup_transport(
   result = grpc_connected_channel_bind_transport(
       grpc_channel_get_channel_stack(channel), transport);
 
-  gpr_mu_lock(&s->mu);
+  gpr_mu_lock(&s->mu_global);
   chand->next = &s->root_channel_data;
   chand->prev = chand->next->prev;
   chand->next->prev = chand->prev->next = chand;
-  gpr_mu_unlock(&s->mu);
+  gpr_mu_unlock(&s->mu_global);
 
   gpr_free(filters);
 
@@ -784,17 +880,16 @@ grpc_transport_setup_result grpc_server_setup_transport(
 static void shutdown_internal(grpc_server *server, gpr_uint8 have_shutdown_tag,
                               void *shutdown_tag) {
   listener *l;
-  requested_call_array requested_calls;
   channel_data **channels;
   channel_data *c;
   size_t nchannels;
-  size_t i, j;
+  size_t i;
   grpc_channel_op op;
   grpc_channel_element *elem;
   registered_method *rm;
 
   /* lock, and gather up some stuff to do */
-  gpr_mu_lock(&server->mu);
+  gpr_mu_lock(&server->mu_global);
   if (have_shutdown_tag) {
     for (i = 0; i < server->cq_count; i++) {
       grpc_cq_begin_op(server->cqs[i], NULL, GRPC_SERVER_SHUTDOWN);
@@ -804,8 +899,9 @@ static void shutdown_internal(grpc_server *server, gpr_uint8 have_shutdown_tag,
                     sizeof(void *) * (server->num_shutdown_tags + 1));
     server->shutdown_tags[server->num_shutdown_tags++] = shutdown_tag;
   }
-  if (server->shutdown) {
-    gpr_mu_unlock(&server->mu);
+  if (gpr_atm_acq_load(&server->shutdown)) {
+    maybe_finish_shutdown(server);
+    gpr_mu_unlock(&server->mu_global);
     return;
   }
 
@@ -823,35 +919,9 @@ static void shutdown_internal(grpc_server *server, gpr_uint8 have_shutdown_tag,
     i++;
   }
 
-  /* collect all unregistered then registered calls */
-  requested_calls = server->requested_calls;
-  memset(&server->requested_calls, 0, sizeof(server->requested_calls));
-  for (rm = server->registered_methods; rm; rm = rm->next) {
-    if (requested_calls.count + rm->requested.count >
-        requested_calls.capacity) {
-      requested_calls.capacity =
-          GPR_MAX(requested_calls.count + rm->requested.count,
-                  2 * requested_calls.capacity);
-      requested_calls.calls =
-          gpr_realloc(requested_calls.calls, sizeof(*requested_calls.calls) *
-                                                 requested_calls.capacity);
-    }
-    memcpy(requested_calls.calls + requested_calls.count, rm->requested.calls,
-           sizeof(*requested_calls.calls) * rm->requested.count);
-    requested_calls.count += rm->requested.count;
-    gpr_free(rm->requested.calls);
-    memset(&rm->requested, 0, sizeof(rm->requested));
-  }
-
-  server->shutdown = 1;
-  if (server->lists[ALL_CALLS] == NULL) {
-    for (i = 0; i < server->num_shutdown_tags; i++) {
-      for (j = 0; j < server->cq_count; j++) {
-        grpc_cq_end_server_shutdown(server->cqs[j], server->shutdown_tags[i]);
-      }
-    }
-  }
-  gpr_mu_unlock(&server->mu);
+  gpr_atm_rel_store(&server->shutdown, 1);
+  maybe_finish_shutdown(server);
+  gpr_mu_unlock(&server->mu_global);
 
   for (i = 0; i < nchannels; i++) {
     c = channels[i];
@@ -868,11 +938,13 @@ static void shutdown_internal(grpc_server *server, gpr_uint8 have_shutdown_tag,
   }
   gpr_free(channels);
 
-  /* terminate all the requested calls */
-  for (i = 0; i < requested_calls.count; i++) {
-    fail_call(server, &requested_calls.calls[i]);
+  /* terminate all the requested calls; requests queued from now on fail in
+     queue_call_request */
+  gpr_atm_full_barrier();
+  fail_requests(server, &server->unregistered_request_matcher);
+  for (rm = server->registered_methods; rm; rm = rm->next) {
+    fail_requests(server, &rm->request_matcher);
   }
-  gpr_free(requested_calls.calls);
 
   /* Shutdown listeners */
   for (l = server->listeners; l; l = l->next) {
@@ -895,18 +967,18 @@ void grpc_server_shutdown_and_notify(grpc_server *server, void *tag) {
 
 void grpc_server_destroy(grpc_server *server) {
   channel_data *c;
-  gpr_mu_lock(&server->mu);
-  if (!server->shutdown) {
-    gpr_mu_unlock(&server->mu);
+  gpr_mu_lock(&server->mu_global);
+  if (!gpr_atm_acq_load(&server->shutdown)) {
+    gpr_mu_unlock(&server->mu_global);
     grpc_server_shutdown(server);
-    gpr_mu_lock(&server->mu);
+    gpr_mu_lock(&server->mu_global);
   }
 
   for (c = server->root_channel_data.next; c != &server->root_channel_data;
        c = c->next) {
     shutdown_channel(c);
   }
-  gpr_mu_unlock(&server->mu);
+  gpr_mu_unlock(&server->mu_global);
 
   server_unref(server);
 }
@@ -924,40 +996,66 @@ void grpc_server_add_listener(grpc_server *server, void *arg,
   server->listeners = l;
 }
 
+/* activate pending calls on rm for as long as there are requests for them */
+static void match_pending_calls(grpc_server *server, request_matcher *rm) {
+  call_data *calld;
+  int request_id;
+  gpr_mu_lock(&server->mu_call);
+  while (rm->pending != NULL) {
+    request_id = gpr_stack_lockfree_pop(rm->requests);
+    if (request_id == -1) break;
+    calld = call_list_remove_head(&rm->pending, PENDING_START);
+    gpr_mu_unlock(&server->mu_call);
+    gpr_mu_lock(&calld->mu_state);
+    GPR_ASSERT(calld->state == PENDING);
+    calld->state = ACTIVATED;
+    gpr_mu_unlock(&calld->mu_state);
+    begin_call(server, calld, requested_call_at(server, request_id));
+    gpr_stack_lockfree_push(server->request_freelist, request_id);
+    gpr_mu_lock(&server->mu_call);
+  }
+  gpr_mu_unlock(&server->mu_call);
+}
+
+/* begins an op of the given type on cq for rc, and queues rc */
 static grpc_call_error queue_call_request(grpc_server *server,
+                                          grpc_completion_queue *cq,
+                                          grpc_completion_type type,
                                           requested_call *rc) {
-  call_data *calld = NULL;
-  requested_call_array *requested_calls = NULL;
-  gpr_mu_lock(&server->mu);
-  if (server->shutdown) {
-    gpr_mu_unlock(&server->mu);
+  request_matcher *rm = NULL;
+  int request_id;
+  request_id = alloc_request_id(server);
+  if (request_id == -1) {
+    gpr_log(GPR_ERROR, "too many outstanding requested calls (max %d)",
+            MAX_REQUESTED_CALLS);
+    return GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
+  }
+  grpc_cq_begin_op(cq, NULL, type);
+  if (gpr_atm_acq_load(&server->shutdown)) {
+    gpr_stack_lockfree_push(server->request_freelist, request_id);
     fail_call(server, rc);
     return GRPC_CALL_OK;
   }
   switch (rc->type) {
     case LEGACY_CALL:
     case BATCH_CALL:
-      calld =
-          call_list_remove_head(&server->lists[PENDING_START], PENDING_START);
-      requested_calls = &server->requested_calls;
+      rm = &server->unregistered_request_matcher;
       break;
     case REGISTERED_CALL:
-      calld = call_list_remove_head(
-          &rc->data.registered.registered_method->pending, PENDING_START);
-      requested_calls = &rc->data.registered.registered_method->requested;
+      rm = &rc->data.registered.registered_method->request_matcher;
       break;
   }
-  if (calld) {
-    GPR_ASSERT(calld->state == PENDING);
-    calld->state = ACTIVATED;
-    gpr_mu_unlock(&server->mu);
-    begin_call(server, calld, rc);
-    return GRPC_CALL_OK;
-  } else {
-    *requested_call_array_add(requested_calls) = *rc;
-    gpr_mu_unlock(&server->mu);
-    return GRPC_CALL_OK;
+  *requested_call_at(server, request_id) = *rc;
+  if (gpr_stack_lockfree_push(rm->requests, request_id)) {
+    /* the stack was empty, so calls may be waiting for a request */
+    match_pending_calls(server, rm);
+  }
+  /* if shutdown began meanwhile, it may have missed this request */
+  gpr_atm_full_barrier();
+  if (gpr_atm_acq_load(&server->shutdown)) {
+    fail_requests(server, rm);
   }
+  return GRPC_CALL_OK;
 }
 
 grpc_call_error grpc_server_request_call(grpc_server *server, grpc_call **call,
@@ -966,41 +1064,41 @@ grpc_call_error grpc_server_request_call(grpc_server *server, grpc_call **call,
                                          grpc_completion_queue *cq_bind,
                                          void *tag) {
   requested_call rc;
-  grpc_cq_begin_op(server->unregistered_cq, NULL, GRPC_OP_COMPLETE);
   rc.type = BATCH_CALL;
   rc.tag = tag;
   rc.data.batch.cq_bind = cq_bind;
   rc.data.batch.call = call;
   rc.data.batch.details = details;
   rc.data.batch.initial_metadata = initial_metadata;
-  return queue_call_request(server, &rc);
+  return queue_call_request(server, server->unregistered_cq, GRPC_OP_COMPLETE,
+                            &rc);
 }
 
 grpc_call_error grpc_server_request_registered_call(
     grpc_server *server, void *rm, grpc_call **call, gpr_timespec *deadline,
     grpc_metadata_array *initial_metadata, grpc_byte_buffer **optional_payload,
-    grpc_completion_queue *cq_bind, void *tag) {
+    grpc_completion_queue *cq_bind, grpc_completion_queue *cq_new, void *tag) {
   requested_call rc;
   registered_method *registered_method = rm;
-  grpc_cq_begin_op(registered_method->cq, NULL, GRPC_OP_COMPLETE);
   rc.type = REGISTERED_CALL;
   rc.tag = tag;
   rc.data.registered.cq_bind = cq_bind;
+  rc.data.registered.cq_new = cq_new;
   rc.data.registered.call = call;
   rc.data.registered.registered_method = registered_method;
   rc.data.registered.deadline = deadline;
   rc.data.registered.initial_metadata = initial_metadata;
   rc.data.registered.optional_payload = optional_payload;
-  return queue_call_request(server, &rc);
+  return queue_call_request(server, cq_new, GRPC_OP_COMPLETE, &rc);
 }
 
 grpc_call_error grpc_server_request_call_old(grpc_server *server,
                                              void *tag_new) {
   requested_call rc;
-  grpc_cq_begin_op(server->unregistered_cq, NULL, GRPC_SERVER_RPC_NEW);
   rc.type = LEGACY_CALL;
   rc.tag = tag_new;
-  return queue_call_request(server, &rc);
+  return queue_call_request(server, server->unregistered_cq,
+                            GRPC_SERVER_RPC_NEW, &rc);
 }
 
 static void publish_legacy(grpc_call *call, grpc_op_error status, void *tag);
@@ -1068,7 +1166,7 @@ static void begin_call(grpc_server *server, call_data *calld,
         r->data.recv_message = rc->data.registered.optional_payload;
         r++;
       }
-      calld->cq_new = rc->data.registered.registered_method->cq;
+      calld->cq_new = rc->data.registered.cq_new;
       publish = publish_registered_or_batch;
       break;
   }
@@ -1093,8 +1191,8 @@ static void fail_call(grpc_server *server, requested_call *rc) {
     case REGISTERED_CALL:
       *rc->data.registered.call = NULL;
       rc->data.registered.initial_metadata->count = 0;
-      grpc_cq_end_op_complete(rc->data.registered.registered_method->cq,
-                              rc->tag, NULL, do_nothing, NULL, GRPC_OP_ERROR);
+      grpc_cq_end_op_complete(rc->data.registered.cq_new, rc->tag, NULL,
+                              do_nothing, NULL, GRPC_OP_ERROR);
       break;
   }
 }
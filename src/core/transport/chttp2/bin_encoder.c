@@ -37,10 +37,172 @@
 
 #include "src/core/transport/chttp2/huffsyms.h"
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/useful.h>
+
+/* The vectorized base64 paths need SSSE3 (for pshufb), which not every x86
+   cpu has: where the compiler can build single functions for it we do so,
+   and check the cpu at runtime. Elsewhere only the scalar paths exist. */
+#if (defined(__x86_64__) || defined(__i386__)) &&                    \
+    ((defined(__clang__) &&                                          \
+      (__clang_major__ > 3 ||                                        \
+       (__clang_major__ == 3 && __clang_minor__ >= 8))) ||           \
+     (!defined(__clang__) && defined(__GNUC__) &&                    \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define BASE64_SSSE3
+#include <tmmintrin.h>
+#define SSSE3_FN __attribute__((target("ssse3")))
+#endif
 
 static const char alphabet[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+/* base64 character to value, or 255 for characters outside the alphabet */
+static const gpr_uint8 inverse_alphabet[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62,  255,
+    255, 255, 63,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  255, 255,
+    255, 255, 255, 255, 255, 0,   1,   2,   3,   4,   5,   6,   7,   8,   9,
+    10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+    25,  255, 255, 255, 255, 255, 255, 26,  27,  28,  29,  30,  31,  32,  33,
+    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,
+    49,  50,  51,  255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, };
+
+int grpc_chttp2_base64_force_scalar_for_testing = 0;
+
+#ifdef BASE64_SSSE3
+static gpr_once ssse3_once = GPR_ONCE_INIT;
+static int have_ssse3;
+
+static void check_ssse3(void) {
+  __builtin_cpu_init();
+  have_ssse3 = __builtin_cpu_supports("ssse3");
+}
+
+static int use_ssse3(void) {
+  if (grpc_chttp2_base64_force_scalar_for_testing) return 0;
+  gpr_once_init(&ssse3_once, check_ssse3);
+  return have_ssse3;
+}
+
+/* Split each input triplet into its four 6 bit values, one per byte:
+   the technique (and the ones below) are described at
+   http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html */
+SSSE3_FN static __m128i indices_ssse3(const gpr_uint8 *in) {
+  __m128i v = _mm_loadu_si128((const __m128i *)in);
+  __m128i t0, t1;
+  v = _mm_shuffle_epi8(
+      v, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                       _mm_set1_epi32(0x04000040));
+  t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                       _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t0, t1);
+}
+
+/* Write the base64 indices for as many whole blocks of four triplets as
+   possible, while at least 16 input bytes are readable (only 12 are used).
+   Returns the number of triplets done. */
+SSSE3_FN static size_t b64_indices_ssse3(const gpr_uint8 *in, size_t triplets,
+                                         size_t readable, gpr_uint8 *out) {
+  size_t done = 0;
+  while (triplets - done >= 4 && readable >= 16) {
+    _mm_storeu_si128((__m128i *)out, indices_ssse3(in));
+    in += 12;
+    readable -= 12;
+    out += 16;
+    done += 4;
+  }
+  return done;
+}
+
+/* As b64_indices_ssse3, but write the base64 characters */
+SSSE3_FN static size_t b64_encode_ssse3(const gpr_uint8 *in, size_t triplets,
+                                        size_t readable, gpr_uint8 *out) {
+  size_t done = 0;
+  __m128i idx, shift, below_26;
+  while (triplets - done >= 4 && readable >= 16) {
+    idx = indices_ssse3(in);
+    /* classify: 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11,
+       63 -> 12, then look up the offset to add for each class */
+    shift = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    below_26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+    shift = _mm_or_si128(shift, _mm_and_si128(below_26, _mm_set1_epi8(13)));
+    shift = _mm_shuffle_epi8(
+        _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0),
+        shift);
+    _mm_storeu_si128((__m128i *)out, _mm_add_epi8(idx, shift));
+    in += 12;
+    readable -= 12;
+    out += 16;
+    done += 4;
+  }
+  return done;
+}
+
+/* Decode 16 characters at a time, stopping at the first block with a
+   character outside the alphabet. Returns the number of groups decoded. */
+SSSE3_FN static size_t b64_decode_ssse3(const gpr_uint8 *in, size_t groups,
+                                        gpr_uint8 *out) {
+  size_t done = 0;
+  __m128i v, hi, lo, roll, merged;
+  int tail;
+  while (groups - done >= 4) {
+    v = _mm_loadu_si128((const __m128i *)in);
+    hi = _mm_and_si128(_mm_srli_epi32(v, 4), _mm_set1_epi8(0x0f));
+    lo = _mm_and_si128(v, _mm_set1_epi8(0x0f));
+    /* a character is valid iff the classes of its two nibbles are disjoint */
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(
+            _mm_and_si128(
+                _mm_shuffle_epi8(
+                    _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                  0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b,
+                                  0x1b, 0x1a),
+                    lo),
+                _mm_shuffle_epi8(
+                    _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04,
+                                  0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                  0x10, 0x10),
+                    hi)),
+            _mm_setzero_si128()))) {
+      break;
+    }
+    /* map characters to values by adding an offset chosen by high nibble
+       ('/' shares its high nibble with '+', so gets its own) */
+    roll = _mm_shuffle_epi8(
+        _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+                      0),
+        _mm_add_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')), hi));
+    v = _mm_add_epi8(v, roll);
+    /* pack four 6 bit values into three bytes in each 32 bit lane */
+    merged = _mm_madd_epi16(_mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140)),
+                            _mm_set1_epi32(0x00011000));
+    merged = _mm_shuffle_epi8(
+        merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                              -1, -1));
+    _mm_storel_epi64((__m128i *)out, merged);
+    tail = _mm_cvtsi128_si32(_mm_srli_si128(merged, 8));
+    memcpy(out + 8, &tail, 4);
+    in += 16;
+    out += 12;
+    done += 4;
+  }
+  return done;
+}
+#endif
+
 typedef struct {
   gpr_uint16 bits;
   gpr_uint8 length;
@@ -121,10 +283,18 @@ gpr_slice grpc_chttp2_base64_encode(gpr_slice input) {
   gpr_slice output = gpr_slice_malloc(output_length);
   gpr_uint8 *in = GPR_SLICE_START_PTR(input);
   gpr_uint8 *out = GPR_SLICE_START_PTR(output);
-  size_t i;
+  size_t i = 0;
+
+#ifdef BASE64_SSSE3
+  if (use_ssse3()) {
+    i = b64_encode_ssse3(in, input_triplets, input_length, out);
+    in += 3 * i;
+    out += 4 * i;
+  }
+#endif
 
   /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
+  for (; i < input_triplets; i++) {
     out[0] = alphabet[in[0] >> 2];
     out[1] = alphabet[((in[0] & 0x3) << 4) | (in[1] >> 4)];
     out[2] = alphabet[((in[1] & 0xf) << 2) | (in[2] >> 6)];
@@ -162,7 +332,8 @@ gpr_slice grpc_chttp2_huffman_compress(gpr_slice input) {
   gpr_uint8 *in;
   gpr_uint8 *out;
   gpr_slice output;
-  gpr_uint32 temp = 0;
+  /* up to 8 pending bits plus a 30 bit code: too many for 32 bits */
+  gpr_uint64 temp = 0;
   gpr_uint32 temp_length = 0;
 
   nbits = 0;
@@ -180,12 +351,12 @@ gpr_slice grpc_chttp2_huffman_compress(gpr_slice input) {
 
     while (temp_length > 8) {
       temp_length -= 8;
-      *out++ = temp >> temp_length;
+      *out++ = (gpr_uint8)(temp >> temp_length);
     }
   }
 
   if (temp_length) {
-    *out++ = (temp << (8 - temp_length)) | (0xff >> temp_length);
+    *out++ = (gpr_uint8)(temp << (8 - temp_length)) | (0xff >> temp_length);
   }
 
   GPR_ASSERT(out == GPR_SLICE_END_PTR(output));
@@ -194,15 +365,23 @@ gpr_slice grpc_chttp2_huffman_compress(gpr_slice input) {
 }
 
 typedef struct {
-  gpr_uint32 temp;
+  gpr_uint64 temp;
   gpr_uint32 temp_length;
   gpr_uint8 *out;
 } huff_out;
 
+/* write out pending bits 32 at a time: at most 31 remain pending, leaving
+   room for a pair of symbols */
 static void enc_flush_some(huff_out *out) {
-  while (out->temp_length > 8) {
-    out->temp_length -= 8;
-    *out->out++ = out->temp >> out->temp_length;
+  gpr_uint32 bits;
+  if (out->temp_length >= 32) {
+    out->temp_length -= 32;
+    bits = (gpr_uint32)(out->temp >> out->temp_length);
+    out->out[0] = (gpr_uint8)(bits >> 24);
+    out->out[1] = (gpr_uint8)(bits >> 16);
+    out->out[2] = (gpr_uint8)(bits >> 8);
+    out->out[3] = (gpr_uint8)bits;
+    out->out += 4;
   }
 }
 
@@ -233,14 +412,34 @@ gpr_slice grpc_chttp2_base64_encode_and_huffman_compress(gpr_slice input) {
   gpr_uint8 *in = GPR_SLICE_START_PTR(input);
   gpr_uint8 *start_out = GPR_SLICE_START_PTR(output);
   huff_out out;
-  size_t i;
+  size_t i = 0;
+  size_t j;
+  size_t n;
+#ifdef BASE64_SSSE3
+  gpr_uint8 indices[64];
+  int simd = use_ssse3();
+#endif
 
   out.temp = 0;
   out.temp_length = 0;
   out.out = start_out;
 
+#ifdef BASE64_SSSE3
+  /* split blocks of triplets into indices, then huffman encode those */
+  while (simd && i < input_triplets) {
+    n = b64_indices_ssse3(in, GPR_MIN(16, input_triplets - i),
+                          GPR_SLICE_END_PTR(input) - in, indices);
+    if (n == 0) break;
+    for (j = 0; j < 4 * n; j += 2) {
+      enc_add2(&out, indices[j], indices[j + 1]);
+    }
+    in += 3 * n;
+    i += n;
+  }
+#endif
+
   /* encode full triplets */
-  for (i = 0; i < input_triplets; i++) {
+  for (; i < input_triplets; i++) {
     enc_add2(&out, in[0] >> 2, ((in[0] & 0x3) << 4) | (in[1] >> 4));
     enc_add2(&out, ((in[1] & 0xf) << 2) | (in[2] >> 6), in[2] & 0x3f);
     in += 3;
@@ -261,9 +460,13 @@ gpr_slice grpc_chttp2_base64_encode_and_huffman_compress(gpr_slice input) {
       break;
   }
 
+  while (out.temp_length >= 8) {
+    out.temp_length -= 8;
+    *out.out++ = (gpr_uint8)(out.temp >> out.temp_length);
+  }
   if (out.temp_length) {
-    *out.out++ =
-        (out.temp << (8 - out.temp_length)) | (0xff >> out.temp_length);
+    *out.out++ = (gpr_uint8)(out.temp << (8 - out.temp_length)) |
+                 (0xff >> out.temp_length);
   }
 
   GPR_ASSERT(out.out <= GPR_SLICE_END_PTR(output));
@@ -273,6 +476,38 @@ gpr_slice grpc_chttp2_base64_encode_and_huffman_compress(gpr_slice input) {
   return output;
 }
 
+size_t grpc_chttp2_base64_decode_groups(const gpr_uint8 *input, size_t length,
+                                        gpr_uint8 *output) {
+  const gpr_uint8 *in = input;
+  size_t groups = length / 4;
+  size_t i = 0;
+  gpr_uint32 a, b, c, d;
+
+#ifdef BASE64_SSSE3
+  if (use_ssse3()) {
+    i = b64_decode_ssse3(in, groups, output);
+    in += 4 * i;
+    output += 3 * i;
+  }
+#endif
+
+  for (; i < groups; i++) {
+    a = inverse_alphabet[in[0]];
+    b = inverse_alphabet[in[1]];
+    c = inverse_alphabet[in[2]];
+    d = inverse_alphabet[in[3]];
+    if ((a | b | c | d) & 0x80) break;
+    a = (a << 18) | (b << 12) | (c << 6) | d;
+    output[0] = (gpr_uint8)(a >> 16);
+    output[1] = (gpr_uint8)(a >> 8);
+    output[2] = (gpr_uint8)a;
+    in += 4;
+    output += 3;
+  }
+
+  return in - input;
+}
+
 int grpc_is_binary_header(const char *key, size_t length) {
   if (length < 5) return 0;
   return 0 == memcmp(key + length - 4, "-bin", 4);
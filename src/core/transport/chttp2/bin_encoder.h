@@ -51,6 +51,17 @@ gpr_slice grpc_chttp2_huffman_compress(gpr_slice input);
    return y; */
 gpr_slice grpc_chttp2_base64_encode_and_huffman_compress(gpr_slice input);
 
+/* Decode the whole four character groups of unpadded base64 at the start of
+   input, stopping before the first group holding a character outside the
+   base64 alphabet (such as padding). Writes three bytes per group decoded to
+   output, which must have room for length / 4 * 3 bytes, and returns the
+   number of input characters consumed. */
+size_t grpc_chttp2_base64_decode_groups(const gpr_uint8 *input, size_t length,
+                                        gpr_uint8 *output);
+
 int grpc_is_binary_header(const char *key, size_t length);
 
+/* If non-zero, the base64 routines above skip their vectorized paths */
+extern int grpc_chttp2_base64_force_scalar_for_testing;
+
 #endif  /* GRPC_INTERNAL_CORE_TRANSPORT_CHTTP2_BIN_ENCODER_H */
@@ -44,11 +44,15 @@
 grpc_chttp2_parse_error grpc_chttp2_data_parser_init(
     grpc_chttp2_data_parser *parser) {
   parser->state = GRPC_CHTTP2_DATA_FH_0;
+  parser->reassembling = 0;
   grpc_sopb_init(&parser->incoming_sopb);
   return GRPC_CHTTP2_PARSE_OK;
 }
 
 void grpc_chttp2_data_parser_destroy(grpc_chttp2_data_parser *parser) {
+  if (parser->reassembling) {
+    gpr_slice_unref(parser->reassembly);
+  }
   grpc_sopb_destroy(&parser->incoming_sopb);
 }
 
@@ -68,6 +72,32 @@ grpc_chttp2_parse_error grpc_chttp2_data_parser_begin_frame(
   return GRPC_CHTTP2_PARSE_OK;
 }
 
+void grpc_chttp2_data_parser_swap_state(grpc_chttp2_data_parser *a,
+                                        grpc_chttp2_data_parser *b) {
+  grpc_chttp2_data_parser tmp;
+
+  tmp.state = a->state;
+  tmp.is_last_frame = a->is_last_frame;
+  tmp.frame_type = a->frame_type;
+  tmp.reassembling = a->reassembling;
+  tmp.frame_size = a->frame_size;
+  tmp.reassembly = a->reassembly;
+
+  a->state = b->state;
+  a->is_last_frame = b->is_last_frame;
+  a->frame_type = b->frame_type;
+  a->reassembling = b->reassembling;
+  a->frame_size = b->frame_size;
+  a->reassembly = b->reassembly;
+
+  b->state = tmp.state;
+  b->is_last_frame = tmp.is_last_frame;
+  b->frame_type = tmp.frame_type;
+  b->reassembling = tmp.reassembling;
+  b->frame_size = tmp.frame_size;
+  b->reassembly = tmp.reassembly;
+}
+
 grpc_chttp2_parse_error grpc_chttp2_data_parser_parse(
     void *parser, grpc_chttp2_parse_state *state, gpr_slice slice,
     int is_last) {
@@ -131,10 +161,40 @@ grpc_chttp2_parse_error grpc_chttp2_data_parser_parse(
       ++cur;
       state->need_flush_reads = 1;
       grpc_sopb_add_begin_message(&p->incoming_sopb, p->frame_size, 0);
+      if (p->frame_size == 0) {
+        p->state = GRPC_CHTTP2_DATA_FH_0;
+        if (cur == end) {
+          return GRPC_CHTTP2_PARSE_OK;
+        }
+        goto fh_0; /* loop */
+      }
+      /* a small message that isn't wholly within this slice gets copied
+         together, rather than passed up in pieces */
+      if (p->frame_size <= GRPC_CHTTP2_DATA_REASSEMBLY_THRESHOLD &&
+          (gpr_uint32)(end - cur) < p->frame_size) {
+        p->reassembling = 1;
+        p->reassembly = gpr_slice_malloc(p->frame_size);
+      }
     /* fallthrough */
     case GRPC_CHTTP2_DATA_FRAME:
       if (cur == end) {
         return GRPC_CHTTP2_PARSE_OK;
+      } else if (p->reassembling) {
+        size_t n = GPR_MIN((gpr_uint32)(end - cur), p->frame_size);
+        memcpy(GPR_SLICE_END_PTR(p->reassembly) - p->frame_size, cur, n);
+        cur += n;
+        p->frame_size -= n;
+        if (p->frame_size != 0) {
+          return GRPC_CHTTP2_PARSE_OK;
+        }
+        state->need_flush_reads = 1;
+        grpc_sopb_add_slice(&p->incoming_sopb, p->reassembly);
+        p->reassembling = 0;
+        p->state = GRPC_CHTTP2_DATA_FH_0;
+        if (cur == end) {
+          return GRPC_CHTTP2_PARSE_OK;
+        }
+        goto fh_0; /* loop */
       } else if ((gpr_uint32)(end - cur) == p->frame_size) {
         state->need_flush_reads = 1;
         grpc_sopb_add_slice(&p->incoming_sopb,
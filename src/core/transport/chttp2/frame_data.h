@@ -41,6 +41,12 @@
 #include "src/core/transport/stream_op.h"
 #include "src/core/transport/chttp2/frame.h"
 
+/* Messages no larger than this that arrive split across reads or DATA frames
+   are copied into one slice as they arrive, so that they travel up the stack
+   as a single GRPC_OP_SLICE. Larger messages are passed up as references into
+   the read slices, without copying. */
+#define GRPC_CHTTP2_DATA_REASSEMBLY_THRESHOLD 16384
+
 typedef enum {
   GRPC_CHTTP2_DATA_FH_0,
   GRPC_CHTTP2_DATA_FH_1,
@@ -54,7 +60,11 @@ typedef struct {
   grpc_chttp2_stream_state state;
   gpr_uint8 is_last_frame;
   gpr_uint8 frame_type;
+  gpr_uint8 reassembling;
   gpr_uint32 frame_size;
+  /* the message being reassembled, valid while reassembling is set; the last
+     frame_size bytes are yet to be filled */
+  gpr_slice reassembly;
 
   grpc_stream_op_buffer incoming_sopb;
 } grpc_chttp2_data_parser;
@@ -69,6 +79,11 @@ void grpc_chttp2_data_parser_destroy(grpc_chttp2_data_parser *parser);
 grpc_chttp2_parse_error grpc_chttp2_data_parser_begin_frame(
     grpc_chttp2_data_parser *parser, gpr_uint8 flags);
 
+/* exchange the frame parsing state of two parsers; each keeps its own
+   incoming_sopb, so what is parsed next lands in the other buffer */
+void grpc_chttp2_data_parser_swap_state(grpc_chttp2_data_parser *a,
+                                        grpc_chttp2_data_parser *b);
+
 /* handle a slice of a data frame - is_last indicates the last slice of a
    frame */
 grpc_chttp2_parse_error grpc_chttp2_data_parser_parse(
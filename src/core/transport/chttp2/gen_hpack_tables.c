@@ -35,6 +35,7 @@
 
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -126,197 +127,131 @@ static void generate_first_byte_lut(void) {
  * Huffman decoder table generation
  */
 
-#define MAXHUFFSTATES 1024
-
-/* represents a set of symbols as an array of booleans indicating inclusion */
-typedef struct {
-  char included[GRPC_CHTTP2_NUM_HUFFSYMS];
-} symset;
-/* represents a lookup table indexed by a nibble */
-typedef struct {
-  int values[16];
-} nibblelut;
-
-/* returns a symset that includes all possible symbols */
-static symset symset_all(void) {
-  symset x;
-  memset(x.included, 1, sizeof(x.included));
-  return x;
-}
-
-/* returns a symset that includes no symbols */
-static symset symset_none(void) {
-  symset x;
-  memset(x.included, 0, sizeof(x.included));
-  return x;
+/* number of input bits the decoder looks up at once: must match
+   HUFF_FAST_BITS in hpack_parser.c */
+#define HUFF_FAST_BITS 12
+/* the longest code in the hpack huffman table */
+#define HUFF_MAX_BITS 30
+
+/* symbols, sorted by (code length, code) */
+static int sorted_syms[GRPC_CHTTP2_NUM_HUFFSYMS];
+/* for each code length: how many codes have it, the first such code, and the
+   index in sorted_syms of its symbol */
+static unsigned len_count[HUFF_MAX_BITS + 1];
+static unsigned len_first_code[HUFF_MAX_BITS + 1];
+static unsigned len_offset[HUFF_MAX_BITS + 1];
+
+static int cmp_syms(const void *a, const void *b) {
+  const grpc_chttp2_huffsym *x = &grpc_chttp2_huffsyms[*(const int *)a];
+  const grpc_chttp2_huffsym *y = &grpc_chttp2_huffsyms[*(const int *)b];
+  if (x->length != y->length) return x->length < y->length ? -1 : 1;
+  if (x->bits != y->bits) return x->bits < y->bits ? -1 : 1;
+  return 0;
 }
 
-/* returns an empty nibblelut */
-static nibblelut nibblelut_empty(void) {
-  nibblelut x;
+/* sort the code, and check that it is canonical: that the codes of each
+   length are consecutive, and continue on from the (shifted) codes of the
+   previous length. This lets the decoder find a symbol from its code with
+   a per-length range check. */
+static void build_canonical_tables(void) {
   int i;
-  for (i = 0; i < 16; i++) {
-    x.values[i] = -1;
-  }
-  return x;
-}
+  const grpc_chttp2_huffsym *prev = NULL;
+  const grpc_chttp2_huffsym *cur;
 
-/* counts symbols in a symset - only used for debug builds */
-#ifndef NDEBUG
-static int nsyms(symset s) {
-  int i;
-  int c = 0;
   for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
-    c += s.included[i] != 0;
+    sorted_syms[i] = i;
   }
-  return c;
-}
-#endif
-
-/* global table of discovered huffman decoding states */
-static struct {
-  /* the bit offset that this state starts at */
-  int bitofs;
-  /* the set of symbols that this state started with */
-  symset syms;
-
-  /* lookup table for the next state */
-  nibblelut next;
-  /* lookup table for what to emit */
-  nibblelut emit;
-} huffstates[MAXHUFFSTATES];
-static int nhuffstates = 0;
-
-/* given a number of decoded bits and a set of symbols that are live,
-   return the index into the decoder table for this state.
-   set isnew to 1 if this state was previously undiscovered */
-static int state_index(int bitofs, symset syms, int *isnew) {
-  int i;
-  for (i = 0; i < nhuffstates; i++) {
-    if (huffstates[i].bitofs != bitofs) continue;
-    if (0 != memcmp(huffstates[i].syms.included, syms.included,
-                    GRPC_CHTTP2_NUM_HUFFSYMS))
-      continue;
-    *isnew = 0;
-    return i;
-  }
-  GPR_ASSERT(nhuffstates != MAXHUFFSTATES);
-  i = nhuffstates++;
-  huffstates[i].bitofs = bitofs;
-  huffstates[i].syms = syms;
-  huffstates[i].next = nibblelut_empty();
-  huffstates[i].emit = nibblelut_empty();
-  *isnew = 1;
-  return i;
-}
-
-/* recursively build a decoding table
-
-   state   - the huffman state that we are trying to fill in
-   nibble  - the current nibble
-   nibbits - the number of bits in the nibble that have been filled in
-   bitofs  - the number of bits of symbol that have been decoded
-   emit    - the symbol to emit on this nibble (or -1 if no symbol has been
-             found)
-   syms    - the set of symbols that could be matched */
-static void build_dec_tbl(int state, int nibble, int nibbits, int bitofs,
-                          int emit, symset syms) {
-  int i;
-  int bit;
+  qsort(sorted_syms, GRPC_CHTTP2_NUM_HUFFSYMS, sizeof(*sorted_syms),
+        cmp_syms);
 
-  /* If we have four bits in the nibble we're looking at, then we can fill in
-     a slot in the lookup tables. */
-  if (nibbits == 4) {
-    int isnew;
-    /* Find the state that we are in: this may be a new state, in which case
-       we recurse to fill it in, or we may have already seen this state, in
-       which case the recursion terminates */
-    int st = state_index(bitofs, syms, &isnew);
-    GPR_ASSERT(huffstates[state].next.values[nibble] == -1);
-    huffstates[state].next.values[nibble] = st;
-    huffstates[state].emit.values[nibble] = emit;
-    if (isnew) {
-      build_dec_tbl(st, 0, 0, bitofs, -1, syms);
+  for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
+    cur = &grpc_chttp2_huffsyms[sorted_syms[i]];
+    GPR_ASSERT(cur->length <= HUFF_MAX_BITS);
+    if (prev == NULL) {
+      GPR_ASSERT(cur->bits == 0);
+    } else {
+      GPR_ASSERT(cur->bits == (prev->bits + 1) << (cur->length - prev->length));
     }
-    return;
-  }
-
-  assert(nsyms(syms));
-
-  /* A bit can be 0 or 1 */
-  for (bit = 0; bit < 2; bit++) {
-    /* walk over active symbols and see if they have this bit set */
-    symset nextsyms = symset_none();
-    for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
-      if (!syms.included[i]) continue; /* disregard inactive symbols */
-      if (((grpc_chttp2_huffsyms[i].bits >>
-            (grpc_chttp2_huffsyms[i].length - bitofs - 1)) &
-           1) == bit) {
-        /* the bit is set, include it in the next recursive set */
-        if (grpc_chttp2_huffsyms[i].length == bitofs + 1) {
-          /* additionally, we've gotten to the end of a symbol - this is a
-             special recursion step: re-activate all the symbols, reset
-             bitofs to zero, and recurse */
-          build_dec_tbl(state, (nibble << 1) | bit, nibbits + 1, 0, i,
-                        symset_all());
-          /* skip the remainder of this loop */
-          goto next;
-        }
-        nextsyms.included[i] = 1;
-      }
+    if (len_count[cur->length]++ == 0) {
+      len_first_code[cur->length] = cur->bits;
+      len_offset[cur->length] = i;
     }
-    /* recurse down for this bit */
-    build_dec_tbl(state, (nibble << 1) | bit, nibbits + 1, bitofs + 1, emit,
-                  nextsyms);
-  next:
-    ;
+    prev = cur;
   }
 }
 
-static nibblelut ctbl[MAXHUFFSTATES];
-static int nctbl;
-
-static int ctbl_idx(nibblelut x) {
-  int i;
-  for (i = 0; i < nctbl; i++) {
-    if (0 == memcmp(&x, ctbl + i, sizeof(nibblelut))) return i;
+/* find the symbol whose code is a prefix of the nbits low bits of bits;
+   returns the symbol and stores its length in *length, or returns -1 if no
+   code fits */
+static int decode_sym(unsigned bits, unsigned nbits, unsigned *length) {
+  unsigned l;
+  unsigned code;
+  for (l = 1; l <= nbits && l <= HUFF_MAX_BITS; l++) {
+    code = (bits >> (nbits - l)) & ((1u << l) - 1);
+    if (code - len_first_code[l] < len_count[l]) {
+      *length = l;
+      return sorted_syms[len_offset[l] + code - len_first_code[l]];
+    }
   }
-  ctbl[i] = x;
-  nctbl++;
-  return i;
+  return -1;
 }
 
-static void dump_ctbl(const char *name) {
-  int i, j;
-  printf("static const gpr_int16 %s[%d*16] = {\n", name, nctbl);
-  for (i = 0; i < nctbl; i++) {
-    for (j = 0; j < 16; j++) {
-      printf("%d,", ctbl[i].values[j]);
-    }
-    printf("\n");
+static void dump_u32_tbl(const char *type, const char *name,
+                         const unsigned *values, int count, int hex) {
+  int i;
+  printf("static const %s %s[%d] = {", type, name, count);
+  for (i = 0; i < count; i++) {
+    printf(hex ? "0x%x," : "%u,", values[i]);
   }
   printf("};\n");
 }
 
+/* The fast table is indexed by the next HUFF_FAST_BITS bits of input, and
+   gives every symbol (up to two) whose code lies wholly within them:
+     bits 0-7   - the first symbol
+     bits 8-15  - the second symbol
+     bits 16-19 - the number of bits consumed by those symbols
+     bits 20-21 - the number of symbols (0 if the first code is longer than
+                  HUFF_FAST_BITS) */
 static void generate_huff_tables(void) {
-  int i;
-  build_dec_tbl(state_index(0, symset_all(), &i), 0, 0, 0, -1, symset_all());
-
-  nctbl = 0;
-  printf("static const gpr_uint8 next_tbl[%d] = {", nhuffstates);
-  for (i = 0; i < nhuffstates; i++) {
-    printf("%d,", ctbl_idx(huffstates[i].next));
+  static unsigned fast[1 << HUFF_FAST_BITS];
+  unsigned syms_by_code[GRPC_CHTTP2_NUM_HUFFSYMS];
+  unsigned i;
+  unsigned used;
+  unsigned nsyms;
+  unsigned length;
+  int sym;
+
+  build_canonical_tables();
+
+  for (i = 0; i < (1u << HUFF_FAST_BITS); i++) {
+    used = 0;
+    nsyms = 0;
+    fast[i] = 0;
+    /* decode_sym only looks at the low bits it is told about, which are
+       exactly the bits not yet consumed */
+    while (nsyms < 2 &&
+           (sym = decode_sym(i, HUFF_FAST_BITS - used, &length)) != -1) {
+      GPR_ASSERT(sym < 256);
+      fast[i] |= (unsigned)sym << (8 * nsyms);
+      used += length;
+      nsyms++;
+    }
+    fast[i] |= (used << 16) | (nsyms << 20);
   }
-  printf("};\n");
-  dump_ctbl("next_sub_tbl");
+  dump_u32_tbl("gpr_uint32", "huff_fast_tbl", fast, 1 << HUFF_FAST_BITS, 1);
 
-  nctbl = 0;
-  printf("static const gpr_uint16 emit_tbl[%d] = {", nhuffstates);
-  for (i = 0; i < nhuffstates; i++) {
-    printf("%d,", ctbl_idx(huffstates[i].emit));
+  for (i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) {
+    syms_by_code[i] = sorted_syms[i];
   }
-  printf("};\n");
-  dump_ctbl("emit_sub_tbl");
+  dump_u32_tbl("gpr_uint8", "huff_len_count", len_count, HUFF_MAX_BITS + 1,
+               0);
+  dump_u32_tbl("gpr_uint32", "huff_len_first_code", len_first_code,
+               HUFF_MAX_BITS + 1, 1);
+  dump_u32_tbl("gpr_uint16", "huff_len_offset", len_offset,
+               HUFF_MAX_BITS + 1, 0);
+  dump_u32_tbl("gpr_uint16", "huff_syms_by_code", syms_by_code,
+               GRPC_CHTTP2_NUM_HUFFSYMS, 0);
 }
 
 static void generate_base64_huff_encoder_table(void) {
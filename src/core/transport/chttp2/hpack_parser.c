@@ -223,371 +223,639 @@ static const gpr_uint8 first_byte_lut[256] = {
     INDEXED_FIELD,   INDEXED_FIELD, INDEXED_FIELD, INDEXED_FIELD,
     INDEXED_FIELD,   INDEXED_FIELD, INDEXED_FIELD, INDEXED_FIELD_X, };
 
-/* state table for huffman decoding: given a state, gives an index/16 into
-   next_sub_tbl. Taking that index and adding the value of the nibble being
-   considered returns the next state.
+/* huffman decoding tables: see add_huff_bytes for how they are used
 
    generated by gen_hpack_tables.c */
-static const gpr_uint8 next_tbl[256] = {
-    0,  1,  2,  3,  4,  1,  2, 5,  6,  1, 7,  8,  1,  3,  3,  9,  10, 11, 1,  1,
-    1,  12, 1,  2,  13, 1,  1, 1,  1,  1, 1,  1,  1,  1,  1,  1,  1,  1,  1,  2,
-    14, 1,  15, 16, 1,  17, 1, 15, 2,  7, 3,  18, 19, 1,  1,  1,  1,  20, 1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  7,  21, 1,  22, 1,  1,  1,  1,  1,
-    1,  1,  1,  15, 2,  2,  2, 2,  2,  2, 23, 24, 25, 1,  1,  1,  1,  2,  2,  2,
-    26, 3,  3,  27, 10, 28, 1, 1,  1,  1, 1,  1,  2,  3,  29, 10, 30, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  1,  1, 1,  31, 1,  1,  1,  1,  1,  1,  1,  2,
-    2,  2,  2,  2,  2,  2,  2, 32, 1,  1, 15, 33, 1,  34, 35, 9,  36, 1,  1,  1,
-    1,  1,  1,  1,  37, 1,  1, 1,  1,  1, 1,  2,  2,  2,  2,  2,  2,  2,  26, 9,
-    38, 1,  1,  1,  1,  1,  1, 1,  15, 2, 2,  2,  2,  26, 3,  3,  39, 1,  1,  1,
-    1,  1,  1,  1,  1,  1,  1, 1,  2,  2, 2,  2,  2,  2,  7,  3,  3,  3,  40, 2,
-    41, 1,  1,  1,  42, 43, 1, 1,  44, 1, 1,  1,  1,  15, 2,  2,  2,  2,  2,  2,
-    3,  3,  3,  45, 46, 1,  1, 2,  2,  2, 35, 3,  3,  18, 47, 2, };
-/* next state, based upon current state and the current nibble: see above.
-   generated by gen_hpack_tables.c */
-static const gpr_int16 next_sub_tbl[48 * 16] = {
-    1,   204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217,
-    218, 2,   6,   10,  13,  14,  15,  16,  17,  2,   6,   10,  13,  14,  15,
-    16,  17,  3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,  24,  3,
-    7,   11,  24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   5,
-    199, 200, 201, 202, 203, 4,   8,   4,   8,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   9,   133, 134, 135, 136, 137, 138, 139, 140,
-    141, 142, 143, 144, 145, 146, 147, 3,   7,   11,  24,  3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   12,  132, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   18,  19,  20,  21,  4,   8,   4,
-    8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   22,  23,  91,  25,  26,
-    27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  3,
-    7,   11,  24,  3,   7,   11,  24,  0,   0,   0,   0,   0,   41,  42,  43,
-    2,   6,   10,  13,  14,  15,  16,  17,  3,   7,   11,  24,  3,   7,   11,
-    24,  4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    44,  45,  2,   6,   10,  13,  14,  15,  16,  17,  46,  47,  48,  49,  50,
-    51,  52,  57,  4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   53,  54,  55,  56,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,
-    68,  69,  70,  71,  72,  74,  0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   73,  75,  76,  77,  78,  79,  80,  81,  82,
-    83,  84,  85,  86,  87,  88,  89,  90,  3,   7,   11,  24,  3,   7,   11,
-    24,  3,   7,   11,  24,  0,   0,   0,   0,   3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   92,  0,   0,   0,   93,  94,
-    95,  96,  97,  98,  99,  100, 101, 102, 103, 104, 105, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,
-    8,   4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 4,
-    8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,
-    0,   117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 2,   6,   10,  13,  14,  15,  16,  17,  4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   148,
-    149, 150, 151, 3,   7,   11,  24,  4,   8,   4,   8,   0,   0,   0,   0,
-    0,   0,   152, 153, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,   11,
-    24,  154, 155, 156, 164, 3,   7,   11,  24,  3,   7,   11,  24,  3,   7,
-    11,  24,  4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    157, 158, 159, 160, 161, 162, 163, 165, 166, 167, 168, 169, 170, 171, 172,
-    173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187,
-    188, 189, 190, 191, 192, 193, 194, 195, 196, 4,   8,   4,   8,   4,   8,
-    4,   8,   4,   8,   4,   8,   4,   8,   197, 198, 4,   8,   4,   8,   4,
-    8,   4,   8,   0,   0,   0,   0,   0,   0,   219, 220, 3,   7,   11,  24,
-    4,   8,   4,   8,   4,   8,   0,   0,   221, 222, 223, 224, 3,   7,   11,
-    24,  3,   7,   11,  24,  4,   8,   4,   8,   4,   8,   225, 228, 4,   8,
-    4,   8,   4,   8,   0,   0,   0,   0,   0,   0,   0,   0,   226, 227, 229,
-    230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244,
-    4,   8,   4,   8,   4,   8,   4,   8,   4,   8,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   245, 246, 247, 248, 249, 250, 251, 252,
-    253, 254, 0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   255, };
-/* emission table: indexed like next_tbl, ultimately gives the byte to be
-   emitted, or -1 for no byte, or 256 for end of stream
-
-   generated by gen_hpack_tables.c */
-static const gpr_uint16 emit_tbl[256] = {
-    0,   1,   2,   3,   4,   5,   6,   7,   0,   8,   9,   10,  11,  12,  13,
-    14,  15,  16,  17,  18,  19,  20,  21,  22,  0,   23,  24,  25,  26,  27,
-    28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,
-    43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  0,   55,  56,
-    57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  0,
-    71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,
-    86,  87,  88,  89,  90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100,
-    101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115,
-    116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130,
-    131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145,
-    146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 0,
-    160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174,
-    0,   175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188,
-    189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203,
-    204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218,
-    219, 220, 221, 0,   222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232,
-    233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247,
-    248, };
-/* generated by gen_hpack_tables.c */
-static const gpr_int16 emit_sub_tbl[249 * 16] = {
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  48,  48,  48,  48,  48,  48,  48,  48,  49,  49,  49,  49,  49,  49,
-    49,  49,  48,  48,  48,  48,  49,  49,  49,  49,  50,  50,  50,  50,  97,
-    97,  97,  97,  48,  48,  49,  49,  50,  50,  97,  97,  99,  99,  101, 101,
-    105, 105, 111, 111, 48,  49,  50,  97,  99,  101, 105, 111, 115, 116, -1,
-    -1,  -1,  -1,  -1,  -1,  32,  32,  32,  32,  32,  32,  32,  32,  37,  37,
-    37,  37,  37,  37,  37,  37,  99,  99,  99,  99,  101, 101, 101, 101, 105,
-    105, 105, 105, 111, 111, 111, 111, 115, 115, 116, 116, 32,  37,  45,  46,
-    47,  51,  52,  53,  54,  55,  56,  57,  61,  61,  61,  61,  61,  61,  61,
-    61,  65,  65,  65,  65,  65,  65,  65,  65,  115, 115, 115, 115, 116, 116,
-    116, 116, 32,  32,  37,  37,  45,  45,  46,  46,  61,  65,  95,  98,  100,
-    102, 103, 104, 108, 109, 110, 112, 114, 117, -1,  -1,  58,  58,  58,  58,
-    58,  58,  58,  58,  66,  66,  66,  66,  66,  66,  66,  66,  47,  47,  51,
-    51,  52,  52,  53,  53,  54,  54,  55,  55,  56,  56,  57,  57,  61,  61,
-    65,  65,  95,  95,  98,  98,  100, 100, 102, 102, 103, 103, 104, 104, 108,
-    108, 109, 109, 110, 110, 112, 112, 114, 114, 117, 117, 58,  66,  67,  68,
-    69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,
-    84,  85,  86,  87,  89,  106, 107, 113, 118, 119, 120, 121, 122, -1,  -1,
-    -1,  -1,  38,  38,  38,  38,  38,  38,  38,  38,  42,  42,  42,  42,  42,
-    42,  42,  42,  44,  44,  44,  44,  44,  44,  44,  44,  59,  59,  59,  59,
-    59,  59,  59,  59,  88,  88,  88,  88,  88,  88,  88,  88,  90,  90,  90,
-    90,  90,  90,  90,  90,  33,  33,  34,  34,  40,  40,  41,  41,  63,  63,
-    39,  43,  124, -1,  -1,  -1,  35,  35,  35,  35,  35,  35,  35,  35,  62,
-    62,  62,  62,  62,  62,  62,  62,  0,   0,   0,   0,   36,  36,  36,  36,
-    64,  64,  64,  64,  91,  91,  91,  91,  69,  69,  69,  69,  69,  69,  69,
-    69,  70,  70,  70,  70,  70,  70,  70,  70,  71,  71,  71,  71,  71,  71,
-    71,  71,  72,  72,  72,  72,  72,  72,  72,  72,  73,  73,  73,  73,  73,
-    73,  73,  73,  74,  74,  74,  74,  74,  74,  74,  74,  75,  75,  75,  75,
-    75,  75,  75,  75,  76,  76,  76,  76,  76,  76,  76,  76,  77,  77,  77,
-    77,  77,  77,  77,  77,  78,  78,  78,  78,  78,  78,  78,  78,  79,  79,
-    79,  79,  79,  79,  79,  79,  80,  80,  80,  80,  80,  80,  80,  80,  81,
-    81,  81,  81,  81,  81,  81,  81,  82,  82,  82,  82,  82,  82,  82,  82,
-    83,  83,  83,  83,  83,  83,  83,  83,  84,  84,  84,  84,  84,  84,  84,
-    84,  85,  85,  85,  85,  85,  85,  85,  85,  86,  86,  86,  86,  86,  86,
-    86,  86,  87,  87,  87,  87,  87,  87,  87,  87,  89,  89,  89,  89,  89,
-    89,  89,  89,  106, 106, 106, 106, 106, 106, 106, 106, 107, 107, 107, 107,
-    107, 107, 107, 107, 113, 113, 113, 113, 113, 113, 113, 113, 118, 118, 118,
-    118, 118, 118, 118, 118, 119, 119, 119, 119, 119, 119, 119, 119, 120, 120,
-    120, 120, 120, 120, 120, 120, 121, 121, 121, 121, 121, 121, 121, 121, 122,
-    122, 122, 122, 122, 122, 122, 122, 38,  38,  38,  38,  42,  42,  42,  42,
-    44,  44,  44,  44,  59,  59,  59,  59,  88,  88,  88,  88,  90,  90,  90,
-    90,  33,  34,  40,  41,  63,  -1,  -1,  -1,  39,  39,  39,  39,  39,  39,
-    39,  39,  43,  43,  43,  43,  43,  43,  43,  43,  124, 124, 124, 124, 124,
-    124, 124, 124, 35,  35,  35,  35,  62,  62,  62,  62,  0,   0,   36,  36,
-    64,  64,  91,  91,  93,  93,  126, 126, 94,  125, -1,  -1,  60,  60,  60,
-    60,  60,  60,  60,  60,  96,  96,  96,  96,  96,  96,  96,  96,  123, 123,
-    123, 123, 123, 123, 123, 123, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  92,
-    92,  92,  92,  92,  92,  92,  92,  195, 195, 195, 195, 195, 195, 195, 195,
-    208, 208, 208, 208, 208, 208, 208, 208, 128, 128, 128, 128, 130, 130, 130,
-    130, 131, 131, 131, 131, 162, 162, 162, 162, 184, 184, 184, 184, 194, 194,
-    194, 194, 224, 224, 224, 224, 226, 226, 226, 226, 153, 153, 161, 161, 167,
-    167, 172, 172, 176, 176, 177, 177, 179, 179, 209, 209, 216, 216, 217, 217,
-    227, 227, 229, 229, 230, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
-    163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228,
-    232, 233, -1,  -1,  -1,  -1,  1,   1,   1,   1,   1,   1,   1,   1,   135,
-    135, 135, 135, 135, 135, 135, 135, 137, 137, 137, 137, 137, 137, 137, 137,
-    138, 138, 138, 138, 138, 138, 138, 138, 139, 139, 139, 139, 139, 139, 139,
-    139, 140, 140, 140, 140, 140, 140, 140, 140, 141, 141, 141, 141, 141, 141,
-    141, 141, 143, 143, 143, 143, 143, 143, 143, 143, 147, 147, 147, 147, 147,
-    147, 147, 147, 149, 149, 149, 149, 149, 149, 149, 149, 150, 150, 150, 150,
-    150, 150, 150, 150, 151, 151, 151, 151, 151, 151, 151, 151, 152, 152, 152,
-    152, 152, 152, 152, 152, 155, 155, 155, 155, 155, 155, 155, 155, 157, 157,
-    157, 157, 157, 157, 157, 157, 158, 158, 158, 158, 158, 158, 158, 158, 165,
-    165, 165, 165, 165, 165, 165, 165, 166, 166, 166, 166, 166, 166, 166, 166,
-    168, 168, 168, 168, 168, 168, 168, 168, 174, 174, 174, 174, 174, 174, 174,
-    174, 175, 175, 175, 175, 175, 175, 175, 175, 180, 180, 180, 180, 180, 180,
-    180, 180, 182, 182, 182, 182, 182, 182, 182, 182, 183, 183, 183, 183, 183,
-    183, 183, 183, 188, 188, 188, 188, 188, 188, 188, 188, 191, 191, 191, 191,
-    191, 191, 191, 191, 197, 197, 197, 197, 197, 197, 197, 197, 231, 231, 231,
-    231, 231, 231, 231, 231, 239, 239, 239, 239, 239, 239, 239, 239, 9,   9,
-    9,   9,   142, 142, 142, 142, 144, 144, 144, 144, 145, 145, 145, 145, 148,
-    148, 148, 148, 159, 159, 159, 159, 171, 171, 171, 171, 206, 206, 206, 206,
-    215, 215, 215, 215, 225, 225, 225, 225, 236, 236, 236, 236, 237, 237, 237,
-    237, 199, 199, 207, 207, 234, 234, 235, 235, 192, 193, 200, 201, 202, 205,
-    210, 213, 218, 219, 238, 240, 242, 243, 255, -1,  203, 203, 203, 203, 203,
-    203, 203, 203, 204, 204, 204, 204, 204, 204, 204, 204, 211, 211, 211, 211,
-    211, 211, 211, 211, 212, 212, 212, 212, 212, 212, 212, 212, 214, 214, 214,
-    214, 214, 214, 214, 214, 221, 221, 221, 221, 221, 221, 221, 221, 222, 222,
-    222, 222, 222, 222, 222, 222, 223, 223, 223, 223, 223, 223, 223, 223, 241,
-    241, 241, 241, 241, 241, 241, 241, 244, 244, 244, 244, 244, 244, 244, 244,
-    245, 245, 245, 245, 245, 245, 245, 245, 246, 246, 246, 246, 246, 246, 246,
-    246, 247, 247, 247, 247, 247, 247, 247, 247, 248, 248, 248, 248, 248, 248,
-    248, 248, 250, 250, 250, 250, 250, 250, 250, 250, 251, 251, 251, 251, 251,
-    251, 251, 251, 252, 252, 252, 252, 252, 252, 252, 252, 253, 253, 253, 253,
-    253, 253, 253, 253, 254, 254, 254, 254, 254, 254, 254, 254, 2,   2,   2,
-    2,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,
-    6,   6,   7,   7,   7,   7,   8,   8,   8,   8,   11,  11,  11,  11,  12,
-    12,  12,  12,  14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,
-    17,  17,  17,  17,  18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,
-    20,  21,  21,  21,  21,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,
-    25,  25,  26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,
-    29,  29,  29,  30,  30,  30,  30,  31,  31,  31,  31,  127, 127, 127, 127,
-    220, 220, 220, 220, 249, 249, 249, 249, 10,  13,  22,  256, 93,  93,  93,
-    93,  126, 126, 126, 126, 94,  94,  125, 125, 60,  96,  123, -1,  92,  195,
-    208, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  128,
-    128, 128, 128, 128, 128, 128, 128, 130, 130, 130, 130, 130, 130, 130, 130,
-    131, 131, 131, 131, 131, 131, 131, 131, 162, 162, 162, 162, 162, 162, 162,
-    162, 184, 184, 184, 184, 184, 184, 184, 184, 194, 194, 194, 194, 194, 194,
-    194, 194, 224, 224, 224, 224, 224, 224, 224, 224, 226, 226, 226, 226, 226,
-    226, 226, 226, 153, 153, 153, 153, 161, 161, 161, 161, 167, 167, 167, 167,
-    172, 172, 172, 172, 176, 176, 176, 176, 177, 177, 177, 177, 179, 179, 179,
-    179, 209, 209, 209, 209, 216, 216, 216, 216, 217, 217, 217, 217, 227, 227,
-    227, 227, 229, 229, 229, 229, 230, 230, 230, 230, 129, 129, 132, 132, 133,
-    133, 134, 134, 136, 136, 146, 146, 154, 154, 156, 156, 160, 160, 163, 163,
-    164, 164, 169, 169, 170, 170, 173, 173, 178, 178, 181, 181, 185, 185, 186,
-    186, 187, 187, 189, 189, 190, 190, 196, 196, 198, 198, 228, 228, 232, 232,
-    233, 233, 1,   135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152,
-    155, 157, 158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231,
-    239, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  9,   9,   9,
-    9,   9,   9,   9,   9,   142, 142, 142, 142, 142, 142, 142, 142, 144, 144,
-    144, 144, 144, 144, 144, 144, 145, 145, 145, 145, 145, 145, 145, 145, 148,
-    148, 148, 148, 148, 148, 148, 148, 159, 159, 159, 159, 159, 159, 159, 159,
-    171, 171, 171, 171, 171, 171, 171, 171, 206, 206, 206, 206, 206, 206, 206,
-    206, 215, 215, 215, 215, 215, 215, 215, 215, 225, 225, 225, 225, 225, 225,
-    225, 225, 236, 236, 236, 236, 236, 236, 236, 236, 237, 237, 237, 237, 237,
-    237, 237, 237, 199, 199, 199, 199, 207, 207, 207, 207, 234, 234, 234, 234,
-    235, 235, 235, 235, 192, 192, 193, 193, 200, 200, 201, 201, 202, 202, 205,
-    205, 210, 210, 213, 213, 218, 218, 219, 219, 238, 238, 240, 240, 242, 242,
-    243, 243, 255, 255, 203, 204, 211, 212, 214, 221, 222, 223, 241, 244, 245,
-    246, 247, 248, 250, 251, 252, 253, 254, -1,  -1,  -1,  -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  2,   2,   2,   2,   2,   2,   2,
-    2,   3,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   4,
-    4,   4,   5,   5,   5,   5,   5,   5,   5,   5,   6,   6,   6,   6,   6,
-    6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,   8,   8,   8,   8,
-    8,   8,   8,   8,   11,  11,  11,  11,  11,  11,  11,  11,  12,  12,  12,
-    12,  12,  12,  12,  12,  14,  14,  14,  14,  14,  14,  14,  14,  15,  15,
-    15,  15,  15,  15,  15,  15,  16,  16,  16,  16,  16,  16,  16,  16,  17,
-    17,  17,  17,  17,  17,  17,  17,  18,  18,  18,  18,  18,  18,  18,  18,
-    19,  19,  19,  19,  19,  19,  19,  19,  20,  20,  20,  20,  20,  20,  20,
-    20,  21,  21,  21,  21,  21,  21,  21,  21,  23,  23,  23,  23,  23,  23,
-    23,  23,  24,  24,  24,  24,  24,  24,  24,  24,  25,  25,  25,  25,  25,
-    25,  25,  25,  26,  26,  26,  26,  26,  26,  26,  26,  27,  27,  27,  27,
-    27,  27,  27,  27,  28,  28,  28,  28,  28,  28,  28,  28,  29,  29,  29,
-    29,  29,  29,  29,  29,  30,  30,  30,  30,  30,  30,  30,  30,  31,  31,
-    31,  31,  31,  31,  31,  31,  127, 127, 127, 127, 127, 127, 127, 127, 220,
-    220, 220, 220, 220, 220, 220, 220, 249, 249, 249, 249, 249, 249, 249, 249,
-    10,  10,  13,  13,  22,  22,  256, 256, 67,  67,  67,  67,  67,  67,  67,
-    67,  68,  68,  68,  68,  68,  68,  68,  68,  95,  95,  95,  95,  95,  95,
-    95,  95,  98,  98,  98,  98,  98,  98,  98,  98,  100, 100, 100, 100, 100,
-    100, 100, 100, 102, 102, 102, 102, 102, 102, 102, 102, 103, 103, 103, 103,
-    103, 103, 103, 103, 104, 104, 104, 104, 104, 104, 104, 104, 108, 108, 108,
-    108, 108, 108, 108, 108, 109, 109, 109, 109, 109, 109, 109, 109, 110, 110,
-    110, 110, 110, 110, 110, 110, 112, 112, 112, 112, 112, 112, 112, 112, 114,
-    114, 114, 114, 114, 114, 114, 114, 117, 117, 117, 117, 117, 117, 117, 117,
-    58,  58,  58,  58,  66,  66,  66,  66,  67,  67,  67,  67,  68,  68,  68,
-    68,  69,  69,  69,  69,  70,  70,  70,  70,  71,  71,  71,  71,  72,  72,
-    72,  72,  73,  73,  73,  73,  74,  74,  74,  74,  75,  75,  75,  75,  76,
-    76,  76,  76,  77,  77,  77,  77,  78,  78,  78,  78,  79,  79,  79,  79,
-    80,  80,  80,  80,  81,  81,  81,  81,  82,  82,  82,  82,  83,  83,  83,
-    83,  84,  84,  84,  84,  85,  85,  85,  85,  86,  86,  86,  86,  87,  87,
-    87,  87,  89,  89,  89,  89,  106, 106, 106, 106, 107, 107, 107, 107, 113,
-    113, 113, 113, 118, 118, 118, 118, 119, 119, 119, 119, 120, 120, 120, 120,
-    121, 121, 121, 121, 122, 122, 122, 122, 38,  38,  42,  42,  44,  44,  59,
-    59,  88,  88,  90,  90,  -1,  -1,  -1,  -1,  33,  33,  33,  33,  33,  33,
-    33,  33,  34,  34,  34,  34,  34,  34,  34,  34,  40,  40,  40,  40,  40,
-    40,  40,  40,  41,  41,  41,  41,  41,  41,  41,  41,  63,  63,  63,  63,
-    63,  63,  63,  63,  39,  39,  39,  39,  43,  43,  43,  43,  124, 124, 124,
-    124, 35,  35,  62,  62,  0,   36,  64,  91,  93,  126, -1,  -1,  94,  94,
-    94,  94,  94,  94,  94,  94,  125, 125, 125, 125, 125, 125, 125, 125, 60,
-    60,  60,  60,  96,  96,  96,  96,  123, 123, 123, 123, -1,  -1,  -1,  -1,
-    92,  92,  92,  92,  195, 195, 195, 195, 208, 208, 208, 208, 128, 128, 130,
-    130, 131, 131, 162, 162, 184, 184, 194, 194, 224, 224, 226, 226, 153, 161,
-    167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, -1,  -1,  -1,  -1,
-    -1,  -1,  -1,  129, 129, 129, 129, 129, 129, 129, 129, 132, 132, 132, 132,
-    132, 132, 132, 132, 133, 133, 133, 133, 133, 133, 133, 133, 134, 134, 134,
-    134, 134, 134, 134, 134, 136, 136, 136, 136, 136, 136, 136, 136, 146, 146,
-    146, 146, 146, 146, 146, 146, 154, 154, 154, 154, 154, 154, 154, 154, 156,
-    156, 156, 156, 156, 156, 156, 156, 160, 160, 160, 160, 160, 160, 160, 160,
-    163, 163, 163, 163, 163, 163, 163, 163, 164, 164, 164, 164, 164, 164, 164,
-    164, 169, 169, 169, 169, 169, 169, 169, 169, 170, 170, 170, 170, 170, 170,
-    170, 170, 173, 173, 173, 173, 173, 173, 173, 173, 178, 178, 178, 178, 178,
-    178, 178, 178, 181, 181, 181, 181, 181, 181, 181, 181, 185, 185, 185, 185,
-    185, 185, 185, 185, 186, 186, 186, 186, 186, 186, 186, 186, 187, 187, 187,
-    187, 187, 187, 187, 187, 189, 189, 189, 189, 189, 189, 189, 189, 190, 190,
-    190, 190, 190, 190, 190, 190, 196, 196, 196, 196, 196, 196, 196, 196, 198,
-    198, 198, 198, 198, 198, 198, 198, 228, 228, 228, 228, 228, 228, 228, 228,
-    232, 232, 232, 232, 232, 232, 232, 232, 233, 233, 233, 233, 233, 233, 233,
-    233, 1,   1,   1,   1,   135, 135, 135, 135, 137, 137, 137, 137, 138, 138,
-    138, 138, 139, 139, 139, 139, 140, 140, 140, 140, 141, 141, 141, 141, 143,
-    143, 143, 143, 147, 147, 147, 147, 149, 149, 149, 149, 150, 150, 150, 150,
-    151, 151, 151, 151, 152, 152, 152, 152, 155, 155, 155, 155, 157, 157, 157,
-    157, 158, 158, 158, 158, 165, 165, 165, 165, 166, 166, 166, 166, 168, 168,
-    168, 168, 174, 174, 174, 174, 175, 175, 175, 175, 180, 180, 180, 180, 182,
-    182, 182, 182, 183, 183, 183, 183, 188, 188, 188, 188, 191, 191, 191, 191,
-    197, 197, 197, 197, 231, 231, 231, 231, 239, 239, 239, 239, 9,   9,   142,
-    142, 144, 144, 145, 145, 148, 148, 159, 159, 171, 171, 206, 206, 215, 215,
-    225, 225, 236, 236, 237, 237, 199, 207, 234, 235, 192, 192, 192, 192, 192,
-    192, 192, 192, 193, 193, 193, 193, 193, 193, 193, 193, 200, 200, 200, 200,
-    200, 200, 200, 200, 201, 201, 201, 201, 201, 201, 201, 201, 202, 202, 202,
-    202, 202, 202, 202, 202, 205, 205, 205, 205, 205, 205, 205, 205, 210, 210,
-    210, 210, 210, 210, 210, 210, 213, 213, 213, 213, 213, 213, 213, 213, 218,
-    218, 218, 218, 218, 218, 218, 218, 219, 219, 219, 219, 219, 219, 219, 219,
-    238, 238, 238, 238, 238, 238, 238, 238, 240, 240, 240, 240, 240, 240, 240,
-    240, 242, 242, 242, 242, 242, 242, 242, 242, 243, 243, 243, 243, 243, 243,
-    243, 243, 255, 255, 255, 255, 255, 255, 255, 255, 203, 203, 203, 203, 204,
-    204, 204, 204, 211, 211, 211, 211, 212, 212, 212, 212, 214, 214, 214, 214,
-    221, 221, 221, 221, 222, 222, 222, 222, 223, 223, 223, 223, 241, 241, 241,
-    241, 244, 244, 244, 244, 245, 245, 245, 245, 246, 246, 246, 246, 247, 247,
-    247, 247, 248, 248, 248, 248, 250, 250, 250, 250, 251, 251, 251, 251, 252,
-    252, 252, 252, 253, 253, 253, 253, 254, 254, 254, 254, 2,   2,   3,   3,
-    4,   4,   5,   5,   6,   6,   7,   7,   8,   8,   11,  11,  12,  12,  14,
-    14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,  20,  21,  21,
-    23,  23,  24,  24,  25,  25,  26,  26,  27,  27,  28,  28,  29,  29,  30,
-    30,  31,  31,  127, 127, 220, 220, 249, 249, -1,  -1,  10,  10,  10,  10,
-    10,  10,  10,  10,  13,  13,  13,  13,  13,  13,  13,  13,  22,  22,  22,
-    22,  22,  22,  22,  22,  256, 256, 256, 256, 256, 256, 256, 256, 45,  45,
-    45,  45,  45,  45,  45,  45,  46,  46,  46,  46,  46,  46,  46,  46,  47,
-    47,  47,  47,  47,  47,  47,  47,  51,  51,  51,  51,  51,  51,  51,  51,
-    52,  52,  52,  52,  52,  52,  52,  52,  53,  53,  53,  53,  53,  53,  53,
-    53,  54,  54,  54,  54,  54,  54,  54,  54,  55,  55,  55,  55,  55,  55,
-    55,  55,  56,  56,  56,  56,  56,  56,  56,  56,  57,  57,  57,  57,  57,
-    57,  57,  57,  50,  50,  50,  50,  50,  50,  50,  50,  97,  97,  97,  97,
-    97,  97,  97,  97,  99,  99,  99,  99,  99,  99,  99,  99,  101, 101, 101,
-    101, 101, 101, 101, 101, 105, 105, 105, 105, 105, 105, 105, 105, 111, 111,
-    111, 111, 111, 111, 111, 111, 115, 115, 115, 115, 115, 115, 115, 115, 116,
-    116, 116, 116, 116, 116, 116, 116, 32,  32,  32,  32,  37,  37,  37,  37,
-    45,  45,  45,  45,  46,  46,  46,  46,  47,  47,  47,  47,  51,  51,  51,
-    51,  52,  52,  52,  52,  53,  53,  53,  53,  54,  54,  54,  54,  55,  55,
-    55,  55,  56,  56,  56,  56,  57,  57,  57,  57,  61,  61,  61,  61,  65,
-    65,  65,  65,  95,  95,  95,  95,  98,  98,  98,  98,  100, 100, 100, 100,
-    102, 102, 102, 102, 103, 103, 103, 103, 104, 104, 104, 104, 108, 108, 108,
-    108, 109, 109, 109, 109, 110, 110, 110, 110, 112, 112, 112, 112, 114, 114,
-    114, 114, 117, 117, 117, 117, 58,  58,  66,  66,  67,  67,  68,  68,  69,
-    69,  70,  70,  71,  71,  72,  72,  73,  73,  74,  74,  75,  75,  76,  76,
-    77,  77,  78,  78,  79,  79,  80,  80,  81,  81,  82,  82,  83,  83,  84,
-    84,  85,  85,  86,  86,  87,  87,  89,  89,  106, 106, 107, 107, 113, 113,
-    118, 118, 119, 119, 120, 120, 121, 121, 122, 122, 38,  42,  44,  59,  88,
-    90,  -1,  -1,  33,  33,  33,  33,  34,  34,  34,  34,  40,  40,  40,  40,
-    41,  41,  41,  41,  63,  63,  63,  63,  39,  39,  43,  43,  124, 124, 35,
-    62,  -1,  -1,  -1,  -1,  0,   0,   0,   0,   0,   0,   0,   0,   36,  36,
-    36,  36,  36,  36,  36,  36,  64,  64,  64,  64,  64,  64,  64,  64,  91,
-    91,  91,  91,  91,  91,  91,  91,  93,  93,  93,  93,  93,  93,  93,  93,
-    126, 126, 126, 126, 126, 126, 126, 126, 94,  94,  94,  94,  125, 125, 125,
-    125, 60,  60,  96,  96,  123, 123, -1,  -1,  92,  92,  195, 195, 208, 208,
-    128, 130, 131, 162, 184, 194, 224, 226, -1,  -1,  153, 153, 153, 153, 153,
-    153, 153, 153, 161, 161, 161, 161, 161, 161, 161, 161, 167, 167, 167, 167,
-    167, 167, 167, 167, 172, 172, 172, 172, 172, 172, 172, 172, 176, 176, 176,
-    176, 176, 176, 176, 176, 177, 177, 177, 177, 177, 177, 177, 177, 179, 179,
-    179, 179, 179, 179, 179, 179, 209, 209, 209, 209, 209, 209, 209, 209, 216,
-    216, 216, 216, 216, 216, 216, 216, 217, 217, 217, 217, 217, 217, 217, 217,
-    227, 227, 227, 227, 227, 227, 227, 227, 229, 229, 229, 229, 229, 229, 229,
-    229, 230, 230, 230, 230, 230, 230, 230, 230, 129, 129, 129, 129, 132, 132,
-    132, 132, 133, 133, 133, 133, 134, 134, 134, 134, 136, 136, 136, 136, 146,
-    146, 146, 146, 154, 154, 154, 154, 156, 156, 156, 156, 160, 160, 160, 160,
-    163, 163, 163, 163, 164, 164, 164, 164, 169, 169, 169, 169, 170, 170, 170,
-    170, 173, 173, 173, 173, 178, 178, 178, 178, 181, 181, 181, 181, 185, 185,
-    185, 185, 186, 186, 186, 186, 187, 187, 187, 187, 189, 189, 189, 189, 190,
-    190, 190, 190, 196, 196, 196, 196, 198, 198, 198, 198, 228, 228, 228, 228,
-    232, 232, 232, 232, 233, 233, 233, 233, 1,   1,   135, 135, 137, 137, 138,
-    138, 139, 139, 140, 140, 141, 141, 143, 143, 147, 147, 149, 149, 150, 150,
-    151, 151, 152, 152, 155, 155, 157, 157, 158, 158, 165, 165, 166, 166, 168,
-    168, 174, 174, 175, 175, 180, 180, 182, 182, 183, 183, 188, 188, 191, 191,
-    197, 197, 231, 231, 239, 239, 9,   142, 144, 145, 148, 159, 171, 206, 215,
-    225, 236, 237, -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  -1,  199, 199,
-    199, 199, 199, 199, 199, 199, 207, 207, 207, 207, 207, 207, 207, 207, 234,
-    234, 234, 234, 234, 234, 234, 234, 235, 235, 235, 235, 235, 235, 235, 235,
-    192, 192, 192, 192, 193, 193, 193, 193, 200, 200, 200, 200, 201, 201, 201,
-    201, 202, 202, 202, 202, 205, 205, 205, 205, 210, 210, 210, 210, 213, 213,
-    213, 213, 218, 218, 218, 218, 219, 219, 219, 219, 238, 238, 238, 238, 240,
-    240, 240, 240, 242, 242, 242, 242, 243, 243, 243, 243, 255, 255, 255, 255,
-    203, 203, 204, 204, 211, 211, 212, 212, 214, 214, 221, 221, 222, 222, 223,
-    223, 241, 241, 244, 244, 245, 245, 246, 246, 247, 247, 248, 248, 250, 250,
-    251, 251, 252, 252, 253, 253, 254, 254, 2,   3,   4,   5,   6,   7,   8,
-    11,  12,  14,  15,  16,  17,  18,  19,  20,  21,  23,  24,  25,  26,  27,
-    28,  29,  30,  31,  127, 220, 249, -1,  10,  10,  10,  10,  13,  13,  13,
-    13,  22,  22,  22,  22,  256, 256, 256, 256, };
+#define HUFF_FAST_BITS 12
+#define HUFF_MAX_BITS 30
+/* given the next HUFF_FAST_BITS bits of input, gives the symbols (up to two)
+   whose codes lie wholly within them: the symbols are packed into the low two
+   bytes, the number of bits they take up into bits 16-19 and the number of
+   symbols into bits 20-21 */
+static const gpr_uint32 huff_fast_tbl[4096] = {
+    0x2a3030, 0x2a3030, 0x2a3030, 0x2a3030, 0x2a3130, 0x2a3130, 0x2a3130,
+    0x2a3130, 0x2a3230, 0x2a3230, 0x2a3230, 0x2a3230, 0x2a6130, 0x2a6130,
+    0x2a6130, 0x2a6130, 0x2a6330, 0x2a6330, 0x2a6330, 0x2a6330, 0x2a6530,
+    0x2a6530, 0x2a6530, 0x2a6530, 0x2a6930, 0x2a6930, 0x2a6930, 0x2a6930,
+    0x2a6f30, 0x2a6f30, 0x2a6f30, 0x2a6f30, 0x2a7330, 0x2a7330, 0x2a7330,
+    0x2a7330, 0x2a7430, 0x2a7430, 0x2a7430, 0x2a7430, 0x2b2030, 0x2b2030,
+    0x2b2530, 0x2b2530, 0x2b2d30, 0x2b2d30, 0x2b2e30, 0x2b2e30, 0x2b2f30,
+    0x2b2f30, 0x2b3330, 0x2b3330, 0x2b3430, 0x2b3430, 0x2b3530, 0x2b3530,
+    0x2b3630, 0x2b3630, 0x2b3730, 0x2b3730, 0x2b3830, 0x2b3830, 0x2b3930,
+    0x2b3930, 0x2b3d30, 0x2b3d30, 0x2b4130, 0x2b4130, 0x2b5f30, 0x2b5f30,
+    0x2b6230, 0x2b6230, 0x2b6430, 0x2b6430, 0x2b6630, 0x2b6630, 0x2b6730,
+    0x2b6730, 0x2b6830, 0x2b6830, 0x2b6c30, 0x2b6c30, 0x2b6d30, 0x2b6d30,
+    0x2b6e30, 0x2b6e30, 0x2b7030, 0x2b7030, 0x2b7230, 0x2b7230, 0x2b7530,
+    0x2b7530, 0x2c3a30, 0x2c4230, 0x2c4330, 0x2c4430, 0x2c4530, 0x2c4630,
+    0x2c4730, 0x2c4830, 0x2c4930, 0x2c4a30, 0x2c4b30, 0x2c4c30, 0x2c4d30,
+    0x2c4e30, 0x2c4f30, 0x2c5030, 0x2c5130, 0x2c5230, 0x2c5330, 0x2c5430,
+    0x2c5530, 0x2c5630, 0x2c5730, 0x2c5930, 0x2c6a30, 0x2c6b30, 0x2c7130,
+    0x2c7630, 0x2c7730, 0x2c7830, 0x2c7930, 0x2c7a30, 0x150030, 0x150030,
+    0x150030, 0x150030, 0x2a3031, 0x2a3031, 0x2a3031, 0x2a3031, 0x2a3131,
+    0x2a3131, 0x2a3131, 0x2a3131, 0x2a3231, 0x2a3231, 0x2a3231, 0x2a3231,
+    0x2a6131, 0x2a6131, 0x2a6131, 0x2a6131, 0x2a6331, 0x2a6331, 0x2a6331,
+    0x2a6331, 0x2a6531, 0x2a6531, 0x2a6531, 0x2a6531, 0x2a6931, 0x2a6931,
+    0x2a6931, 0x2a6931, 0x2a6f31, 0x2a6f31, 0x2a6f31, 0x2a6f31, 0x2a7331,
+    0x2a7331, 0x2a7331, 0x2a7331, 0x2a7431, 0x2a7431, 0x2a7431, 0x2a7431,
+    0x2b2031, 0x2b2031, 0x2b2531, 0x2b2531, 0x2b2d31, 0x2b2d31, 0x2b2e31,
+    0x2b2e31, 0x2b2f31, 0x2b2f31, 0x2b3331, 0x2b3331, 0x2b3431, 0x2b3431,
+    0x2b3531, 0x2b3531, 0x2b3631, 0x2b3631, 0x2b3731, 0x2b3731, 0x2b3831,
+    0x2b3831, 0x2b3931, 0x2b3931, 0x2b3d31, 0x2b3d31, 0x2b4131, 0x2b4131,
+    0x2b5f31, 0x2b5f31, 0x2b6231, 0x2b6231, 0x2b6431, 0x2b6431, 0x2b6631,
+    0x2b6631, 0x2b6731, 0x2b6731, 0x2b6831, 0x2b6831, 0x2b6c31, 0x2b6c31,
+    0x2b6d31, 0x2b6d31, 0x2b6e31, 0x2b6e31, 0x2b7031, 0x2b7031, 0x2b7231,
+    0x2b7231, 0x2b7531, 0x2b7531, 0x2c3a31, 0x2c4231, 0x2c4331, 0x2c4431,
+    0x2c4531, 0x2c4631, 0x2c4731, 0x2c4831, 0x2c4931, 0x2c4a31, 0x2c4b31,
+    0x2c4c31, 0x2c4d31, 0x2c4e31, 0x2c4f31, 0x2c5031, 0x2c5131, 0x2c5231,
+    0x2c5331, 0x2c5431, 0x2c5531, 0x2c5631, 0x2c5731, 0x2c5931, 0x2c6a31,
+    0x2c6b31, 0x2c7131, 0x2c7631, 0x2c7731, 0x2c7831, 0x2c7931, 0x2c7a31,
+    0x150031, 0x150031, 0x150031, 0x150031, 0x2a3032, 0x2a3032, 0x2a3032,
+    0x2a3032, 0x2a3132, 0x2a3132, 0x2a3132, 0x2a3132, 0x2a3232, 0x2a3232,
+    0x2a3232, 0x2a3232, 0x2a6132, 0x2a6132, 0x2a6132, 0x2a6132, 0x2a6332,
+    0x2a6332, 0x2a6332, 0x2a6332, 0x2a6532, 0x2a6532, 0x2a6532, 0x2a6532,
+    0x2a6932, 0x2a6932, 0x2a6932, 0x2a6932, 0x2a6f32, 0x2a6f32, 0x2a6f32,
+    0x2a6f32, 0x2a7332, 0x2a7332, 0x2a7332, 0x2a7332, 0x2a7432, 0x2a7432,
+    0x2a7432, 0x2a7432, 0x2b2032, 0x2b2032, 0x2b2532, 0x2b2532, 0x2b2d32,
+    0x2b2d32, 0x2b2e32, 0x2b2e32, 0x2b2f32, 0x2b2f32, 0x2b3332, 0x2b3332,
+    0x2b3432, 0x2b3432, 0x2b3532, 0x2b3532, 0x2b3632, 0x2b3632, 0x2b3732,
+    0x2b3732, 0x2b3832, 0x2b3832, 0x2b3932, 0x2b3932, 0x2b3d32, 0x2b3d32,
+    0x2b4132, 0x2b4132, 0x2b5f32, 0x2b5f32, 0x2b6232, 0x2b6232, 0x2b6432,
+    0x2b6432, 0x2b6632, 0x2b6632, 0x2b6732, 0x2b6732, 0x2b6832, 0x2b6832,
+    0x2b6c32, 0x2b6c32, 0x2b6d32, 0x2b6d32, 0x2b6e32, 0x2b6e32, 0x2b7032,
+    0x2b7032, 0x2b7232, 0x2b7232, 0x2b7532, 0x2b7532, 0x2c3a32, 0x2c4232,
+    0x2c4332, 0x2c4432, 0x2c4532, 0x2c4632, 0x2c4732, 0x2c4832, 0x2c4932,
+    0x2c4a32, 0x2c4b32, 0x2c4c32, 0x2c4d32, 0x2c4e32, 0x2c4f32, 0x2c5032,
+    0x2c5132, 0x2c5232, 0x2c5332, 0x2c5432, 0x2c5532, 0x2c5632, 0x2c5732,
+    0x2c5932, 0x2c6a32, 0x2c6b32, 0x2c7132, 0x2c7632, 0x2c7732, 0x2c7832,
+    0x2c7932, 0x2c7a32, 0x150032, 0x150032, 0x150032, 0x150032, 0x2a3061,
+    0x2a3061, 0x2a3061, 0x2a3061, 0x2a3161, 0x2a3161, 0x2a3161, 0x2a3161,
+    0x2a3261, 0x2a3261, 0x2a3261, 0x2a3261, 0x2a6161, 0x2a6161, 0x2a6161,
+    0x2a6161, 0x2a6361, 0x2a6361, 0x2a6361, 0x2a6361, 0x2a6561, 0x2a6561,
+    0x2a6561, 0x2a6561, 0x2a6961, 0x2a6961, 0x2a6961, 0x2a6961, 0x2a6f61,
+    0x2a6f61, 0x2a6f61, 0x2a6f61, 0x2a7361, 0x2a7361, 0x2a7361, 0x2a7361,
+    0x2a7461, 0x2a7461, 0x2a7461, 0x2a7461, 0x2b2061, 0x2b2061, 0x2b2561,
+    0x2b2561, 0x2b2d61, 0x2b2d61, 0x2b2e61, 0x2b2e61, 0x2b2f61, 0x2b2f61,
+    0x2b3361, 0x2b3361, 0x2b3461, 0x2b3461, 0x2b3561, 0x2b3561, 0x2b3661,
+    0x2b3661, 0x2b3761, 0x2b3761, 0x2b3861, 0x2b3861, 0x2b3961, 0x2b3961,
+    0x2b3d61, 0x2b3d61, 0x2b4161, 0x2b4161, 0x2b5f61, 0x2b5f61, 0x2b6261,
+    0x2b6261, 0x2b6461, 0x2b6461, 0x2b6661, 0x2b6661, 0x2b6761, 0x2b6761,
+    0x2b6861, 0x2b6861, 0x2b6c61, 0x2b6c61, 0x2b6d61, 0x2b6d61, 0x2b6e61,
+    0x2b6e61, 0x2b7061, 0x2b7061, 0x2b7261, 0x2b7261, 0x2b7561, 0x2b7561,
+    0x2c3a61, 0x2c4261, 0x2c4361, 0x2c4461, 0x2c4561, 0x2c4661, 0x2c4761,
+    0x2c4861, 0x2c4961, 0x2c4a61, 0x2c4b61, 0x2c4c61, 0x2c4d61, 0x2c4e61,
+    0x2c4f61, 0x2c5061, 0x2c5161, 0x2c5261, 0x2c5361, 0x2c5461, 0x2c5561,
+    0x2c5661, 0x2c5761, 0x2c5961, 0x2c6a61, 0x2c6b61, 0x2c7161, 0x2c7661,
+    0x2c7761, 0x2c7861, 0x2c7961, 0x2c7a61, 0x150061, 0x150061, 0x150061,
+    0x150061, 0x2a3063, 0x2a3063, 0x2a3063, 0x2a3063, 0x2a3163, 0x2a3163,
+    0x2a3163, 0x2a3163, 0x2a3263, 0x2a3263, 0x2a3263, 0x2a3263, 0x2a6163,
+    0x2a6163, 0x2a6163, 0x2a6163, 0x2a6363, 0x2a6363, 0x2a6363, 0x2a6363,
+    0x2a6563, 0x2a6563, 0x2a6563, 0x2a6563, 0x2a6963, 0x2a6963, 0x2a6963,
+    0x2a6963, 0x2a6f63, 0x2a6f63, 0x2a6f63, 0x2a6f63, 0x2a7363, 0x2a7363,
+    0x2a7363, 0x2a7363, 0x2a7463, 0x2a7463, 0x2a7463, 0x2a7463, 0x2b2063,
+    0x2b2063, 0x2b2563, 0x2b2563, 0x2b2d63, 0x2b2d63, 0x2b2e63, 0x2b2e63,
+    0x2b2f63, 0x2b2f63, 0x2b3363, 0x2b3363, 0x2b3463, 0x2b3463, 0x2b3563,
+    0x2b3563, 0x2b3663, 0x2b3663, 0x2b3763, 0x2b3763, 0x2b3863, 0x2b3863,
+    0x2b3963, 0x2b3963, 0x2b3d63, 0x2b3d63, 0x2b4163, 0x2b4163, 0x2b5f63,
+    0x2b5f63, 0x2b6263, 0x2b6263, 0x2b6463, 0x2b6463, 0x2b6663, 0x2b6663,
+    0x2b6763, 0x2b6763, 0x2b6863, 0x2b6863, 0x2b6c63, 0x2b6c63, 0x2b6d63,
+    0x2b6d63, 0x2b6e63, 0x2b6e63, 0x2b7063, 0x2b7063, 0x2b7263, 0x2b7263,
+    0x2b7563, 0x2b7563, 0x2c3a63, 0x2c4263, 0x2c4363, 0x2c4463, 0x2c4563,
+    0x2c4663, 0x2c4763, 0x2c4863, 0x2c4963, 0x2c4a63, 0x2c4b63, 0x2c4c63,
+    0x2c4d63, 0x2c4e63, 0x2c4f63, 0x2c5063, 0x2c5163, 0x2c5263, 0x2c5363,
+    0x2c5463, 0x2c5563, 0x2c5663, 0x2c5763, 0x2c5963, 0x2c6a63, 0x2c6b63,
+    0x2c7163, 0x2c7663, 0x2c7763, 0x2c7863, 0x2c7963, 0x2c7a63, 0x150063,
+    0x150063, 0x150063, 0x150063, 0x2a3065, 0x2a3065, 0x2a3065, 0x2a3065,
+    0x2a3165, 0x2a3165, 0x2a3165, 0x2a3165, 0x2a3265, 0x2a3265, 0x2a3265,
+    0x2a3265, 0x2a6165, 0x2a6165, 0x2a6165, 0x2a6165, 0x2a6365, 0x2a6365,
+    0x2a6365, 0x2a6365, 0x2a6565, 0x2a6565, 0x2a6565, 0x2a6565, 0x2a6965,
+    0x2a6965, 0x2a6965, 0x2a6965, 0x2a6f65, 0x2a6f65, 0x2a6f65, 0x2a6f65,
+    0x2a7365, 0x2a7365, 0x2a7365, 0x2a7365, 0x2a7465, 0x2a7465, 0x2a7465,
+    0x2a7465, 0x2b2065, 0x2b2065, 0x2b2565, 0x2b2565, 0x2b2d65, 0x2b2d65,
+    0x2b2e65, 0x2b2e65, 0x2b2f65, 0x2b2f65, 0x2b3365, 0x2b3365, 0x2b3465,
+    0x2b3465, 0x2b3565, 0x2b3565, 0x2b3665, 0x2b3665, 0x2b3765, 0x2b3765,
+    0x2b3865, 0x2b3865, 0x2b3965, 0x2b3965, 0x2b3d65, 0x2b3d65, 0x2b4165,
+    0x2b4165, 0x2b5f65, 0x2b5f65, 0x2b6265, 0x2b6265, 0x2b6465, 0x2b6465,
+    0x2b6665, 0x2b6665, 0x2b6765, 0x2b6765, 0x2b6865, 0x2b6865, 0x2b6c65,
+    0x2b6c65, 0x2b6d65, 0x2b6d65, 0x2b6e65, 0x2b6e65, 0x2b7065, 0x2b7065,
+    0x2b7265, 0x2b7265, 0x2b7565, 0x2b7565, 0x2c3a65, 0x2c4265, 0x2c4365,
+    0x2c4465, 0x2c4565, 0x2c4665, 0x2c4765, 0x2c4865, 0x2c4965, 0x2c4a65,
+    0x2c4b65, 0x2c4c65, 0x2c4d65, 0x2c4e65, 0x2c4f65, 0x2c5065, 0x2c5165,
+    0x2c5265, 0x2c5365, 0x2c5465, 0x2c5565, 0x2c5665, 0x2c5765, 0x2c5965,
+    0x2c6a65, 0x2c6b65, 0x2c7165, 0x2c7665, 0x2c7765, 0x2c7865, 0x2c7965,
+    0x2c7a65, 0x150065, 0x150065, 0x150065, 0x150065, 0x2a3069, 0x2a3069,
+    0x2a3069, 0x2a3069, 0x2a3169, 0x2a3169, 0x2a3169, 0x2a3169, 0x2a3269,
+    0x2a3269, 0x2a3269, 0x2a3269, 0x2a6169, 0x2a6169, 0x2a6169, 0x2a6169,
+    0x2a6369, 0x2a6369, 0x2a6369, 0x2a6369, 0x2a6569, 0x2a6569, 0x2a6569,
+    0x2a6569, 0x2a6969, 0x2a6969, 0x2a6969, 0x2a6969, 0x2a6f69, 0x2a6f69,
+    0x2a6f69, 0x2a6f69, 0x2a7369, 0x2a7369, 0x2a7369, 0x2a7369, 0x2a7469,
+    0x2a7469, 0x2a7469, 0x2a7469, 0x2b2069, 0x2b2069, 0x2b2569, 0x2b2569,
+    0x2b2d69, 0x2b2d69, 0x2b2e69, 0x2b2e69, 0x2b2f69, 0x2b2f69, 0x2b3369,
+    0x2b3369, 0x2b3469, 0x2b3469, 0x2b3569, 0x2b3569, 0x2b3669, 0x2b3669,
+    0x2b3769, 0x2b3769, 0x2b3869, 0x2b3869, 0x2b3969, 0x2b3969, 0x2b3d69,
+    0x2b3d69, 0x2b4169, 0x2b4169, 0x2b5f69, 0x2b5f69, 0x2b6269, 0x2b6269,
+    0x2b6469, 0x2b6469, 0x2b6669, 0x2b6669, 0x2b6769, 0x2b6769, 0x2b6869,
+    0x2b6869, 0x2b6c69, 0x2b6c69, 0x2b6d69, 0x2b6d69, 0x2b6e69, 0x2b6e69,
+    0x2b7069, 0x2b7069, 0x2b7269, 0x2b7269, 0x2b7569, 0x2b7569, 0x2c3a69,
+    0x2c4269, 0x2c4369, 0x2c4469, 0x2c4569, 0x2c4669, 0x2c4769, 0x2c4869,
+    0x2c4969, 0x2c4a69, 0x2c4b69, 0x2c4c69, 0x2c4d69, 0x2c4e69, 0x2c4f69,
+    0x2c5069, 0x2c5169, 0x2c5269, 0x2c5369, 0x2c5469, 0x2c5569, 0x2c5669,
+    0x2c5769, 0x2c5969, 0x2c6a69, 0x2c6b69, 0x2c7169, 0x2c7669, 0x2c7769,
+    0x2c7869, 0x2c7969, 0x2c7a69, 0x150069, 0x150069, 0x150069, 0x150069,
+    0x2a306f, 0x2a306f, 0x2a306f, 0x2a306f, 0x2a316f, 0x2a316f, 0x2a316f,
+    0x2a316f, 0x2a326f, 0x2a326f, 0x2a326f, 0x2a326f, 0x2a616f, 0x2a616f,
+    0x2a616f, 0x2a616f, 0x2a636f, 0x2a636f, 0x2a636f, 0x2a636f, 0x2a656f,
+    0x2a656f, 0x2a656f, 0x2a656f, 0x2a696f, 0x2a696f, 0x2a696f, 0x2a696f,
+    0x2a6f6f, 0x2a6f6f, 0x2a6f6f, 0x2a6f6f, 0x2a736f, 0x2a736f, 0x2a736f,
+    0x2a736f, 0x2a746f, 0x2a746f, 0x2a746f, 0x2a746f, 0x2b206f, 0x2b206f,
+    0x2b256f, 0x2b256f, 0x2b2d6f, 0x2b2d6f, 0x2b2e6f, 0x2b2e6f, 0x2b2f6f,
+    0x2b2f6f, 0x2b336f, 0x2b336f, 0x2b346f, 0x2b346f, 0x2b356f, 0x2b356f,
+    0x2b366f, 0x2b366f, 0x2b376f, 0x2b376f, 0x2b386f, 0x2b386f, 0x2b396f,
+    0x2b396f, 0x2b3d6f, 0x2b3d6f, 0x2b416f, 0x2b416f, 0x2b5f6f, 0x2b5f6f,
+    0x2b626f, 0x2b626f, 0x2b646f, 0x2b646f, 0x2b666f, 0x2b666f, 0x2b676f,
+    0x2b676f, 0x2b686f, 0x2b686f, 0x2b6c6f, 0x2b6c6f, 0x2b6d6f, 0x2b6d6f,
+    0x2b6e6f, 0x2b6e6f, 0x2b706f, 0x2b706f, 0x2b726f, 0x2b726f, 0x2b756f,
+    0x2b756f, 0x2c3a6f, 0x2c426f, 0x2c436f, 0x2c446f, 0x2c456f, 0x2c466f,
+    0x2c476f, 0x2c486f, 0x2c496f, 0x2c4a6f, 0x2c4b6f, 0x2c4c6f, 0x2c4d6f,
+    0x2c4e6f, 0x2c4f6f, 0x2c506f, 0x2c516f, 0x2c526f, 0x2c536f, 0x2c546f,
+    0x2c556f, 0x2c566f, 0x2c576f, 0x2c596f, 0x2c6a6f, 0x2c6b6f, 0x2c716f,
+    0x2c766f, 0x2c776f, 0x2c786f, 0x2c796f, 0x2c7a6f, 0x15006f, 0x15006f,
+    0x15006f, 0x15006f, 0x2a3073, 0x2a3073, 0x2a3073, 0x2a3073, 0x2a3173,
+    0x2a3173, 0x2a3173, 0x2a3173, 0x2a3273, 0x2a3273, 0x2a3273, 0x2a3273,
+    0x2a6173, 0x2a6173, 0x2a6173, 0x2a6173, 0x2a6373, 0x2a6373, 0x2a6373,
+    0x2a6373, 0x2a6573, 0x2a6573, 0x2a6573, 0x2a6573, 0x2a6973, 0x2a6973,
+    0x2a6973, 0x2a6973, 0x2a6f73, 0x2a6f73, 0x2a6f73, 0x2a6f73, 0x2a7373,
+    0x2a7373, 0x2a7373, 0x2a7373, 0x2a7473, 0x2a7473, 0x2a7473, 0x2a7473,
+    0x2b2073, 0x2b2073, 0x2b2573, 0x2b2573, 0x2b2d73, 0x2b2d73, 0x2b2e73,
+    0x2b2e73, 0x2b2f73, 0x2b2f73, 0x2b3373, 0x2b3373, 0x2b3473, 0x2b3473,
+    0x2b3573, 0x2b3573, 0x2b3673, 0x2b3673, 0x2b3773, 0x2b3773, 0x2b3873,
+    0x2b3873, 0x2b3973, 0x2b3973, 0x2b3d73, 0x2b3d73, 0x2b4173, 0x2b4173,
+    0x2b5f73, 0x2b5f73, 0x2b6273, 0x2b6273, 0x2b6473, 0x2b6473, 0x2b6673,
+    0x2b6673, 0x2b6773, 0x2b6773, 0x2b6873, 0x2b6873, 0x2b6c73, 0x2b6c73,
+    0x2b6d73, 0x2b6d73, 0x2b6e73, 0x2b6e73, 0x2b7073, 0x2b7073, 0x2b7273,
+    0x2b7273, 0x2b7573, 0x2b7573, 0x2c3a73, 0x2c4273, 0x2c4373, 0x2c4473,
+    0x2c4573, 0x2c4673, 0x2c4773, 0x2c4873, 0x2c4973, 0x2c4a73, 0x2c4b73,
+    0x2c4c73, 0x2c4d73, 0x2c4e73, 0x2c4f73, 0x2c5073, 0x2c5173, 0x2c5273,
+    0x2c5373, 0x2c5473, 0x2c5573, 0x2c5673, 0x2c5773, 0x2c5973, 0x2c6a73,
+    0x2c6b73, 0x2c7173, 0x2c7673, 0x2c7773, 0x2c7873, 0x2c7973, 0x2c7a73,
+    0x150073, 0x150073, 0x150073, 0x150073, 0x2a3074, 0x2a3074, 0x2a3074,
+    0x2a3074, 0x2a3174, 0x2a3174, 0x2a3174, 0x2a3174, 0x2a3274, 0x2a3274,
+    0x2a3274, 0x2a3274, 0x2a6174, 0x2a6174, 0x2a6174, 0x2a6174, 0x2a6374,
+    0x2a6374, 0x2a6374, 0x2a6374, 0x2a6574, 0x2a6574, 0x2a6574, 0x2a6574,
+    0x2a6974, 0x2a6974, 0x2a6974, 0x2a6974, 0x2a6f74, 0x2a6f74, 0x2a6f74,
+    0x2a6f74, 0x2a7374, 0x2a7374, 0x2a7374, 0x2a7374, 0x2a7474, 0x2a7474,
+    0x2a7474, 0x2a7474, 0x2b2074, 0x2b2074, 0x2b2574, 0x2b2574, 0x2b2d74,
+    0x2b2d74, 0x2b2e74, 0x2b2e74, 0x2b2f74, 0x2b2f74, 0x2b3374, 0x2b3374,
+    0x2b3474, 0x2b3474, 0x2b3574, 0x2b3574, 0x2b3674, 0x2b3674, 0x2b3774,
+    0x2b3774, 0x2b3874, 0x2b3874, 0x2b3974, 0x2b3974, 0x2b3d74, 0x2b3d74,
+    0x2b4174, 0x2b4174, 0x2b5f74, 0x2b5f74, 0x2b6274, 0x2b6274, 0x2b6474,
+    0x2b6474, 0x2b6674, 0x2b6674, 0x2b6774, 0x2b6774, 0x2b6874, 0x2b6874,
+    0x2b6c74, 0x2b6c74, 0x2b6d74, 0x2b6d74, 0x2b6e74, 0x2b6e74, 0x2b7074,
+    0x2b7074, 0x2b7274, 0x2b7274, 0x2b7574, 0x2b7574, 0x2c3a74, 0x2c4274,
+    0x2c4374, 0x2c4474, 0x2c4574, 0x2c4674, 0x2c4774, 0x2c4874, 0x2c4974,
+    0x2c4a74, 0x2c4b74, 0x2c4c74, 0x2c4d74, 0x2c4e74, 0x2c4f74, 0x2c5074,
+    0x2c5174, 0x2c5274, 0x2c5374, 0x2c5474, 0x2c5574, 0x2c5674, 0x2c5774,
+    0x2c5974, 0x2c6a74, 0x2c6b74, 0x2c7174, 0x2c7674, 0x2c7774, 0x2c7874,
+    0x2c7974, 0x2c7a74, 0x150074, 0x150074, 0x150074, 0x150074, 0x2b3020,
+    0x2b3020, 0x2b3120, 0x2b3120, 0x2b3220, 0x2b3220, 0x2b6120, 0x2b6120,
+    0x2b6320, 0x2b6320, 0x2b6520, 0x2b6520, 0x2b6920, 0x2b6920, 0x2b6f20,
+    0x2b6f20, 0x2b7320, 0x2b7320, 0x2b7420, 0x2b7420, 0x2c2020, 0x2c2520,
+    0x2c2d20, 0x2c2e20, 0x2c2f20, 0x2c3320, 0x2c3420, 0x2c3520, 0x2c3620,
+    0x2c3720, 0x2c3820, 0x2c3920, 0x2c3d20, 0x2c4120, 0x2c5f20, 0x2c6220,
+    0x2c6420, 0x2c6620, 0x2c6720, 0x2c6820, 0x2c6c20, 0x2c6d20, 0x2c6e20,
+    0x2c7020, 0x2c7220, 0x2c7520, 0x160020, 0x160020, 0x160020, 0x160020,
+    0x160020, 0x160020, 0x160020, 0x160020, 0x160020, 0x160020, 0x160020,
+    0x160020, 0x160020, 0x160020, 0x160020, 0x160020, 0x160020, 0x160020,
+    0x2b3025, 0x2b3025, 0x2b3125, 0x2b3125, 0x2b3225, 0x2b3225, 0x2b6125,
+    0x2b6125, 0x2b6325, 0x2b6325, 0x2b6525, 0x2b6525, 0x2b6925, 0x2b6925,
+    0x2b6f25, 0x2b6f25, 0x2b7325, 0x2b7325, 0x2b7425, 0x2b7425, 0x2c2025,
+    0x2c2525, 0x2c2d25, 0x2c2e25, 0x2c2f25, 0x2c3325, 0x2c3425, 0x2c3525,
+    0x2c3625, 0x2c3725, 0x2c3825, 0x2c3925, 0x2c3d25, 0x2c4125, 0x2c5f25,
+    0x2c6225, 0x2c6425, 0x2c6625, 0x2c6725, 0x2c6825, 0x2c6c25, 0x2c6d25,
+    0x2c6e25, 0x2c7025, 0x2c7225, 0x2c7525, 0x160025, 0x160025, 0x160025,
+    0x160025, 0x160025, 0x160025, 0x160025, 0x160025, 0x160025, 0x160025,
+    0x160025, 0x160025, 0x160025, 0x160025, 0x160025, 0x160025, 0x160025,
+    0x160025, 0x2b302d, 0x2b302d, 0x2b312d, 0x2b312d, 0x2b322d, 0x2b322d,
+    0x2b612d, 0x2b612d, 0x2b632d, 0x2b632d, 0x2b652d, 0x2b652d, 0x2b692d,
+    0x2b692d, 0x2b6f2d, 0x2b6f2d, 0x2b732d, 0x2b732d, 0x2b742d, 0x2b742d,
+    0x2c202d, 0x2c252d, 0x2c2d2d, 0x2c2e2d, 0x2c2f2d, 0x2c332d, 0x2c342d,
+    0x2c352d, 0x2c362d, 0x2c372d, 0x2c382d, 0x2c392d, 0x2c3d2d, 0x2c412d,
+    0x2c5f2d, 0x2c622d, 0x2c642d, 0x2c662d, 0x2c672d, 0x2c682d, 0x2c6c2d,
+    0x2c6d2d, 0x2c6e2d, 0x2c702d, 0x2c722d, 0x2c752d, 0x16002d, 0x16002d,
+    0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d,
+    0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d, 0x16002d,
+    0x16002d, 0x16002d, 0x2b302e, 0x2b302e, 0x2b312e, 0x2b312e, 0x2b322e,
+    0x2b322e, 0x2b612e, 0x2b612e, 0x2b632e, 0x2b632e, 0x2b652e, 0x2b652e,
+    0x2b692e, 0x2b692e, 0x2b6f2e, 0x2b6f2e, 0x2b732e, 0x2b732e, 0x2b742e,
+    0x2b742e, 0x2c202e, 0x2c252e, 0x2c2d2e, 0x2c2e2e, 0x2c2f2e, 0x2c332e,
+    0x2c342e, 0x2c352e, 0x2c362e, 0x2c372e, 0x2c382e, 0x2c392e, 0x2c3d2e,
+    0x2c412e, 0x2c5f2e, 0x2c622e, 0x2c642e, 0x2c662e, 0x2c672e, 0x2c682e,
+    0x2c6c2e, 0x2c6d2e, 0x2c6e2e, 0x2c702e, 0x2c722e, 0x2c752e, 0x16002e,
+    0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e,
+    0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e, 0x16002e,
+    0x16002e, 0x16002e, 0x16002e, 0x2b302f, 0x2b302f, 0x2b312f, 0x2b312f,
+    0x2b322f, 0x2b322f, 0x2b612f, 0x2b612f, 0x2b632f, 0x2b632f, 0x2b652f,
+    0x2b652f, 0x2b692f, 0x2b692f, 0x2b6f2f, 0x2b6f2f, 0x2b732f, 0x2b732f,
+    0x2b742f, 0x2b742f, 0x2c202f, 0x2c252f, 0x2c2d2f, 0x2c2e2f, 0x2c2f2f,
+    0x2c332f, 0x2c342f, 0x2c352f, 0x2c362f, 0x2c372f, 0x2c382f, 0x2c392f,
+    0x2c3d2f, 0x2c412f, 0x2c5f2f, 0x2c622f, 0x2c642f, 0x2c662f, 0x2c672f,
+    0x2c682f, 0x2c6c2f, 0x2c6d2f, 0x2c6e2f, 0x2c702f, 0x2c722f, 0x2c752f,
+    0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f,
+    0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x16002f,
+    0x16002f, 0x16002f, 0x16002f, 0x16002f, 0x2b3033, 0x2b3033, 0x2b3133,
+    0x2b3133, 0x2b3233, 0x2b3233, 0x2b6133, 0x2b6133, 0x2b6333, 0x2b6333,
+    0x2b6533, 0x2b6533, 0x2b6933, 0x2b6933, 0x2b6f33, 0x2b6f33, 0x2b7333,
+    0x2b7333, 0x2b7433, 0x2b7433, 0x2c2033, 0x2c2533, 0x2c2d33, 0x2c2e33,
+    0x2c2f33, 0x2c3333, 0x2c3433, 0x2c3533, 0x2c3633, 0x2c3733, 0x2c3833,
+    0x2c3933, 0x2c3d33, 0x2c4133, 0x2c5f33, 0x2c6233, 0x2c6433, 0x2c6633,
+    0x2c6733, 0x2c6833, 0x2c6c33, 0x2c6d33, 0x2c6e33, 0x2c7033, 0x2c7233,
+    0x2c7533, 0x160033, 0x160033, 0x160033, 0x160033, 0x160033, 0x160033,
+    0x160033, 0x160033, 0x160033, 0x160033, 0x160033, 0x160033, 0x160033,
+    0x160033, 0x160033, 0x160033, 0x160033, 0x160033, 0x2b3034, 0x2b3034,
+    0x2b3134, 0x2b3134, 0x2b3234, 0x2b3234, 0x2b6134, 0x2b6134, 0x2b6334,
+    0x2b6334, 0x2b6534, 0x2b6534, 0x2b6934, 0x2b6934, 0x2b6f34, 0x2b6f34,
+    0x2b7334, 0x2b7334, 0x2b7434, 0x2b7434, 0x2c2034, 0x2c2534, 0x2c2d34,
+    0x2c2e34, 0x2c2f34, 0x2c3334, 0x2c3434, 0x2c3534, 0x2c3634, 0x2c3734,
+    0x2c3834, 0x2c3934, 0x2c3d34, 0x2c4134, 0x2c5f34, 0x2c6234, 0x2c6434,
+    0x2c6634, 0x2c6734, 0x2c6834, 0x2c6c34, 0x2c6d34, 0x2c6e34, 0x2c7034,
+    0x2c7234, 0x2c7534, 0x160034, 0x160034, 0x160034, 0x160034, 0x160034,
+    0x160034, 0x160034, 0x160034, 0x160034, 0x160034, 0x160034, 0x160034,
+    0x160034, 0x160034, 0x160034, 0x160034, 0x160034, 0x160034, 0x2b3035,
+    0x2b3035, 0x2b3135, 0x2b3135, 0x2b3235, 0x2b3235, 0x2b6135, 0x2b6135,
+    0x2b6335, 0x2b6335, 0x2b6535, 0x2b6535, 0x2b6935, 0x2b6935, 0x2b6f35,
+    0x2b6f35, 0x2b7335, 0x2b7335, 0x2b7435, 0x2b7435, 0x2c2035, 0x2c2535,
+    0x2c2d35, 0x2c2e35, 0x2c2f35, 0x2c3335, 0x2c3435, 0x2c3535, 0x2c3635,
+    0x2c3735, 0x2c3835, 0x2c3935, 0x2c3d35, 0x2c4135, 0x2c5f35, 0x2c6235,
+    0x2c6435, 0x2c6635, 0x2c6735, 0x2c6835, 0x2c6c35, 0x2c6d35, 0x2c6e35,
+    0x2c7035, 0x2c7235, 0x2c7535, 0x160035, 0x160035, 0x160035, 0x160035,
+    0x160035, 0x160035, 0x160035, 0x160035, 0x160035, 0x160035, 0x160035,
+    0x160035, 0x160035, 0x160035, 0x160035, 0x160035, 0x160035, 0x160035,
+    0x2b3036, 0x2b3036, 0x2b3136, 0x2b3136, 0x2b3236, 0x2b3236, 0x2b6136,
+    0x2b6136, 0x2b6336, 0x2b6336, 0x2b6536, 0x2b6536, 0x2b6936, 0x2b6936,
+    0x2b6f36, 0x2b6f36, 0x2b7336, 0x2b7336, 0x2b7436, 0x2b7436, 0x2c2036,
+    0x2c2536, 0x2c2d36, 0x2c2e36, 0x2c2f36, 0x2c3336, 0x2c3436, 0x2c3536,
+    0x2c3636, 0x2c3736, 0x2c3836, 0x2c3936, 0x2c3d36, 0x2c4136, 0x2c5f36,
+    0x2c6236, 0x2c6436, 0x2c6636, 0x2c6736, 0x2c6836, 0x2c6c36, 0x2c6d36,
+    0x2c6e36, 0x2c7036, 0x2c7236, 0x2c7536, 0x160036, 0x160036, 0x160036,
+    0x160036, 0x160036, 0x160036, 0x160036, 0x160036, 0x160036, 0x160036,
+    0x160036, 0x160036, 0x160036, 0x160036, 0x160036, 0x160036, 0x160036,
+    0x160036, 0x2b3037, 0x2b3037, 0x2b3137, 0x2b3137, 0x2b3237, 0x2b3237,
+    0x2b6137, 0x2b6137, 0x2b6337, 0x2b6337, 0x2b6537, 0x2b6537, 0x2b6937,
+    0x2b6937, 0x2b6f37, 0x2b6f37, 0x2b7337, 0x2b7337, 0x2b7437, 0x2b7437,
+    0x2c2037, 0x2c2537, 0x2c2d37, 0x2c2e37, 0x2c2f37, 0x2c3337, 0x2c3437,
+    0x2c3537, 0x2c3637, 0x2c3737, 0x2c3837, 0x2c3937, 0x2c3d37, 0x2c4137,
+    0x2c5f37, 0x2c6237, 0x2c6437, 0x2c6637, 0x2c6737, 0x2c6837, 0x2c6c37,
+    0x2c6d37, 0x2c6e37, 0x2c7037, 0x2c7237, 0x2c7537, 0x160037, 0x160037,
+    0x160037, 0x160037, 0x160037, 0x160037, 0x160037, 0x160037, 0x160037,
+    0x160037, 0x160037, 0x160037, 0x160037, 0x160037, 0x160037, 0x160037,
+    0x160037, 0x160037, 0x2b3038, 0x2b3038, 0x2b3138, 0x2b3138, 0x2b3238,
+    0x2b3238, 0x2b6138, 0x2b6138, 0x2b6338, 0x2b6338, 0x2b6538, 0x2b6538,
+    0x2b6938, 0x2b6938, 0x2b6f38, 0x2b6f38, 0x2b7338, 0x2b7338, 0x2b7438,
+    0x2b7438, 0x2c2038, 0x2c2538, 0x2c2d38, 0x2c2e38, 0x2c2f38, 0x2c3338,
+    0x2c3438, 0x2c3538, 0x2c3638, 0x2c3738, 0x2c3838, 0x2c3938, 0x2c3d38,
+    0x2c4138, 0x2c5f38, 0x2c6238, 0x2c6438, 0x2c6638, 0x2c6738, 0x2c6838,
+    0x2c6c38, 0x2c6d38, 0x2c6e38, 0x2c7038, 0x2c7238, 0x2c7538, 0x160038,
+    0x160038, 0x160038, 0x160038, 0x160038, 0x160038, 0x160038, 0x160038,
+    0x160038, 0x160038, 0x160038, 0x160038, 0x160038, 0x160038, 0x160038,
+    0x160038, 0x160038, 0x160038, 0x2b3039, 0x2b3039, 0x2b3139, 0x2b3139,
+    0x2b3239, 0x2b3239, 0x2b6139, 0x2b6139, 0x2b6339, 0x2b6339, 0x2b6539,
+    0x2b6539, 0x2b6939, 0x2b6939, 0x2b6f39, 0x2b6f39, 0x2b7339, 0x2b7339,
+    0x2b7439, 0x2b7439, 0x2c2039, 0x2c2539, 0x2c2d39, 0x2c2e39, 0x2c2f39,
+    0x2c3339, 0x2c3439, 0x2c3539, 0x2c3639, 0x2c3739, 0x2c3839, 0x2c3939,
+    0x2c3d39, 0x2c4139, 0x2c5f39, 0x2c6239, 0x2c6439, 0x2c6639, 0x2c6739,
+    0x2c6839, 0x2c6c39, 0x2c6d39, 0x2c6e39, 0x2c7039, 0x2c7239, 0x2c7539,
+    0x160039, 0x160039, 0x160039, 0x160039, 0x160039, 0x160039, 0x160039,
+    0x160039, 0x160039, 0x160039, 0x160039, 0x160039, 0x160039, 0x160039,
+    0x160039, 0x160039, 0x160039, 0x160039, 0x2b303d, 0x2b303d, 0x2b313d,
+    0x2b313d, 0x2b323d, 0x2b323d, 0x2b613d, 0x2b613d, 0x2b633d, 0x2b633d,
+    0x2b653d, 0x2b653d, 0x2b693d, 0x2b693d, 0x2b6f3d, 0x2b6f3d, 0x2b733d,
+    0x2b733d, 0x2b743d, 0x2b743d, 0x2c203d, 0x2c253d, 0x2c2d3d, 0x2c2e3d,
+    0x2c2f3d, 0x2c333d, 0x2c343d, 0x2c353d, 0x2c363d, 0x2c373d, 0x2c383d,
+    0x2c393d, 0x2c3d3d, 0x2c413d, 0x2c5f3d, 0x2c623d, 0x2c643d, 0x2c663d,
+    0x2c673d, 0x2c683d, 0x2c6c3d, 0x2c6d3d, 0x2c6e3d, 0x2c703d, 0x2c723d,
+    0x2c753d, 0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d,
+    0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d,
+    0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x16003d, 0x2b3041, 0x2b3041,
+    0x2b3141, 0x2b3141, 0x2b3241, 0x2b3241, 0x2b6141, 0x2b6141, 0x2b6341,
+    0x2b6341, 0x2b6541, 0x2b6541, 0x2b6941, 0x2b6941, 0x2b6f41, 0x2b6f41,
+    0x2b7341, 0x2b7341, 0x2b7441, 0x2b7441, 0x2c2041, 0x2c2541, 0x2c2d41,
+    0x2c2e41, 0x2c2f41, 0x2c3341, 0x2c3441, 0x2c3541, 0x2c3641, 0x2c3741,
+    0x2c3841, 0x2c3941, 0x2c3d41, 0x2c4141, 0x2c5f41, 0x2c6241, 0x2c6441,
+    0x2c6641, 0x2c6741, 0x2c6841, 0x2c6c41, 0x2c6d41, 0x2c6e41, 0x2c7041,
+    0x2c7241, 0x2c7541, 0x160041, 0x160041, 0x160041, 0x160041, 0x160041,
+    0x160041, 0x160041, 0x160041, 0x160041, 0x160041, 0x160041, 0x160041,
+    0x160041, 0x160041, 0x160041, 0x160041, 0x160041, 0x160041, 0x2b305f,
+    0x2b305f, 0x2b315f, 0x2b315f, 0x2b325f, 0x2b325f, 0x2b615f, 0x2b615f,
+    0x2b635f, 0x2b635f, 0x2b655f, 0x2b655f, 0x2b695f, 0x2b695f, 0x2b6f5f,
+    0x2b6f5f, 0x2b735f, 0x2b735f, 0x2b745f, 0x2b745f, 0x2c205f, 0x2c255f,
+    0x2c2d5f, 0x2c2e5f, 0x2c2f5f, 0x2c335f, 0x2c345f, 0x2c355f, 0x2c365f,
+    0x2c375f, 0x2c385f, 0x2c395f, 0x2c3d5f, 0x2c415f, 0x2c5f5f, 0x2c625f,
+    0x2c645f, 0x2c665f, 0x2c675f, 0x2c685f, 0x2c6c5f, 0x2c6d5f, 0x2c6e5f,
+    0x2c705f, 0x2c725f, 0x2c755f, 0x16005f, 0x16005f, 0x16005f, 0x16005f,
+    0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f,
+    0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f, 0x16005f,
+    0x2b3062, 0x2b3062, 0x2b3162, 0x2b3162, 0x2b3262, 0x2b3262, 0x2b6162,
+    0x2b6162, 0x2b6362, 0x2b6362, 0x2b6562, 0x2b6562, 0x2b6962, 0x2b6962,
+    0x2b6f62, 0x2b6f62, 0x2b7362, 0x2b7362, 0x2b7462, 0x2b7462, 0x2c2062,
+    0x2c2562, 0x2c2d62, 0x2c2e62, 0x2c2f62, 0x2c3362, 0x2c3462, 0x2c3562,
+    0x2c3662, 0x2c3762, 0x2c3862, 0x2c3962, 0x2c3d62, 0x2c4162, 0x2c5f62,
+    0x2c6262, 0x2c6462, 0x2c6662, 0x2c6762, 0x2c6862, 0x2c6c62, 0x2c6d62,
+    0x2c6e62, 0x2c7062, 0x2c7262, 0x2c7562, 0x160062, 0x160062, 0x160062,
+    0x160062, 0x160062, 0x160062, 0x160062, 0x160062, 0x160062, 0x160062,
+    0x160062, 0x160062, 0x160062, 0x160062, 0x160062, 0x160062, 0x160062,
+    0x160062, 0x2b3064, 0x2b3064, 0x2b3164, 0x2b3164, 0x2b3264, 0x2b3264,
+    0x2b6164, 0x2b6164, 0x2b6364, 0x2b6364, 0x2b6564, 0x2b6564, 0x2b6964,
+    0x2b6964, 0x2b6f64, 0x2b6f64, 0x2b7364, 0x2b7364, 0x2b7464, 0x2b7464,
+    0x2c2064, 0x2c2564, 0x2c2d64, 0x2c2e64, 0x2c2f64, 0x2c3364, 0x2c3464,
+    0x2c3564, 0x2c3664, 0x2c3764, 0x2c3864, 0x2c3964, 0x2c3d64, 0x2c4164,
+    0x2c5f64, 0x2c6264, 0x2c6464, 0x2c6664, 0x2c6764, 0x2c6864, 0x2c6c64,
+    0x2c6d64, 0x2c6e64, 0x2c7064, 0x2c7264, 0x2c7564, 0x160064, 0x160064,
+    0x160064, 0x160064, 0x160064, 0x160064, 0x160064, 0x160064, 0x160064,
+    0x160064, 0x160064, 0x160064, 0x160064, 0x160064, 0x160064, 0x160064,
+    0x160064, 0x160064, 0x2b3066, 0x2b3066, 0x2b3166, 0x2b3166, 0x2b3266,
+    0x2b3266, 0x2b6166, 0x2b6166, 0x2b6366, 0x2b6366, 0x2b6566, 0x2b6566,
+    0x2b6966, 0x2b6966, 0x2b6f66, 0x2b6f66, 0x2b7366, 0x2b7366, 0x2b7466,
+    0x2b7466, 0x2c2066, 0x2c2566, 0x2c2d66, 0x2c2e66, 0x2c2f66, 0x2c3366,
+    0x2c3466, 0x2c3566, 0x2c3666, 0x2c3766, 0x2c3866, 0x2c3966, 0x2c3d66,
+    0x2c4166, 0x2c5f66, 0x2c6266, 0x2c6466, 0x2c6666, 0x2c6766, 0x2c6866,
+    0x2c6c66, 0x2c6d66, 0x2c6e66, 0x2c7066, 0x2c7266, 0x2c7566, 0x160066,
+    0x160066, 0x160066, 0x160066, 0x160066, 0x160066, 0x160066, 0x160066,
+    0x160066, 0x160066, 0x160066, 0x160066, 0x160066, 0x160066, 0x160066,
+    0x160066, 0x160066, 0x160066, 0x2b3067, 0x2b3067, 0x2b3167, 0x2b3167,
+    0x2b3267, 0x2b3267, 0x2b6167, 0x2b6167, 0x2b6367, 0x2b6367, 0x2b6567,
+    0x2b6567, 0x2b6967, 0x2b6967, 0x2b6f67, 0x2b6f67, 0x2b7367, 0x2b7367,
+    0x2b7467, 0x2b7467, 0x2c2067, 0x2c2567, 0x2c2d67, 0x2c2e67, 0x2c2f67,
+    0x2c3367, 0x2c3467, 0x2c3567, 0x2c3667, 0x2c3767, 0x2c3867, 0x2c3967,
+    0x2c3d67, 0x2c4167, 0x2c5f67, 0x2c6267, 0x2c6467, 0x2c6667, 0x2c6767,
+    0x2c6867, 0x2c6c67, 0x2c6d67, 0x2c6e67, 0x2c7067, 0x2c7267, 0x2c7567,
+    0x160067, 0x160067, 0x160067, 0x160067, 0x160067, 0x160067, 0x160067,
+    0x160067, 0x160067, 0x160067, 0x160067, 0x160067, 0x160067, 0x160067,
+    0x160067, 0x160067, 0x160067, 0x160067, 0x2b3068, 0x2b3068, 0x2b3168,
+    0x2b3168, 0x2b3268, 0x2b3268, 0x2b6168, 0x2b6168, 0x2b6368, 0x2b6368,
+    0x2b6568, 0x2b6568, 0x2b6968, 0x2b6968, 0x2b6f68, 0x2b6f68, 0x2b7368,
+    0x2b7368, 0x2b7468, 0x2b7468, 0x2c2068, 0x2c2568, 0x2c2d68, 0x2c2e68,
+    0x2c2f68, 0x2c3368, 0x2c3468, 0x2c3568, 0x2c3668, 0x2c3768, 0x2c3868,
+    0x2c3968, 0x2c3d68, 0x2c4168, 0x2c5f68, 0x2c6268, 0x2c6468, 0x2c6668,
+    0x2c6768, 0x2c6868, 0x2c6c68, 0x2c6d68, 0x2c6e68, 0x2c7068, 0x2c7268,
+    0x2c7568, 0x160068, 0x160068, 0x160068, 0x160068, 0x160068, 0x160068,
+    0x160068, 0x160068, 0x160068, 0x160068, 0x160068, 0x160068, 0x160068,
+    0x160068, 0x160068, 0x160068, 0x160068, 0x160068, 0x2b306c, 0x2b306c,
+    0x2b316c, 0x2b316c, 0x2b326c, 0x2b326c, 0x2b616c, 0x2b616c, 0x2b636c,
+    0x2b636c, 0x2b656c, 0x2b656c, 0x2b696c, 0x2b696c, 0x2b6f6c, 0x2b6f6c,
+    0x2b736c, 0x2b736c, 0x2b746c, 0x2b746c, 0x2c206c, 0x2c256c, 0x2c2d6c,
+    0x2c2e6c, 0x2c2f6c, 0x2c336c, 0x2c346c, 0x2c356c, 0x2c366c, 0x2c376c,
+    0x2c386c, 0x2c396c, 0x2c3d6c, 0x2c416c, 0x2c5f6c, 0x2c626c, 0x2c646c,
+    0x2c666c, 0x2c676c, 0x2c686c, 0x2c6c6c, 0x2c6d6c, 0x2c6e6c, 0x2c706c,
+    0x2c726c, 0x2c756c, 0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c,
+    0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c,
+    0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x16006c, 0x2b306d,
+    0x2b306d, 0x2b316d, 0x2b316d, 0x2b326d, 0x2b326d, 0x2b616d, 0x2b616d,
+    0x2b636d, 0x2b636d, 0x2b656d, 0x2b656d, 0x2b696d, 0x2b696d, 0x2b6f6d,
+    0x2b6f6d, 0x2b736d, 0x2b736d, 0x2b746d, 0x2b746d, 0x2c206d, 0x2c256d,
+    0x2c2d6d, 0x2c2e6d, 0x2c2f6d, 0x2c336d, 0x2c346d, 0x2c356d, 0x2c366d,
+    0x2c376d, 0x2c386d, 0x2c396d, 0x2c3d6d, 0x2c416d, 0x2c5f6d, 0x2c626d,
+    0x2c646d, 0x2c666d, 0x2c676d, 0x2c686d, 0x2c6c6d, 0x2c6d6d, 0x2c6e6d,
+    0x2c706d, 0x2c726d, 0x2c756d, 0x16006d, 0x16006d, 0x16006d, 0x16006d,
+    0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d,
+    0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d, 0x16006d,
+    0x2b306e, 0x2b306e, 0x2b316e, 0x2b316e, 0x2b326e, 0x2b326e, 0x2b616e,
+    0x2b616e, 0x2b636e, 0x2b636e, 0x2b656e, 0x2b656e, 0x2b696e, 0x2b696e,
+    0x2b6f6e, 0x2b6f6e, 0x2b736e, 0x2b736e, 0x2b746e, 0x2b746e, 0x2c206e,
+    0x2c256e, 0x2c2d6e, 0x2c2e6e, 0x2c2f6e, 0x2c336e, 0x2c346e, 0x2c356e,
+    0x2c366e, 0x2c376e, 0x2c386e, 0x2c396e, 0x2c3d6e, 0x2c416e, 0x2c5f6e,
+    0x2c626e, 0x2c646e, 0x2c666e, 0x2c676e, 0x2c686e, 0x2c6c6e, 0x2c6d6e,
+    0x2c6e6e, 0x2c706e, 0x2c726e, 0x2c756e, 0x16006e, 0x16006e, 0x16006e,
+    0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e,
+    0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e, 0x16006e,
+    0x16006e, 0x2b3070, 0x2b3070, 0x2b3170, 0x2b3170, 0x2b3270, 0x2b3270,
+    0x2b6170, 0x2b6170, 0x2b6370, 0x2b6370, 0x2b6570, 0x2b6570, 0x2b6970,
+    0x2b6970, 0x2b6f70, 0x2b6f70, 0x2b7370, 0x2b7370, 0x2b7470, 0x2b7470,
+    0x2c2070, 0x2c2570, 0x2c2d70, 0x2c2e70, 0x2c2f70, 0x2c3370, 0x2c3470,
+    0x2c3570, 0x2c3670, 0x2c3770, 0x2c3870, 0x2c3970, 0x2c3d70, 0x2c4170,
+    0x2c5f70, 0x2c6270, 0x2c6470, 0x2c6670, 0x2c6770, 0x2c6870, 0x2c6c70,
+    0x2c6d70, 0x2c6e70, 0x2c7070, 0x2c7270, 0x2c7570, 0x160070, 0x160070,
+    0x160070, 0x160070, 0x160070, 0x160070, 0x160070, 0x160070, 0x160070,
+    0x160070, 0x160070, 0x160070, 0x160070, 0x160070, 0x160070, 0x160070,
+    0x160070, 0x160070, 0x2b3072, 0x2b3072, 0x2b3172, 0x2b3172, 0x2b3272,
+    0x2b3272, 0x2b6172, 0x2b6172, 0x2b6372, 0x2b6372, 0x2b6572, 0x2b6572,
+    0x2b6972, 0x2b6972, 0x2b6f72, 0x2b6f72, 0x2b7372, 0x2b7372, 0x2b7472,
+    0x2b7472, 0x2c2072, 0x2c2572, 0x2c2d72, 0x2c2e72, 0x2c2f72, 0x2c3372,
+    0x2c3472, 0x2c3572, 0x2c3672, 0x2c3772, 0x2c3872, 0x2c3972, 0x2c3d72,
+    0x2c4172, 0x2c5f72, 0x2c6272, 0x2c6472, 0x2c6672, 0x2c6772, 0x2c6872,
+    0x2c6c72, 0x2c6d72, 0x2c6e72, 0x2c7072, 0x2c7272, 0x2c7572, 0x160072,
+    0x160072, 0x160072, 0x160072, 0x160072, 0x160072, 0x160072, 0x160072,
+    0x160072, 0x160072, 0x160072, 0x160072, 0x160072, 0x160072, 0x160072,
+    0x160072, 0x160072, 0x160072, 0x2b3075, 0x2b3075, 0x2b3175, 0x2b3175,
+    0x2b3275, 0x2b3275, 0x2b6175, 0x2b6175, 0x2b6375, 0x2b6375, 0x2b6575,
+    0x2b6575, 0x2b6975, 0x2b6975, 0x2b6f75, 0x2b6f75, 0x2b7375, 0x2b7375,
+    0x2b7475, 0x2b7475, 0x2c2075, 0x2c2575, 0x2c2d75, 0x2c2e75, 0x2c2f75,
+    0x2c3375, 0x2c3475, 0x2c3575, 0x2c3675, 0x2c3775, 0x2c3875, 0x2c3975,
+    0x2c3d75, 0x2c4175, 0x2c5f75, 0x2c6275, 0x2c6475, 0x2c6675, 0x2c6775,
+    0x2c6875, 0x2c6c75, 0x2c6d75, 0x2c6e75, 0x2c7075, 0x2c7275, 0x2c7575,
+    0x160075, 0x160075, 0x160075, 0x160075, 0x160075, 0x160075, 0x160075,
+    0x160075, 0x160075, 0x160075, 0x160075, 0x160075, 0x160075, 0x160075,
+    0x160075, 0x160075, 0x160075, 0x160075, 0x2c303a, 0x2c313a, 0x2c323a,
+    0x2c613a, 0x2c633a, 0x2c653a, 0x2c693a, 0x2c6f3a, 0x2c733a, 0x2c743a,
+    0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a,
+    0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a,
+    0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a, 0x17003a,
+    0x17003a, 0x2c3042, 0x2c3142, 0x2c3242, 0x2c6142, 0x2c6342, 0x2c6542,
+    0x2c6942, 0x2c6f42, 0x2c7342, 0x2c7442, 0x170042, 0x170042, 0x170042,
+    0x170042, 0x170042, 0x170042, 0x170042, 0x170042, 0x170042, 0x170042,
+    0x170042, 0x170042, 0x170042, 0x170042, 0x170042, 0x170042, 0x170042,
+    0x170042, 0x170042, 0x170042, 0x170042, 0x170042, 0x2c3043, 0x2c3143,
+    0x2c3243, 0x2c6143, 0x2c6343, 0x2c6543, 0x2c6943, 0x2c6f43, 0x2c7343,
+    0x2c7443, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043,
+    0x170043, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043,
+    0x170043, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043, 0x170043,
+    0x170043, 0x170043, 0x2c3044, 0x2c3144, 0x2c3244, 0x2c6144, 0x2c6344,
+    0x2c6544, 0x2c6944, 0x2c6f44, 0x2c7344, 0x2c7444, 0x170044, 0x170044,
+    0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x170044,
+    0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x170044,
+    0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x170044, 0x2c3045,
+    0x2c3145, 0x2c3245, 0x2c6145, 0x2c6345, 0x2c6545, 0x2c6945, 0x2c6f45,
+    0x2c7345, 0x2c7445, 0x170045, 0x170045, 0x170045, 0x170045, 0x170045,
+    0x170045, 0x170045, 0x170045, 0x170045, 0x170045, 0x170045, 0x170045,
+    0x170045, 0x170045, 0x170045, 0x170045, 0x170045, 0x170045, 0x170045,
+    0x170045, 0x170045, 0x170045, 0x2c3046, 0x2c3146, 0x2c3246, 0x2c6146,
+    0x2c6346, 0x2c6546, 0x2c6946, 0x2c6f46, 0x2c7346, 0x2c7446, 0x170046,
+    0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046,
+    0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046,
+    0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046, 0x170046,
+    0x2c3047, 0x2c3147, 0x2c3247, 0x2c6147, 0x2c6347, 0x2c6547, 0x2c6947,
+    0x2c6f47, 0x2c7347, 0x2c7447, 0x170047, 0x170047, 0x170047, 0x170047,
+    0x170047, 0x170047, 0x170047, 0x170047, 0x170047, 0x170047, 0x170047,
+    0x170047, 0x170047, 0x170047, 0x170047, 0x170047, 0x170047, 0x170047,
+    0x170047, 0x170047, 0x170047, 0x170047, 0x2c3048, 0x2c3148, 0x2c3248,
+    0x2c6148, 0x2c6348, 0x2c6548, 0x2c6948, 0x2c6f48, 0x2c7348, 0x2c7448,
+    0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048,
+    0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048,
+    0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048, 0x170048,
+    0x170048, 0x2c3049, 0x2c3149, 0x2c3249, 0x2c6149, 0x2c6349, 0x2c6549,
+    0x2c6949, 0x2c6f49, 0x2c7349, 0x2c7449, 0x170049, 0x170049, 0x170049,
+    0x170049, 0x170049, 0x170049, 0x170049, 0x170049, 0x170049, 0x170049,
+    0x170049, 0x170049, 0x170049, 0x170049, 0x170049, 0x170049, 0x170049,
+    0x170049, 0x170049, 0x170049, 0x170049, 0x170049, 0x2c304a, 0x2c314a,
+    0x2c324a, 0x2c614a, 0x2c634a, 0x2c654a, 0x2c694a, 0x2c6f4a, 0x2c734a,
+    0x2c744a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a,
+    0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a,
+    0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a, 0x17004a,
+    0x17004a, 0x17004a, 0x2c304b, 0x2c314b, 0x2c324b, 0x2c614b, 0x2c634b,
+    0x2c654b, 0x2c694b, 0x2c6f4b, 0x2c734b, 0x2c744b, 0x17004b, 0x17004b,
+    0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b,
+    0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b,
+    0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x17004b, 0x2c304c,
+    0x2c314c, 0x2c324c, 0x2c614c, 0x2c634c, 0x2c654c, 0x2c694c, 0x2c6f4c,
+    0x2c734c, 0x2c744c, 0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c,
+    0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c,
+    0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c, 0x17004c,
+    0x17004c, 0x17004c, 0x17004c, 0x2c304d, 0x2c314d, 0x2c324d, 0x2c614d,
+    0x2c634d, 0x2c654d, 0x2c694d, 0x2c6f4d, 0x2c734d, 0x2c744d, 0x17004d,
+    0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d,
+    0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d,
+    0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d, 0x17004d,
+    0x2c304e, 0x2c314e, 0x2c324e, 0x2c614e, 0x2c634e, 0x2c654e, 0x2c694e,
+    0x2c6f4e, 0x2c734e, 0x2c744e, 0x17004e, 0x17004e, 0x17004e, 0x17004e,
+    0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e,
+    0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x17004e,
+    0x17004e, 0x17004e, 0x17004e, 0x17004e, 0x2c304f, 0x2c314f, 0x2c324f,
+    0x2c614f, 0x2c634f, 0x2c654f, 0x2c694f, 0x2c6f4f, 0x2c734f, 0x2c744f,
+    0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f,
+    0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f,
+    0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f, 0x17004f,
+    0x17004f, 0x2c3050, 0x2c3150, 0x2c3250, 0x2c6150, 0x2c6350, 0x2c6550,
+    0x2c6950, 0x2c6f50, 0x2c7350, 0x2c7450, 0x170050, 0x170050, 0x170050,
+    0x170050, 0x170050, 0x170050, 0x170050, 0x170050, 0x170050, 0x170050,
+    0x170050, 0x170050, 0x170050, 0x170050, 0x170050, 0x170050, 0x170050,
+    0x170050, 0x170050, 0x170050, 0x170050, 0x170050, 0x2c3051, 0x2c3151,
+    0x2c3251, 0x2c6151, 0x2c6351, 0x2c6551, 0x2c6951, 0x2c6f51, 0x2c7351,
+    0x2c7451, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051,
+    0x170051, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051,
+    0x170051, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051, 0x170051,
+    0x170051, 0x170051, 0x2c3052, 0x2c3152, 0x2c3252, 0x2c6152, 0x2c6352,
+    0x2c6552, 0x2c6952, 0x2c6f52, 0x2c7352, 0x2c7452, 0x170052, 0x170052,
+    0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x170052,
+    0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x170052,
+    0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x170052, 0x2c3053,
+    0x2c3153, 0x2c3253, 0x2c6153, 0x2c6353, 0x2c6553, 0x2c6953, 0x2c6f53,
+    0x2c7353, 0x2c7453, 0x170053, 0x170053, 0x170053, 0x170053, 0x170053,
+    0x170053, 0x170053, 0x170053, 0x170053, 0x170053, 0x170053, 0x170053,
+    0x170053, 0x170053, 0x170053, 0x170053, 0x170053, 0x170053, 0x170053,
+    0x170053, 0x170053, 0x170053, 0x2c3054, 0x2c3154, 0x2c3254, 0x2c6154,
+    0x2c6354, 0x2c6554, 0x2c6954, 0x2c6f54, 0x2c7354, 0x2c7454, 0x170054,
+    0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054,
+    0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054,
+    0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054, 0x170054,
+    0x2c3055, 0x2c3155, 0x2c3255, 0x2c6155, 0x2c6355, 0x2c6555, 0x2c6955,
+    0x2c6f55, 0x2c7355, 0x2c7455, 0x170055, 0x170055, 0x170055, 0x170055,
+    0x170055, 0x170055, 0x170055, 0x170055, 0x170055, 0x170055, 0x170055,
+    0x170055, 0x170055, 0x170055, 0x170055, 0x170055, 0x170055, 0x170055,
+    0x170055, 0x170055, 0x170055, 0x170055, 0x2c3056, 0x2c3156, 0x2c3256,
+    0x2c6156, 0x2c6356, 0x2c6556, 0x2c6956, 0x2c6f56, 0x2c7356, 0x2c7456,
+    0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056,
+    0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056,
+    0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056, 0x170056,
+    0x170056, 0x2c3057, 0x2c3157, 0x2c3257, 0x2c6157, 0x2c6357, 0x2c6557,
+    0x2c6957, 0x2c6f57, 0x2c7357, 0x2c7457, 0x170057, 0x170057, 0x170057,
+    0x170057, 0x170057, 0x170057, 0x170057, 0x170057, 0x170057, 0x170057,
+    0x170057, 0x170057, 0x170057, 0x170057, 0x170057, 0x170057, 0x170057,
+    0x170057, 0x170057, 0x170057, 0x170057, 0x170057, 0x2c3059, 0x2c3159,
+    0x2c3259, 0x2c6159, 0x2c6359, 0x2c6559, 0x2c6959, 0x2c6f59, 0x2c7359,
+    0x2c7459, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059,
+    0x170059, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059,
+    0x170059, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059, 0x170059,
+    0x170059, 0x170059, 0x2c306a, 0x2c316a, 0x2c326a, 0x2c616a, 0x2c636a,
+    0x2c656a, 0x2c696a, 0x2c6f6a, 0x2c736a, 0x2c746a, 0x17006a, 0x17006a,
+    0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a,
+    0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a,
+    0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x17006a, 0x2c306b,
+    0x2c316b, 0x2c326b, 0x2c616b, 0x2c636b, 0x2c656b, 0x2c696b, 0x2c6f6b,
+    0x2c736b, 0x2c746b, 0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b,
+    0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b,
+    0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b, 0x17006b,
+    0x17006b, 0x17006b, 0x17006b, 0x2c3071, 0x2c3171, 0x2c3271, 0x2c6171,
+    0x2c6371, 0x2c6571, 0x2c6971, 0x2c6f71, 0x2c7371, 0x2c7471, 0x170071,
+    0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071,
+    0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071,
+    0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071, 0x170071,
+    0x2c3076, 0x2c3176, 0x2c3276, 0x2c6176, 0x2c6376, 0x2c6576, 0x2c6976,
+    0x2c6f76, 0x2c7376, 0x2c7476, 0x170076, 0x170076, 0x170076, 0x170076,
+    0x170076, 0x170076, 0x170076, 0x170076, 0x170076, 0x170076, 0x170076,
+    0x170076, 0x170076, 0x170076, 0x170076, 0x170076, 0x170076, 0x170076,
+    0x170076, 0x170076, 0x170076, 0x170076, 0x2c3077, 0x2c3177, 0x2c3277,
+    0x2c6177, 0x2c6377, 0x2c6577, 0x2c6977, 0x2c6f77, 0x2c7377, 0x2c7477,
+    0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077,
+    0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077,
+    0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077, 0x170077,
+    0x170077, 0x2c3078, 0x2c3178, 0x2c3278, 0x2c6178, 0x2c6378, 0x2c6578,
+    0x2c6978, 0x2c6f78, 0x2c7378, 0x2c7478, 0x170078, 0x170078, 0x170078,
+    0x170078, 0x170078, 0x170078, 0x170078, 0x170078, 0x170078, 0x170078,
+    0x170078, 0x170078, 0x170078, 0x170078, 0x170078, 0x170078, 0x170078,
+    0x170078, 0x170078, 0x170078, 0x170078, 0x170078, 0x2c3079, 0x2c3179,
+    0x2c3279, 0x2c6179, 0x2c6379, 0x2c6579, 0x2c6979, 0x2c6f79, 0x2c7379,
+    0x2c7479, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079,
+    0x170079, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079,
+    0x170079, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079, 0x170079,
+    0x170079, 0x170079, 0x2c307a, 0x2c317a, 0x2c327a, 0x2c617a, 0x2c637a,
+    0x2c657a, 0x2c697a, 0x2c6f7a, 0x2c737a, 0x2c747a, 0x17007a, 0x17007a,
+    0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a,
+    0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a,
+    0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x17007a, 0x180026,
+    0x180026, 0x180026, 0x180026, 0x180026, 0x180026, 0x180026, 0x180026,
+    0x180026, 0x180026, 0x180026, 0x180026, 0x180026, 0x180026, 0x180026,
+    0x180026, 0x18002a, 0x18002a, 0x18002a, 0x18002a, 0x18002a, 0x18002a,
+    0x18002a, 0x18002a, 0x18002a, 0x18002a, 0x18002a, 0x18002a, 0x18002a,
+    0x18002a, 0x18002a, 0x18002a, 0x18002c, 0x18002c, 0x18002c, 0x18002c,
+    0x18002c, 0x18002c, 0x18002c, 0x18002c, 0x18002c, 0x18002c, 0x18002c,
+    0x18002c, 0x18002c, 0x18002c, 0x18002c, 0x18002c, 0x18003b, 0x18003b,
+    0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b,
+    0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b, 0x18003b,
+    0x180058, 0x180058, 0x180058, 0x180058, 0x180058, 0x180058, 0x180058,
+    0x180058, 0x180058, 0x180058, 0x180058, 0x180058, 0x180058, 0x180058,
+    0x180058, 0x180058, 0x18005a, 0x18005a, 0x18005a, 0x18005a, 0x18005a,
+    0x18005a, 0x18005a, 0x18005a, 0x18005a, 0x18005a, 0x18005a, 0x18005a,
+    0x18005a, 0x18005a, 0x18005a, 0x18005a, 0x1a0021, 0x1a0021, 0x1a0021,
+    0x1a0021, 0x1a0022, 0x1a0022, 0x1a0022, 0x1a0022, 0x1a0028, 0x1a0028,
+    0x1a0028, 0x1a0028, 0x1a0029, 0x1a0029, 0x1a0029, 0x1a0029, 0x1a003f,
+    0x1a003f, 0x1a003f, 0x1a003f, 0x1b0027, 0x1b0027, 0x1b002b, 0x1b002b,
+    0x1b007c, 0x1b007c, 0x1c0023, 0x1c003e, 0x0,      0x0,      0x0,
+    0x0, };
+/* the code is canonical: the codes of each length are consecutive, so a code
+   of length l decodes to
+   huff_syms_by_code[huff_len_offset[l] + code - huff_len_first_code[l]]
+   provided code - huff_len_first_code[l] < huff_len_count[l] */
+static const gpr_uint8 huff_len_count[31] = {
+    0,  0,  0,  0,  0,  10, 26, 32, 6,  0,  5,  3,  2,  6,  2,  3,  0,  0,  0,
+    3,  8,  13, 26, 29, 12, 4,  15, 19, 29, 0,  4, };
+static const gpr_uint32 huff_len_first_code[31] = {
+    0x0,        0x0,        0x0,        0x0,        0x0,        0x0,
+    0x14,       0x5c,       0xf8,       0x0,        0x3f8,      0x7fa,
+    0xffa,      0x1ff8,     0x3ffc,     0x7ffc,     0x0,        0x0,
+    0x0,        0x7fff0,    0xfffe6,    0x1fffdc,   0x3fffd2,   0x7fffd8,
+    0xffffea,   0x1ffffec,  0x3ffffe0,  0x7ffffde,  0xfffffe2,  0x0,
+    0x3ffffffc, };
+static const gpr_uint16 huff_len_offset[31] = {
+    0,   0,   0,   0,   0,   0,   10,  36,  68,  0,   74,  79,  82,  84,  90,
+    92,  0,   0,   0,   95,  98,  106, 119, 145, 174, 186, 190, 205, 224, 0,
+    253, };
+static const gpr_uint16 huff_syms_by_code[257] = {
+    48,  49,  50,  97,  99,  101, 105, 111, 115, 116, 32,  37,  45,  46,  47,
+    51,  52,  53,  54,  55,  56,  57,  61,  65,  95,  98,  100, 102, 103, 104,
+    108, 109, 110, 112, 114, 117, 58,  66,  67,  68,  69,  70,  71,  72,  73,
+    74,  75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  89,
+    106, 107, 113, 118, 119, 120, 121, 122, 38,  42,  44,  59,  88,  90,  33,
+    34,  40,  41,  63,  39,  43,  124, 35,  62,  0,   36,  64,  91,  93,  126,
+    94,  125, 60,  96,  123, 92,  195, 208, 128, 130, 131, 162, 184, 194, 224,
+    226, 153, 161, 167, 172, 176, 177, 179, 209, 216, 217, 227, 229, 230, 129,
+    132, 133, 134, 136, 146, 154, 156, 160, 163, 164, 169, 170, 173, 178, 181,
+    185, 186, 187, 189, 190, 196, 198, 228, 232, 233, 1,   135, 137, 138, 139,
+    140, 141, 143, 147, 149, 150, 151, 152, 155, 157, 158, 165, 166, 168, 174,
+    175, 180, 182, 183, 188, 191, 197, 231, 239, 9,   142, 144, 145, 148, 159,
+    171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193, 200, 201, 202,
+    205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211, 212, 214,
+    221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254, 2,
+    3,   4,   5,   6,   7,   8,   11,  12,  14,  15,  16,  17,  18,  19,  20,
+    21,  23,  24,  25,  26,  27,  28,  29,  30,  31,  127, 220, 249, 10,  13,
+    22,  256, };
 
 static const gpr_uint8 inverse_base64[256] = {
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
@@ -627,6 +895,41 @@ static grpc_mdstr *take_string(grpc_chttp2_hpack_parser *p,
   return s;
 }
 
+/* is key one whose values are compared by identity elsewhere in the stack
+   (and so must be interned)? */
+static int is_reserved_key(grpc_mdstr *key) {
+  const char *k = (const char *)GPR_SLICE_START_PTR(key->slice);
+  size_t len = GPR_SLICE_LENGTH(key->slice);
+  if (len > 0 && k[0] == ':') return 1;
+  if (len >= 5 && 0 == memcmp(k, "grpc-", 5)) return 1;
+  if (len == 2 && 0 == memcmp(k, "te", 2)) return 1;
+  if (len == 12 && 0 == memcmp(k, "content-type", 12)) return 1;
+  return 0;
+}
+
+/* build an element from key (taking ownership) and the parsed value: values
+   of keys configured as high cardinality, and values the peer asked never to
+   be indexed, skip interning unless the key is reserved */
+static grpc_mdelem *take_header(grpc_chttp2_hpack_parser *p, grpc_mdstr *key,
+                                int never_indexed) {
+  size_t i;
+  int intern = !never_indexed;
+  grpc_mdelem *md;
+  for (i = 0; intern && i < p->uninterned_key_count; i++) {
+    if (p->uninterned_keys[i] == key) intern = 0;
+  }
+  if (!intern && is_reserved_key(key)) intern = 1;
+  if (intern) {
+    return grpc_mdelem_from_metadata_strings(p->table.mdctx, key,
+                                             take_string(p, &p->value));
+  }
+  md = grpc_mdelem_from_uninterned_value(p->table.mdctx, key,
+                                         (gpr_uint8 *)p->value.str,
+                                         p->value.length);
+  p->value.length = 0;
+  return md;
+}
+
 /* jump to the next state */
 static int parse_next(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
                       const gpr_uint8 *end) {
@@ -783,20 +1086,14 @@ static int parse_lithdr_incidx_v(grpc_chttp2_hpack_parser *p,
 static int finish_lithdr_notidx(grpc_chttp2_hpack_parser *p,
                                 const gpr_uint8 *cur, const gpr_uint8 *end) {
   grpc_mdelem *md = grpc_chttp2_hptbl_lookup(&p->table, p->index);
-  on_hdr(p, grpc_mdelem_from_metadata_strings(p->table.mdctx,
-                                              grpc_mdstr_ref(md->key),
-                                              take_string(p, &p->value)),
-         0);
+  on_hdr(p, take_header(p, grpc_mdstr_ref(md->key), 0), 0);
   return parse_begin(p, cur, end);
 }
 
 /* finish a literal header without incremental indexing with index = 0 */
 static int finish_lithdr_notidx_v(grpc_chttp2_hpack_parser *p,
                                   const gpr_uint8 *cur, const gpr_uint8 *end) {
-  on_hdr(p, grpc_mdelem_from_metadata_strings(p->table.mdctx,
-                                              take_string(p, &p->key),
-                                              take_string(p, &p->value)),
-         0);
+  on_hdr(p, take_header(p, take_string(p, &p->key), 0), 0);
   return parse_begin(p, cur, end);
 }
 
@@ -836,20 +1133,14 @@ static int parse_lithdr_notidx_v(grpc_chttp2_hpack_parser *p,
 static int finish_lithdr_nvridx(grpc_chttp2_hpack_parser *p,
                                 const gpr_uint8 *cur, const gpr_uint8 *end) {
   grpc_mdelem *md = grpc_chttp2_hptbl_lookup(&p->table, p->index);
-  on_hdr(p, grpc_mdelem_from_metadata_strings(p->table.mdctx,
-                                              grpc_mdstr_ref(md->key),
-                                              take_string(p, &p->value)),
-         0);
+  on_hdr(p, take_header(p, grpc_mdstr_ref(md->key), 1), 0);
   return parse_begin(p, cur, end);
 }
 
 /* finish a literal header that is never indexed with an extra value */
 static int finish_lithdr_nvridx_v(grpc_chttp2_hpack_parser *p,
                                   const gpr_uint8 *cur, const gpr_uint8 *end) {
-  on_hdr(p, grpc_mdelem_from_metadata_strings(p->table.mdctx,
-                                              take_string(p, &p->key),
-                                              take_string(p, &p->value)),
-         0);
+  on_hdr(p, take_header(p, take_string(p, &p->key), 1), 0);
   return parse_begin(p, cur, end);
 }
 
@@ -1073,12 +1364,19 @@ static int parse_string_prefix(grpc_chttp2_hpack_parser *p,
 }
 
 /* append some bytes to a string */
-static void append_bytes(grpc_chttp2_hpack_parser_string *str,
-                         const gpr_uint8 *data, size_t length) {
+/* make room for length more bytes in str: grows geometrically, as strings
+   are often built up a chunk at a time */
+static void reserve_bytes(grpc_chttp2_hpack_parser_string *str,
+                          size_t length) {
   if (length + str->length > str->capacity) {
-    str->capacity = str->length + length;
+    str->capacity = GPR_MAX(str->length + length, 2 * str->capacity);
     str->str = gpr_realloc(str->str, str->capacity);
   }
+}
+
+static void append_bytes(grpc_chttp2_hpack_parser_string *str,
+                         const gpr_uint8 *data, size_t length) {
+  reserve_bytes(str, length);
   memcpy(str->str + str->length, data, length);
   str->length += length;
 }
@@ -1088,12 +1386,22 @@ static int append_string(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
   grpc_chttp2_hpack_parser_string *str = p->parsing.str;
   gpr_uint32 bits;
   gpr_uint8 decoded[3];
+  size_t consumed;
   switch ((binary_state)p->binary) {
     case NOT_BINARY:
       append_bytes(str, cur, end - cur);
       return 1;
     b64_byte0:
     case B64_BYTE0:
+      /* decode whole groups in bulk; padding, partial groups and errors are
+         left to the character at a time path below */
+      if (end - cur >= 4) {
+        reserve_bytes(str, (end - cur) / 4 * 3);
+        consumed = grpc_chttp2_base64_decode_groups(
+            cur, end - cur, (gpr_uint8 *)str->str + str->length);
+        str->length += consumed / 4 * 3;
+        cur += consumed;
+      }
       if (cur == end) {
         p->binary = B64_BYTE0;
         return 1;
@@ -1159,12 +1467,102 @@ static int append_string(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
   return 1;
 }
 
+/* decode one symbol from the low nbits bits of bits, for codes too long for
+   huff_fast_tbl and for the tail of a string: returns the symbol (256 being
+   end of stream) and stores its length in *length, or returns -1 if no code
+   is complete within those bits */
+static int huff_decode_slow(gpr_uint64 bits, gpr_uint32 nbits,
+                            gpr_uint32 *length) {
+  gpr_uint32 l;
+  gpr_uint32 code;
+  for (l = 1; l <= nbits && l <= HUFF_MAX_BITS; l++) {
+    code = (gpr_uint32)(bits >> (nbits - l)) & ((1u << l) - 1);
+    if (code - huff_len_first_code[l] < huff_len_count[l]) {
+      *length = l;
+      return huff_syms_by_code[huff_len_offset[l] + code -
+                               huff_len_first_code[l]];
+    }
+  }
+  return -1;
+}
+
+/* decode full bytes from a huffman encoded stream: input is buffered into a
+   bit accumulator, and each lookup in huff_fast_tbl decodes up to two symbols
+   at once; decoded bytes are batched up before being appended */
+static int add_huff_bytes(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
+                          const gpr_uint8 *end) {
+  gpr_uint8 out[256];
+  size_t nout = 0;
+  gpr_uint64 bits = p->huff_bits;
+  gpr_uint32 nbits = p->huff_nbits;
+  gpr_uint32 entry;
+  gpr_uint32 length;
+  int sym;
+
+  for (;;) {
+    while (nbits <= 56 && cur != end) {
+      bits = (bits << 8) | *cur++;
+      nbits += 8;
+    }
+    if (nbits < HUFF_FAST_BITS) break;
+    entry = huff_fast_tbl[(bits >> (nbits - HUFF_FAST_BITS)) &
+                          ((1 << HUFF_FAST_BITS) - 1)];
+    switch (entry >> 20) {
+      case 2:
+        out[nout++] = (gpr_uint8)entry;
+        out[nout++] = (gpr_uint8)(entry >> 8);
+        nbits -= (entry >> 16) & 0xf;
+        break;
+      case 1:
+        out[nout++] = (gpr_uint8)entry;
+        nbits -= (entry >> 16) & 0xf;
+        break;
+      default:
+        /* a long code: we always have enough bits buffered to finish it
+           unless we are out of input */
+        sym = huff_decode_slow(bits, nbits, &length);
+        if (sym == -1) goto done;
+        if (sym != 256) out[nout++] = (gpr_uint8)sym;
+        nbits -= length;
+        break;
+    }
+    if (nout > sizeof(out) - 2) {
+      if (!append_string(p, out, out + nout)) return 0;
+      nout = 0;
+    }
+  }
+
+done:
+  assert(nbits < 32);
+  p->huff_bits = (gpr_uint32)bits;
+  p->huff_nbits = (gpr_uint8)nbits;
+  return append_string(p, out, out + nout);
+}
+
+/* decode whatever symbols are complete in the bits left over at the end of a
+   huffman encoded string: anything after them is padding */
+static int finish_huff_bytes(grpc_chttp2_hpack_parser *p) {
+  gpr_uint8 out[HUFF_MAX_BITS];
+  size_t nout = 0;
+  gpr_uint32 nbits = p->huff_nbits;
+  gpr_uint32 length;
+  int sym;
+
+  while ((sym = huff_decode_slow(p->huff_bits, nbits, &length)) != -1) {
+    if (sym != 256) out[nout++] = (gpr_uint8)sym;
+    nbits -= length;
+  }
+  p->huff_nbits = 0;
+  return append_string(p, out, out + nout);
+}
+
 /* append a null terminator to a string */
 static int finish_str(grpc_chttp2_hpack_parser *p) {
   gpr_uint8 terminator = 0;
   gpr_uint8 decoded[2];
   gpr_uint32 bits;
   grpc_chttp2_hpack_parser_string *str = p->parsing.str;
+  if (p->huff && !finish_huff_bytes(p)) return 0;
   switch ((binary_state)p->binary) {
     case NOT_BINARY:
       break;
@@ -1200,31 +1598,6 @@ static int finish_str(grpc_chttp2_hpack_parser *p) {
   return 1;
 }
 
-/* decode a nibble from a huffman encoded stream */
-static int huff_nibble(grpc_chttp2_hpack_parser *p, gpr_uint8 nibble) {
-  gpr_int16 emit = emit_sub_tbl[16 * emit_tbl[p->huff_state] + nibble];
-  gpr_int16 next = next_sub_tbl[16 * next_tbl[p->huff_state] + nibble];
-  if (emit != -1) {
-    if (emit >= 0 && emit < 256) {
-      gpr_uint8 c = (gpr_uint8)emit;
-      if (!append_string(p, &c, (&c) + 1)) return 0;
-    } else {
-      assert(emit == 256);
-    }
-  }
-  p->huff_state = next;
-  return 1;
-}
-
-/* decode full bytes from a huffman encoded stream */
-static int add_huff_bytes(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
-                          const gpr_uint8 *end) {
-  for (; cur != end; ++cur) {
-    if (!huff_nibble(p, *cur >> 4) || !huff_nibble(p, *cur & 0xf)) return 0;
-  }
-  return 1;
-}
-
 /* decode some string bytes based on the current decoding mode
    (huffman or not) */
 static int add_str_bytes(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
@@ -1259,7 +1632,8 @@ static int begin_parse_string(grpc_chttp2_hpack_parser *p, const gpr_uint8 *cur,
   p->strgot = 0;
   str->length = 0;
   p->parsing.str = str;
-  p->huff_state = 0;
+  p->huff_bits = 0;
+  p->huff_nbits = 0;
   p->binary = binary;
   return parse_string(p, cur, end);
 }
@@ -1345,15 +1719,30 @@ void grpc_chttp2_hpack_parser_init(grpc_chttp2_hpack_parser *p,
   p->value.str = NULL;
   p->value.capacity = 0;
   p->value.length = 0;
+  p->uninterned_keys = NULL;
+  p->uninterned_key_count = 0;
   grpc_chttp2_hptbl_init(&p->table, mdctx);
 }
 
+void grpc_chttp2_hpack_parser_add_uninterned_key(grpc_chttp2_hpack_parser *p,
+                                                 grpc_mdstr *key) {
+  p->uninterned_keys =
+      gpr_realloc(p->uninterned_keys,
+                  sizeof(grpc_mdstr *) * (p->uninterned_key_count + 1));
+  p->uninterned_keys[p->uninterned_key_count++] = key;
+}
+
 void grpc_chttp2_hpack_parser_set_has_priority(grpc_chttp2_hpack_parser *p) {
   GPR_ASSERT(p->state == parse_begin);
   p->state = parse_stream_dep0;
 }
 
 void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser *p) {
+  size_t i;
+  for (i = 0; i < p->uninterned_key_count; i++) {
+    grpc_mdstr_unref(p->uninterned_keys[i]);
+  }
+  gpr_free(p->uninterned_keys);
   grpc_chttp2_hptbl_destroy(&p->table);
   gpr_free(p->key.str);
   gpr_free(p->value.str);
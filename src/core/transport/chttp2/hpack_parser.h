@@ -76,8 +76,10 @@ struct grpc_chttp2_hpack_parser {
   gpr_uint32 strlen;
   /* number of source bytes read for the currently parsing string */
   gpr_uint32 strgot;
-  /* huffman decoding state */
-  gpr_uint16 huff_state;
+  /* huffman decoding state: input bits not yet decoded (the low huff_nbits
+     bits of huff_bits) */
+  gpr_uint32 huff_bits;
+  gpr_uint8 huff_nbits;
   /* is the string being decoded binary? */
   gpr_uint8 binary;
   /* is the current string huffman encoded? */
@@ -88,6 +90,11 @@ struct grpc_chttp2_hpack_parser {
   gpr_uint8 is_eof;
   gpr_uint32 base64_buffer;
 
+  /* keys whose values are not interned (see
+     grpc_chttp2_hpack_parser_add_uninterned_key) */
+  grpc_mdstr **uninterned_keys;
+  size_t uninterned_key_count;
+
   /* hpack table */
   grpc_chttp2_hptbl table;
 };
@@ -98,6 +105,14 @@ void grpc_chttp2_hpack_parser_destroy(grpc_chttp2_hpack_parser *p);
 
 void grpc_chttp2_hpack_parser_set_has_priority(grpc_chttp2_hpack_parser *p);
 
+/* Values of key, unless sent with incremental indexing, are not interned
+   (see grpc_mdelem_from_uninterned_value). Values sent as never indexed are
+   not interned regardless of key. Keys compared by identity elsewhere
+   (pseudo-headers, grpc-*, te, content-type) are always interned. Takes
+   ownership of key. */
+void grpc_chttp2_hpack_parser_add_uninterned_key(grpc_chttp2_hpack_parser *p,
+                                                 grpc_mdstr *key);
+
 /* returns 1 on success, 0 on error */
 int grpc_chttp2_hpack_parser_parse(grpc_chttp2_hpack_parser *p,
                                    const gpr_uint8 *beg, const gpr_uint8 *end);
@@ -68,6 +68,8 @@ typedef struct {
   gpr_uint8 last_was_header;
   /* output stream id */
   gpr_uint32 stream_id;
+  /* largest frame payload the peer accepts */
+  gpr_uint32 max_frame_size;
   gpr_slice_buffer *output;
 } framer_state;
 
@@ -129,7 +131,7 @@ static void ensure_frame_type(framer_state *st, frame_type type,
                               int need_bytes) {
   if (st->cur_frame_type == type &&
       st->output->length - st->output_length_at_start_of_frame + need_bytes <=
-          GRPC_CHTTP2_MAX_PAYLOAD_LENGTH) {
+          st->max_frame_size) {
     return;
   }
   finish_frame(st, type != HEADER, 0);
@@ -156,8 +158,8 @@ static void add_header_data(framer_state *st, gpr_slice slice) {
   size_t remaining;
   if (len == 0) return;
   ensure_frame_type(st, HEADER, 1);
-  remaining = GRPC_CHTTP2_MAX_PAYLOAD_LENGTH +
-              st->output_length_at_start_of_frame - st->output->length;
+  remaining = st->max_frame_size + st->output_length_at_start_of_frame -
+              st->output->length;
   if (len <= remaining) {
     gpr_slice_buffer_add(st->output, slice);
   } else {
@@ -356,8 +358,13 @@ static void hpack_enc(grpc_chttp2_hpack_compressor *c, grpc_mdelem *elem,
   size_t decoder_space_usage;
   gpr_uint32 indices_key;
   int should_add_elem;
+  /* non-interned elements are unique: never worth a table entry */
+  int interned = grpc_mdelem_is_interned(elem);
 
-  inc_filter(HASH_FRAGMENT_1(elem_hash), &c->filter_elems_sum, c->filter_elems);
+  if (interned) {
+    inc_filter(HASH_FRAGMENT_1(elem_hash), &c->filter_elems_sum,
+               c->filter_elems);
+  }
 
   /* is this elem currently in the decoders table? */
 
@@ -382,7 +389,8 @@ static void hpack_enc(grpc_chttp2_hpack_compressor *c, grpc_mdelem *elem,
   /* should this elem be in the table? */
   decoder_space_usage = 32 + GPR_SLICE_LENGTH(elem->key->slice) +
                         GPR_SLICE_LENGTH(elem->value->slice);
-  should_add_elem = decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
+  should_add_elem = interned &&
+                    decoder_space_usage < MAX_DECODER_SPACE_USAGE &&
                     c->filter_elems[HASH_FRAGMENT_1(elem_hash)] >=
                         c->filter_elems_sum / ONE_ON_ADD_PROBABILITY;
 
@@ -534,7 +542,7 @@ exit_loop:
 }
 
 void grpc_chttp2_encode(grpc_stream_op *ops, size_t ops_count, int eof,
-                        gpr_uint32 stream_id,
+                        gpr_uint32 stream_id, gpr_uint32 max_frame_size,
                         grpc_chttp2_hpack_compressor *compressor,
                         gpr_slice_buffer *output) {
   framer_state st;
@@ -544,10 +552,12 @@ void grpc_chttp2_encode(grpc_stream_op *ops, size_t ops_count, int eof,
   gpr_uint32 curop = 0;
 
   GPR_ASSERT(stream_id != 0);
+  GPR_ASSERT(max_frame_size > 0);
 
   st.cur_frame_type = NONE;
   st.last_was_header = 0;
   st.stream_id = stream_id;
+  st.max_frame_size = max_frame_size;
   st.output = output;
 
   while (curop < ops_count) {
@@ -581,12 +591,12 @@ void grpc_chttp2_encode(grpc_stream_op *ops, size_t ops_count, int eof,
         slice = op->data.slice;
         if (st.cur_frame_type == DATA &&
             st.output->length - st.output_length_at_start_of_frame ==
-                GRPC_CHTTP2_MAX_PAYLOAD_LENGTH) {
+                max_frame_size) {
           finish_frame(&st, 0, 0);
         }
         ensure_frame_type(&st, DATA, 1);
-        max_take_size = GRPC_CHTTP2_MAX_PAYLOAD_LENGTH +
-                        st.output_length_at_start_of_frame - st.output->length;
+        max_take_size = max_frame_size + st.output_length_at_start_of_frame -
+                        st.output->length;
         if (GPR_SLICE_LENGTH(slice) > max_take_size) {
           slice = gpr_slice_split_head(&op->data.slice, max_take_size);
         } else {
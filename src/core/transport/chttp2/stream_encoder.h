@@ -84,9 +84,10 @@ gpr_uint32 grpc_chttp2_preencode(grpc_stream_op *inops, size_t *inops_count,
                                  gpr_uint32 max_flow_controlled_bytes,
                                  grpc_stream_op_buffer *outops);
 
-/* encode stream ops to output */
+/* encode stream ops to output, in frames carrying at most max_frame_size
+   bytes of payload */
 void grpc_chttp2_encode(grpc_stream_op *ops, size_t ops_count, int eof,
-                        gpr_uint32 stream_id,
+                        gpr_uint32 stream_id, gpr_uint32 max_frame_size,
                         grpc_chttp2_hpack_compressor *compressor,
                         gpr_slice_buffer *output);
 
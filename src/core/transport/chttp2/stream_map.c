@@ -32,22 +32,37 @@
  */
 
 #include "src/core/transport/chttp2/stream_map.h"
+
+#include <string.h>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/useful.h>
 
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map *map,
                                  size_t initial_capacity) {
+  size_t capacity = 2;
   GPR_ASSERT(initial_capacity > 1);
-  map->keys = gpr_malloc(sizeof(gpr_uint32) * initial_capacity);
-  map->values = gpr_malloc(sizeof(void *) * initial_capacity);
-  map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  while (capacity < initial_capacity) capacity *= 2;
+  map->values = gpr_malloc(sizeof(void *) * capacity);
+  memset(map->values, 0, sizeof(void *) * capacity);
+  map->capacity = capacity;
+  map->min_capacity = capacity;
+  map->ring_count = 0;
+  map->base = 0;
+  map->last_key = 0;
+  map->overflow_keys = NULL;
+  map->overflow_values = NULL;
+  map->overflow_count = 0;
+  map->overflow_free = 0;
+  map->overflow_capacity = 0;
+  map->in_for_each = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map *map) {
-  gpr_free(map->keys);
   gpr_free(map->values);
+  gpr_free(map->overflow_keys);
+  gpr_free(map->overflow_values);
 }
 
 static size_t compact(gpr_uint32 *keys, void **values, size_t count) {
@@ -64,44 +79,39 @@ static size_t compact(gpr_uint32 *keys, void **values, size_t count) {
   return out;
 }
 
-void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map *map, gpr_uint32 key,
-                                void *value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  gpr_uint32 *keys = map->keys;
-  void **values = map->values;
-
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
-  GPR_ASSERT(value);
+/* append to the overflow: key must be greater than any key already there */
+static void overflow_add(grpc_chttp2_stream_map *map, gpr_uint32 key,
+                         void *value) {
+  size_t capacity = map->overflow_capacity;
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
+  if (map->overflow_count == capacity) {
+    if (map->overflow_free > capacity / 4) {
+      map->overflow_count =
+          compact(map->overflow_keys, map->overflow_values, capacity);
+      map->overflow_free = 0;
     } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 3 * capacity / 2;
-      map->keys = keys = gpr_realloc(keys, capacity * sizeof(gpr_uint32));
-      map->values = values = gpr_realloc(values, capacity * sizeof(void *));
+      /* resize when less than 25% of the overflow is free, because
+         compaction won't help much */
+      map->overflow_capacity = capacity = GPR_MAX(8, 3 * capacity / 2);
+      map->overflow_keys =
+          gpr_realloc(map->overflow_keys, capacity * sizeof(gpr_uint32));
+      map->overflow_values =
+          gpr_realloc(map->overflow_values, capacity * sizeof(void *));
     }
   }
 
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  map->overflow_keys[map->overflow_count] = key;
+  map->overflow_values[map->overflow_count] = value;
+  map->overflow_count++;
 }
 
-static void **find(grpc_chttp2_stream_map *map, gpr_uint32 key) {
+static void **overflow_find(grpc_chttp2_stream_map *map, gpr_uint32 key) {
   size_t min_idx = 0;
-  size_t max_idx = map->count;
+  size_t max_idx = map->overflow_count;
   size_t mid_idx;
-  gpr_uint32 *keys = map->keys;
-  void **values = map->values;
+  gpr_uint32 *keys = map->overflow_keys;
   gpr_uint32 mid_key;
 
-  if (max_idx == 0) return NULL;
-
   while (min_idx < max_idx) {
     /* find the midpoint, avoiding overflow */
     mid_idx = min_idx + ((max_idx - min_idx) / 2);
@@ -112,21 +122,122 @@ static void **find(grpc_chttp2_stream_map *map, gpr_uint32 key) {
     } else if (mid_key > key) {
       max_idx = mid_idx;
     } else /* mid_key == key */ {
-      return &values[mid_idx];
+      return &map->overflow_values[mid_idx];
     }
   }
 
   return NULL;
 }
 
+static void **find(grpc_chttp2_stream_map *map, gpr_uint32 key) {
+  if (map->ring_count != 0 && key >= map->base) {
+    if (key - map->base >= map->capacity) return NULL;
+    return &map->values[key & (map->capacity - 1)];
+  }
+  return overflow_find(map, key);
+}
+
+/* move base up to the oldest key still in the ring; requires ring_count > 0 */
+static void advance_base(grpc_chttp2_stream_map *map) {
+  size_t mask = map->capacity - 1;
+  while (map->values[map->base & mask] == NULL) {
+    map->base++;
+  }
+}
+
+/* move the oldest entry in the ring to the overflow; requires ring_count > 0 */
+static void evict_oldest(grpc_chttp2_stream_map *map, gpr_uint32 next_base) {
+  void **oldest = &map->values[map->base & (map->capacity - 1)];
+  overflow_add(map, map->base, *oldest);
+  *oldest = NULL;
+  if (--map->ring_count == 0) {
+    map->base = next_base;
+  } else {
+    advance_base(map);
+  }
+}
+
+/* copy the ring into a new one of new_capacity, which must cover the window */
+static void resize(grpc_chttp2_stream_map *map, size_t new_capacity) {
+  size_t old_mask = map->capacity - 1;
+  size_t new_mask = new_capacity - 1;
+  void **values = gpr_malloc(sizeof(void *) * new_capacity);
+  gpr_uint32 key;
+
+  memset(values, 0, sizeof(void *) * new_capacity);
+  if (map->ring_count != 0) {
+    for (key = map->base; key != map->last_key + 1; key++) {
+      values[key & new_mask] = map->values[key & old_mask];
+    }
+  }
+  gpr_free(map->values);
+  map->values = values;
+  map->capacity = new_capacity;
+}
+
+/* halve the ring while it is nearly empty: add grows it once an eighth of the
+   slots are live, so shrinking only below a thirty-second leaves room for
+   the load to double back before the ring grows again */
+static void maybe_shrink(grpc_chttp2_stream_map *map) {
+  size_t new_capacity;
+
+  if (map->in_for_each) return;
+  while (map->capacity > map->min_capacity &&
+         map->ring_count <= map->capacity / 32) {
+    new_capacity = map->capacity / 2;
+    while (map->ring_count != 0 && map->last_key - map->base >= new_capacity) {
+      evict_oldest(map, map->base);
+    }
+    resize(map, new_capacity);
+  }
+}
+
+void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map *map, gpr_uint32 key,
+                                void *value) {
+  GPR_ASSERT(map->last_key < key);
+  GPR_ASSERT(value);
+
+  if (map->ring_count == 0) {
+    map->base = key;
+  }
+  while (key - map->base >= map->capacity) {
+    if (map->ring_count > map->capacity / 8) {
+      /* a good part of the window is live streams (http2 stream ids in one
+         map share their parity, so at most half the slots are usable): make
+         room for more */
+      resize(map, 2 * map->capacity);
+    } else {
+      /* the window is being held open by a few old streams: move the oldest
+         out of the way */
+      evict_oldest(map, key);
+    }
+  }
+
+  map->values[key & (map->capacity - 1)] = value;
+  map->ring_count++;
+  map->last_key = key;
+}
+
 void *grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map *map,
                                     gpr_uint32 key) {
   void **pvalue = find(map, key);
-  void *out = NULL;
-  if (pvalue != NULL) {
-    out = *pvalue;
-    *pvalue = NULL;
-    map->free += (out != NULL);
+  void *out;
+  if (pvalue == NULL || *pvalue == NULL) return NULL;
+  out = *pvalue;
+  *pvalue = NULL;
+  if (map->ring_count != 0 && key >= map->base) {
+    if (--map->ring_count != 0 && key == map->base) {
+      advance_base(map);
+    }
+    maybe_shrink(map);
+  } else if (++map->overflow_free == map->overflow_count) {
+    gpr_free(map->overflow_keys);
+    gpr_free(map->overflow_values);
+    map->overflow_keys = NULL;
+    map->overflow_values = NULL;
+    map->overflow_count = 0;
+    map->overflow_free = 0;
+    map->overflow_capacity = 0;
   }
   return out;
 }
@@ -137,7 +248,7 @@ void *grpc_chttp2_stream_map_find(grpc_chttp2_stream_map *map, gpr_uint32 key) {
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map *map) {
-  return map->count - map->free;
+  return map->ring_count + map->overflow_count - map->overflow_free;
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map *map,
@@ -145,10 +256,23 @@ void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map *map,
                                                void *value),
                                      void *user_data) {
   size_t i;
+  gpr_uint32 key;
+  gpr_uint32 last_key = map->last_key;
+  size_t mask = map->capacity - 1;
 
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
+  map->in_for_each = 1;
+  for (i = 0; i < map->overflow_count; i++) {
+    if (map->overflow_values[i]) {
+      f(user_data, map->overflow_keys[i], map->overflow_values[i]);
+    }
+  }
+  if (map->ring_count != 0) {
+    for (key = map->base; key != last_key + 1; key++) {
+      if (map->values[key & mask]) {
+        f(user_data, key, map->values[key & mask]);
+      }
     }
   }
+  map->in_for_each = 0;
+  maybe_shrink(map);
 }
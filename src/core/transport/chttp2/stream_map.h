@@ -40,16 +40,44 @@
 
 /* Data structure to map a gpr_uint32 to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
    Adds are restricted to strictly higher keys than previously seen (this is
-   guaranteed by http2). */
+   guaranteed by http2), so live keys mostly sit in a narrow window just below
+   the highest key added. The map is a ring of values indexed directly by
+   key: key k lives at values[k & (capacity - 1)] while base <= k < base +
+   capacity, where base is the oldest key in the ring. Finds, adds and
+   deletes are O(1), and deletes leave nothing to compact.
+
+   A stream that outlives many later ones would stretch that window, so when
+   the window must move past its old entries while the ring is sparse those
+   entries are evicted into a small sorted array (the overflow), which is
+   binary searched for keys below base.
+
+   Once most of its streams have gone the ring shrinks back (again evicting
+   the oldest entries should the window not fit), and the overflow is freed
+   when it empties, so memory and for_each track the live entries rather than
+   the busiest the map has been. */
 typedef struct {
-  gpr_uint32 *keys;
+  /* the ring: capacity is a power of two */
   void **values;
-  size_t count;
-  size_t free;
   size_t capacity;
+  /* the ring never shrinks below its initial capacity */
+  size_t min_capacity;
+  size_t ring_count;
+  gpr_uint32 base;
+  /* the highest key ever added */
+  gpr_uint32 last_key;
+
+  /* evicted entries, sorted by key, with deleted entries NULLed until the
+     overflow next needs room */
+  gpr_uint32 *overflow_keys;
+  void **overflow_values;
+  size_t overflow_count;
+  size_t overflow_free;
+  size_t overflow_capacity;
+
+  /* set while for_each runs, which must not see the ring reshaped under it
+     by deletes from its callback */
+  int in_for_each;
 } grpc_chttp2_stream_map;
 
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map *map,
@@ -57,7 +85,7 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map *map,
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map *map);
 
 /* Add a new key: given http2 semantics, new keys must always be greater than
-   existing keys - this is asserted */
+   existing keys (and so non-zero) - this is asserted */
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map *map, gpr_uint32 key,
                                 void *value);
 
@@ -72,7 +100,8 @@ void *grpc_chttp2_stream_map_find(grpc_chttp2_stream_map *map, gpr_uint32 key);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map *map);
 
-/* Callback on each stream */
+/* Callback on each stream, in key order; f may delete entries, but must not
+   add any */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map *map,
                                      void (*f)(void *user_data, gpr_uint32 key,
                                                void *value),
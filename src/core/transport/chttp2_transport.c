@@ -37,6 +37,8 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "src/core/iomgr/alarm.h"
+#include "src/core/iomgr/iomgr.h"
 #include "src/core/support/string.h"
 #include "src/core/transport/chttp2/frame_data.h"
 #include "src/core/transport/chttp2/frame_goaway.h"
@@ -60,6 +62,10 @@
 #define DEFAULT_CONNECTION_WINDOW_TARGET (1024 * 1024)
 #define MAX_WINDOW 0x7fffffffu
 
+/* with write coalescing on, a write is started without further delay once
+   this many bytes of application data are waiting */
+#define WRITE_COALESCE_BYTES 16384
+
 #define CLIENT_CONNECT_STRING "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
 #define CLIENT_CONNECT_STRLEN 24
 
@@ -202,6 +208,20 @@ struct transport {
   gpr_uint8 closed;
   error_state error_state;
 
+  /* write coalescing (GRPC_ARG_HTTP2_WRITE_COALESCE_US): bytes of
+     application data queued since the last write started, when the first of
+     them was queued, whether the next unlock() should write regardless,
+     whether a flush is queued for the next poller iteration, and whether
+     coalesce_alarm is armed to flush once the delay runs out */
+  gpr_uint8 coalesce_writes;
+  gpr_uint8 flush_requested;
+  gpr_uint8 flush_scheduled;
+  gpr_uint8 coalesce_alarm_pending;
+  grpc_alarm coalesce_alarm;
+  gpr_uint32 unwritten_bytes;
+  gpr_timespec unwritten_since;
+  gpr_timespec coalesce_delay;
+
   /* stream indexing */
   gpr_uint32 next_stream_id;
   gpr_uint32 last_incoming_stream_id;
@@ -250,15 +270,30 @@ struct transport {
   /* stream ops that need to be destroyed, but outside of the lock */
   grpc_stream_op_buffer nuke_later_sopb;
 
+  /* op arrays from the sopbs of destroyed streams that outgrew their inline
+     storage: new streams take these rather than grow from scratch, so that
+     metadata heavy calls don't allocate per stream in steady state */
+  grpc_sopb_storage_cache sopb_storage_cache;
+
   /* active parser */
   void *parser_data;
   stream *incoming_stream;
   grpc_chttp2_parse_error (*parser)(void *parser_user_data,
                                     grpc_chttp2_parse_state *state,
                                     gpr_slice slice, int is_last);
+  /* DATA and HEADERS payloads are parsed with mu released (parse_payload):
+     meanwhile the incoming stream's data parser state is swapped into
+     unlocked_parser, and what it and on_header produce is staged in
+     unlocked_parser.incoming_sopb until mu is retaken. parsing_unlocked is
+     set for the duration; destroy_stream waits for it to clear */
+  grpc_chttp2_data_parser unlocked_parser;
+  gpr_uint8 parsing_unlocked;
 
   gpr_slice_buffer outbuf;
   gpr_slice_buffer qbuf;
+  /* the peer's frame size limit, as of when the current write was prepared:
+     encoding happens outside the lock */
+  gpr_uint32 write_max_frame_size;
 
   stream_list lists[STREAM_LIST_COUNT];
   grpc_chttp2_stream_map stream_map;
@@ -307,12 +342,18 @@ static const grpc_transport_vtable vtable;
 
 static void push_setting(transport *t, grpc_chttp2_setting_id id,
                          gpr_uint32 value);
+static void add_uninterned_keys(transport *t, const char *keys);
 
 static int prepare_callbacks(transport *t);
 static void run_callbacks(transport *t, const grpc_transport_callbacks *cb);
 static void call_cb_closed(transport *t, const grpc_transport_callbacks *cb);
 
 static int prepare_write(transport *t);
+static int hold_write(transport *t);
+static void flush_held_writes(transport *t);
+static void finalize_outbuf(transport *t);
+static void finish_write_locked(transport *t, int success);
+static void finish_write(void *tp, grpc_endpoint_cb_status error);
 static void perform_write(transport *t, grpc_endpoint *ep);
 
 static void lock(transport *t);
@@ -358,6 +399,7 @@ static void destruct_transport(transport *t) {
   grpc_chttp2_hpack_parser_destroy(&t->hpack_parser);
   grpc_chttp2_hpack_compressor_destroy(&t->hpack_compressor);
   grpc_chttp2_goaway_parser_destroy(&t->goaway_parser);
+  grpc_chttp2_data_parser_destroy(&t->unlocked_parser);
 
   grpc_mdstr_unref(t->str_grpc_timeout);
 
@@ -388,6 +430,8 @@ static void destruct_transport(transport *t) {
 
   grpc_sopb_destroy(&t->nuke_later_sopb);
 
+  grpc_sopb_storage_cache_destroy(&t->sopb_storage_cache);
+
   grpc_mdctx_unref(t->metadata_context);
 
   gpr_free(t);
@@ -423,6 +467,12 @@ static void init_transport(transport *t, grpc_transport_setup_callback setup,
   t->reading = 1;
   t->writing = 0;
   t->error_state = ERROR_STATE_NONE;
+  t->coalesce_writes = 0;
+  t->flush_requested = 0;
+  t->flush_scheduled = 0;
+  t->coalesce_alarm_pending = 0;
+  t->unwritten_bytes = 0;
+  t->coalesce_delay = gpr_time_0;
   t->next_stream_id = is_client ? 1 : 2;
   t->last_incoming_stream_id = 0;
   t->destroying = 0;
@@ -433,6 +483,8 @@ static void init_transport(transport *t, grpc_transport_setup_callback setup,
   t->connection_window_target = DEFAULT_CONNECTION_WINDOW_TARGET;
   t->deframe_state = is_client ? DTS_FH_0 : DTS_CLIENT_PREFIX_0;
   t->expect_continuation_stream_id = 0;
+  grpc_chttp2_data_parser_init(&t->unlocked_parser);
+  t->parsing_unlocked = 0;
   t->pings = NULL;
   t->ping_count = 0;
   t->ping_capacity = 0;
@@ -445,6 +497,7 @@ static void init_transport(transport *t, grpc_transport_setup_callback setup,
   gpr_slice_buffer_init(&t->outbuf);
   gpr_slice_buffer_init(&t->qbuf);
   grpc_sopb_init(&t->nuke_later_sopb);
+  grpc_sopb_storage_cache_init(&t->sopb_storage_cache);
   grpc_chttp2_hpack_parser_init(&t->hpack_parser, t->metadata_context);
   if (is_client) {
     gpr_slice_buffer_add(&t->qbuf,
@@ -491,6 +544,33 @@ static void init_transport(transport *t, grpc_transport_setup_callback setup,
           push_setting(t, GRPC_CHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
                        channel_args->args[i].value.integer);
         }
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_HTTP2_WRITE_COALESCE_US)) {
+        if (channel_args->args[i].type != GRPC_ARG_INTEGER) {
+          gpr_log(GPR_ERROR, "%s: must be an integer",
+                  GRPC_ARG_HTTP2_WRITE_COALESCE_US);
+        } else if (channel_args->args[i].value.integer > 0) {
+          t->coalesce_writes = 1;
+          t->coalesce_delay =
+              gpr_time_from_micros(channel_args->args[i].value.integer);
+        }
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_HTTP2_MAX_FRAME_SIZE)) {
+        if (channel_args->args[i].type != GRPC_ARG_INTEGER) {
+          gpr_log(GPR_ERROR, "%s: must be an integer",
+                  GRPC_ARG_HTTP2_MAX_FRAME_SIZE);
+        } else {
+          push_setting(t, GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE,
+                       channel_args->args[i].value.integer);
+        }
+      } else if (0 == strcmp(channel_args->args[i].key,
+                             GRPC_ARG_HTTP2_UNINTERNED_METADATA_KEYS)) {
+        if (channel_args->args[i].type != GRPC_ARG_STRING) {
+          gpr_log(GPR_ERROR, "%s: must be a string",
+                  GRPC_ARG_HTTP2_UNINTERNED_METADATA_KEYS);
+        } else {
+          add_uninterned_keys(t, channel_args->args[i].value.string);
+        }
       }
     }
   }
@@ -517,8 +597,10 @@ static void init_transport(transport *t, grpc_transport_setup_callback setup,
 
 static void destroy_transport(grpc_transport *gt) {
   transport *t = (transport *)gt;
+  int cancel_coalesce_alarm;
 
   lock(t);
+  flush_held_writes(t);
   t->destroying = 1;
   /* Wait for pending stuff to finish.
      We need to be not calling back to ensure that closed() gets a chance to
@@ -540,14 +622,22 @@ static void destroy_transport(grpc_transport *gt) {
      problematic for performance. */
   lock(t);
   GPR_ASSERT(!t->cb);
+  cancel_coalesce_alarm = t->coalesce_alarm_pending;
   unlock(t);
 
+  /* don't keep the transport alive until the alarm fires; the alarm's
+     callback may run from within grpc_alarm_cancel, so not under the lock */
+  if (cancel_coalesce_alarm) {
+    grpc_alarm_cancel(&t->coalesce_alarm);
+  }
+
   unref_transport(t);
 }
 
 static void close_transport(grpc_transport *gt) {
   transport *t = (transport *)gt;
-  gpr_mu_lock(&t->mu);
+  lock(t);
+  flush_held_writes(t);
   GPR_ASSERT(!t->closed);
   t->closed = 1;
   if (t->ep) {
@@ -566,6 +656,27 @@ static void goaway(grpc_transport *gt, grpc_status_code status,
   unlock(t);
 }
 
+/* called without t->mu held: releases whatever the sopbs still reference,
+   then hands the op arrays they grew to the transport's cache; whatever the
+   cache doesn't take is freed as the sopbs are destroyed */
+static void recycle_sopb_storage(transport *t, grpc_stream_op_buffer **sopbs,
+                                 size_t count) {
+  int grown = 0;
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    grpc_sopb_reset(sopbs[i]);
+    grown |= sopbs[i]->ops != sopbs[i]->inlined_ops;
+  }
+  if (!grown) return;
+
+  gpr_mu_lock(&t->mu);
+  for (i = 0; i < count; i++) {
+    grpc_sopb_storage_cache_put(&t->sopb_storage_cache, sopbs[i]);
+  }
+  gpr_mu_unlock(&t->mu);
+}
+
 static int init_stream(grpc_transport *gt, grpc_stream *gs,
                        const void *server_data) {
   transport *t = (transport *)gt;
@@ -599,6 +710,11 @@ static int init_stream(grpc_transport *gt, grpc_stream *gs,
   grpc_sopb_init(&s->writing_sopb);
   grpc_sopb_init(&s->callback_sopb);
   grpc_chttp2_data_parser_init(&s->parser);
+  grpc_sopb_storage_cache_take(&t->sopb_storage_cache, &s->outgoing_sopb);
+  grpc_sopb_storage_cache_take(&t->sopb_storage_cache, &s->writing_sopb);
+  grpc_sopb_storage_cache_take(&t->sopb_storage_cache, &s->callback_sopb);
+  grpc_sopb_storage_cache_take(&t->sopb_storage_cache,
+                               &s->parser.incoming_sopb);
 
   if (!server_data) {
     unlock(t);
@@ -615,14 +731,22 @@ static void schedule_nuke_sopb(transport *t, grpc_stream_op_buffer *sopb) {
 static void destroy_stream(grpc_transport *gt, grpc_stream *gs) {
   transport *t = (transport *)gt;
   stream *s = (stream *)gs;
+  grpc_stream_op_buffer *sopbs[4];
   size_t i;
 
   gpr_mu_lock(&t->mu);
+  flush_held_writes(t);
 
-  /* stop parsing if we're currently parsing this stream */
-  if (t->deframe_state == DTS_FRAME && t->incoming_stream_id == s->id &&
-      s->id != 0) {
-    become_skip_parser(t);
+  if (s->id != 0) {
+    /* the reader may be mid-slice on this stream with the lock released:
+       let it finish and hand back the stream's parser state */
+    while (t->parsing_unlocked && t->incoming_stream_id == s->id) {
+      gpr_cv_wait(&t->cv, &t->mu, gpr_inf_future);
+    }
+    /* stop parsing if we're currently parsing this stream */
+    if (t->deframe_state == DTS_FRAME && t->incoming_stream_id == s->id) {
+      become_skip_parser(t);
+    }
   }
 
   for (i = 0; i < STREAM_LIST_COUNT; i++) {
@@ -632,6 +756,11 @@ static void destroy_stream(grpc_transport *gt, grpc_stream *gs) {
 
   gpr_mu_unlock(&t->mu);
 
+  sopbs[0] = &s->outgoing_sopb;
+  sopbs[1] = &s->writing_sopb;
+  sopbs[2] = &s->callback_sopb;
+  sopbs[3] = &s->parser.incoming_sopb;
+  recycle_sopb_storage(t, sopbs, GPR_ARRAY_SIZE(sopbs));
   grpc_sopb_destroy(&s->outgoing_sopb);
   grpc_sopb_destroy(&s->writing_sopb);
   grpc_sopb_destroy(&s->callback_sopb);
@@ -719,7 +848,12 @@ static void remove_from_stream_map(transport *t, stream *s) {
 /* We take a transport-global lock in response to calls coming in from above,
    and in response to data being received from below. New data to be written
    is always queued, as are callbacks to process data. During unlock() we
-   check our todo lists and initiate callbacks and flush writes. */
+   check our todo lists and initiate callbacks and flush writes.
+   The heavy lifting on either side happens outside the lock: the reader
+   parses DATA and HEADERS payloads with it released (parse_payload), and
+   writes are framed and encoded after unlock() has dropped it
+   (perform_write). Both sides hand over to the lock only to move ops
+   between the streams' buffers and update bookkeeping. */
 
 static void lock(transport *t) { gpr_mu_lock(&t->mu); }
 
@@ -740,12 +874,18 @@ static void unlock(transport *t) {
   }
 
   /* see if we need to trigger a write - and if so, get the data ready */
-  if (ep && !t->writing) {
+  if (ep && !t->writing && !hold_write(t)) {
     t->writing = start_write = prepare_write(t);
     if (start_write) {
+      t->unwritten_bytes = 0;
       ref_transport(t);
     }
   }
+  /* a flush request lasts until a write gets going, or until it turns out
+     there is nothing to write */
+  if (start_write || !t->writing) {
+    t->flush_requested = 0;
+  }
 
   if (!t->writing) {
     finalize_cancellations(t);
@@ -803,6 +943,8 @@ static void unlock(transport *t) {
   if (perform_callbacks || call_closed || num_goaways) {
     lock(t);
     t->calling_back = 0;
+    /* the callback batch is over: anything it sent can go out now */
+    t->flush_requested = 1;
     if (t->destroying) gpr_cv_signal(&t->cv);
     unlock(t);
     unref_transport(t);
@@ -817,6 +959,99 @@ static void unlock(transport *t) {
  * OUTPUT PROCESSING
  */
 
+static void flush_writes(void *tp, int success) {
+  transport *t = tp;
+  lock(t);
+  t->flush_scheduled = 0;
+  t->flush_requested = 1;
+  unlock(t);
+  unref_transport(t);
+}
+
+static void coalesce_alarm_fired(void *tp, int success) {
+  transport *t = tp;
+  lock(t);
+  t->coalesce_alarm_pending = 0;
+  /* the alarm may belong to data that has since been written; flushing
+     early is harmless, the delay is only an upper bound */
+  if (t->unwritten_bytes != 0) {
+    t->flush_requested = 1;
+  }
+  unlock(t);
+  unref_transport(t);
+}
+
+/* Starts a write of anything write coalescing is holding back, so that it
+   goes out ahead of whatever the caller does next (cancelling or destroying
+   a stream, closing or destroying the transport). Framing can call back into
+   the transport (flow control callbacks), so the mutex is dropped around it
+   and the endpoint write; unlike unlock(), no transport callbacks are made:
+   those due once the write completes wait for the caller's next unlock().
+   If a write is already in flight, the held data goes out with the first
+   unlock() after it completes.
+   Requires t->mu held; releases and retakes it. */
+static void flush_held_writes(transport *t) {
+  grpc_endpoint *ep = t->ep;
+  grpc_endpoint_write_status status;
+
+  if (t->unwritten_bytes == 0) return;
+  t->flush_requested = 1;
+  if (ep == NULL || t->writing) return;
+  t->writing = prepare_write(t);
+  if (!t->writing) return;
+  t->flush_requested = 0;
+  t->unwritten_bytes = 0;
+  ref_transport(t);
+  gpr_mu_unlock(&t->mu);
+
+  /* as in perform_write: t->writing keeps others off the outbuf */
+  finalize_outbuf(t);
+  GPR_ASSERT(t->outbuf.count > 0);
+  status = grpc_endpoint_write(ep, t->outbuf.slices, t->outbuf.count,
+                               finish_write, t);
+
+  gpr_mu_lock(&t->mu);
+  if (status != GRPC_ENDPOINT_WRITE_PENDING) {
+    finish_write_locked(t, status == GRPC_ENDPOINT_WRITE_DONE);
+    /* our caller still holds a ref, so this one is not the last */
+    unref_transport(t);
+  }
+}
+
+/* With write coalescing on, decides whether a write carrying application
+   data should wait for more sends to join it. Writes are held until the
+   current callback batch or poller iteration finishes, WRITE_COALESCE_BYTES
+   are queued, or the data has waited for the coalescing delay.
+   Requires t->mu held. */
+static int hold_write(transport *t) {
+  if (!t->coalesce_writes || t->flush_requested || t->unwritten_bytes == 0 ||
+      t->unwritten_bytes >= WRITE_COALESCE_BYTES || t->destroying ||
+      t->error_state != ERROR_STATE_NONE) {
+    return 0;
+  }
+  if (gpr_time_cmp(gpr_time_sub(gpr_now(), t->unwritten_since),
+                   t->coalesce_delay) >= 0) {
+    return 0;
+  }
+  if (!t->flush_scheduled) {
+    /* runs from the next poller iteration (or the iomgr's callback thread),
+       by which time the sends made alongside this one have been queued */
+    t->flush_scheduled = 1;
+    ref_transport(t);
+    grpc_iomgr_add_callback(flush_writes, t);
+  }
+  if (!t->coalesce_alarm_pending) {
+    /* backs the latency bound should the poller be slow to get around to
+       flush_writes */
+    t->coalesce_alarm_pending = 1;
+    ref_transport(t);
+    grpc_alarm_init(&t->coalesce_alarm,
+                    gpr_time_add(t->unwritten_since, t->coalesce_delay),
+                    coalesce_alarm_fired, t, gpr_now());
+  }
+  return 1;
+}
+
 static void push_setting(transport *t, grpc_chttp2_setting_id id,
                          gpr_uint32 value) {
   const grpc_chttp2_setting_parameters *sp =
@@ -832,6 +1067,22 @@ static void push_setting(transport *t, grpc_chttp2_setting_id id,
   }
 }
 
+/* keys is a comma separated list */
+static void add_uninterned_keys(transport *t, const char *keys) {
+  const char *end;
+  while (*keys) {
+    end = strchr(keys, ',');
+    if (end == NULL) end = keys + strlen(keys);
+    if (end != keys) {
+      grpc_chttp2_hpack_parser_add_uninterned_key(
+          &t->hpack_parser,
+          grpc_mdstr_from_buffer(t->metadata_context, (const gpr_uint8 *)keys,
+                                 end - keys));
+    }
+    keys = *end ? end + 1 : end;
+  }
+}
+
 static int prepare_write(transport *t) {
   stream *s;
   gpr_slice_buffer tempbuf;
@@ -853,6 +1104,9 @@ static int prepare_write(transport *t) {
     t->sent_local_settings = 1;
   }
 
+  t->write_max_frame_size =
+      t->settings[PEER_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE];
+
   /* for each stream that's become writable, frame it's data (according to
      available window sizes) and add to the output buffer */
   while (t->outgoing_window && (s = stream_list_remove_head(t, WRITABLE))) {
@@ -904,8 +1158,8 @@ static void finalize_outbuf(transport *t) {
 
   while ((s = stream_list_remove_head(t, WRITING))) {
     grpc_chttp2_encode(s->writing_sopb.ops, s->writing_sopb.nops,
-                       s->sending_write_closed, s->id, &t->hpack_compressor,
-                       &t->outbuf);
+                       s->sending_write_closed, s->id, t->write_max_frame_size,
+                       &t->hpack_compressor, &t->outbuf);
     s->writing_sopb.nops = 0;
     if (s->sending_write_closed) {
       stream_list_join(t, s, WRITTEN_CLOSED);
@@ -913,10 +1167,10 @@ static void finalize_outbuf(transport *t) {
   }
 }
 
-static void finish_write_common(transport *t, int success) {
+/* Requires t->mu held */
+static void finish_write_locked(transport *t, int success) {
   stream *s;
 
-  lock(t);
   if (!success) {
     drop_connection(t);
   }
@@ -937,6 +1191,11 @@ static void finish_write_common(transport *t, int success) {
     t->ep = NULL;
     unref_transport(t); /* safe because we'll still have the ref for write */
   }
+}
+
+static void finish_write_common(transport *t, int success) {
+  lock(t);
+  finish_write_locked(t, success);
   unlock(t);
 
   unref_transport(t);
@@ -984,9 +1243,21 @@ static void send_batch(grpc_transport *gt, grpc_stream *gs, grpc_stream_op *ops,
                        size_t ops_count, int is_last) {
   transport *t = (transport *)gt;
   stream *s = (stream *)gs;
+  size_t i;
 
   lock(t);
 
+  if (t->coalesce_writes) {
+    if (t->unwritten_bytes == 0) {
+      t->unwritten_since = gpr_now();
+    }
+    /* payload counts by size; metadata and the like as one byte each */
+    for (i = 0; i < ops_count; i++) {
+      t->unwritten_bytes += ops[i].type == GRPC_OP_SLICE
+                                ? GPR_SLICE_LENGTH(ops[i].data.slice)
+                                : 1;
+    }
+  }
   if (is_last) {
     s->queued_write_closed = 1;
   }
@@ -1015,6 +1286,7 @@ static void abort_stream(grpc_transport *gt, grpc_stream *gs,
   stream *s = (stream *)gs;
 
   lock(t);
+  flush_held_writes(t);
   cancel_stream(t, s, status, grpc_chttp2_grpc_status_to_http2_error(status),
                 1);
   unlock(t);
@@ -1084,6 +1356,11 @@ static void cancel_stream_inner(transport *t, stream *s, gpr_uint32 id,
           grpc_mdelem_from_strings(t->metadata_context, "grpc-status", buffer));
 
       stream_list_join(t, s, PENDING_CALLBACKS);
+    } else {
+      /* closed both ways: http2 allows no further frames on the stream, and
+         a reset arriving together with our trailers would have the peer
+         drop them, status included, before it reported them */
+      send_rst = 0;
     }
   }
   if (!id) send_rst = 0;
@@ -1233,9 +1510,12 @@ static int init_data_frame_parser(transport *t) {
 
 static void free_timeout(void *p) { gpr_free(p); }
 
+/* runs with t->mu released: headers are staged for parse_payload to hand
+   over to the stream */
 static void on_header(void *tp, grpc_mdelem *md) {
   transport *t = tp;
   stream *s = t->incoming_stream;
+  grpc_stream_op_buffer *sopb = &t->unlocked_parser.incoming_sopb;
 
   GPR_ASSERT(s);
 
@@ -1243,7 +1523,6 @@ static void on_header(void *tp, grpc_mdelem *md) {
                      grpc_mdstr_as_c_string(md->key),
                      grpc_mdstr_as_c_string(md->value)));
 
-  stream_list_join(t, s, PENDING_CALLBACKS);
   if (md->key == t->str_grpc_timeout) {
     gpr_timespec *cached_timeout = grpc_mdelem_get_user_data(md, free_timeout);
     if (!cached_timeout) {
@@ -1257,11 +1536,10 @@ static void on_header(void *tp, grpc_mdelem *md) {
       }
       grpc_mdelem_set_user_data(md, free_timeout, cached_timeout);
     }
-    grpc_sopb_add_deadline(&s->parser.incoming_sopb,
-                           gpr_time_add(gpr_now(), *cached_timeout));
+    grpc_sopb_add_deadline(sopb, gpr_time_add(gpr_now(), *cached_timeout));
     grpc_mdelem_unref(md);
   } else {
-    grpc_sopb_add_metadata(&s->parser.incoming_sopb, md);
+    grpc_sopb_add_metadata(sopb, md);
   }
 }
 
@@ -1390,6 +1668,13 @@ static int init_settings_frame_parser(transport *t) {
 }
 
 static int init_frame_parser(transport *t) {
+  if (t->incoming_frame_size >
+      t->settings[LOCAL_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]) {
+    gpr_log(GPR_ERROR, "Frame of %d bytes exceeds our MAX_FRAME_SIZE of %d",
+            t->incoming_frame_size,
+            t->settings[LOCAL_SETTINGS][GRPC_CHTTP2_SETTINGS_MAX_FRAME_SIZE]);
+    return 0;
+  }
   if (t->expect_continuation_stream_id != 0) {
     if (t->incoming_frame_type != GRPC_CHTTP2_FRAME_CONTINUATION) {
       gpr_log(GPR_ERROR, "Expected CONTINUATION frame, got frame type %02x",
@@ -1437,11 +1722,59 @@ static int is_window_update_legal(gpr_uint32 window_update, gpr_uint32 window) {
   return window_update < MAX_WINDOW - window;
 }
 
+/* Runs the active parser over a slice of frame payload. DATA and HEADERS
+   payloads, the bulk of what is read, are parsed with t->mu released so that
+   senders and callbacks are not held up behind them. That is safe because
+   only the reader touches the parsers, and destroy_stream waits for
+   parsing_unlocked to clear before freeing the stream being parsed. Whatever
+   was parsed is handed over to the stream once the lock is retaken.
+   Requires t->mu held; may release and retake it. */
+static grpc_chttp2_parse_error parse_payload(transport *t,
+                                             grpc_chttp2_parse_state *st,
+                                             gpr_slice slice, int is_last) {
+  stream *s = t->incoming_stream;
+  grpc_chttp2_data_parser *staged = &t->unlocked_parser;
+  void *parser_data = t->parser_data;
+  int is_data = t->parser == grpc_chttp2_data_parser_parse;
+  grpc_chttp2_parse_error err;
+
+  if (is_data) {
+    grpc_chttp2_data_parser_swap_state(staged, &s->parser);
+    parser_data = staged;
+  } else if (t->parser != grpc_chttp2_header_parser_parse) {
+    return t->parser(parser_data, st, slice, is_last);
+  }
+
+  t->parsing_unlocked = 1;
+  gpr_mu_unlock(&t->mu);
+  err = t->parser(parser_data, st, slice, is_last);
+  gpr_mu_lock(&t->mu);
+  t->parsing_unlocked = 0;
+  gpr_cv_broadcast(&t->cv);
+
+  if (is_data) {
+    grpc_chttp2_data_parser_swap_state(staged, &s->parser);
+  }
+  if (t->error_state != ERROR_STATE_NONE) {
+    /* the connection went down meanwhile: the streams have been ended, and
+       may no longer be joined to the callback list */
+    grpc_sopb_reset(&staged->incoming_sopb);
+    return GRPC_CHTTP2_CONNECTION_ERROR;
+  }
+  if (staged->incoming_sopb.nops) {
+    grpc_sopb_append(&s->parser.incoming_sopb, staged->incoming_sopb.ops,
+                     staged->incoming_sopb.nops);
+    staged->incoming_sopb.nops = 0;
+    stream_list_join(t, s, PENDING_CALLBACKS);
+  }
+  return err;
+}
+
 static int parse_frame_slice(transport *t, gpr_slice slice, int is_last) {
   grpc_chttp2_parse_state st;
   size_t i;
   memset(&st, 0, sizeof(st));
-  switch (t->parser(t->parser_data, &st, slice, is_last)) {
+  switch (parse_payload(t, &st, slice, is_last)) {
     case GRPC_CHTTP2_PARSE_OK:
       if (st.end_of_stream) {
         t->incoming_stream->read_closed = 1;
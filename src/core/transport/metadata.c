@@ -38,6 +38,7 @@
 #include <string.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/log.h>
 #include "src/core/support/murmur_hash.h"
 #include "src/core/transport/chttp2/bin_encoder.h"
@@ -45,6 +46,9 @@
 
 #define INITIAL_STRTAB_CAPACITY 4
 #define INITIAL_MDTAB_CAPACITY 4
+/* Number of mdtab buckets swept per intern/unref while garbage collection is
+   active: bounds the pause any one caller sees to a handful of elements */
+#define MDTAB_GC_BUCKETS_PER_OP 4
 
 typedef struct internal_string {
   /* must be byte compatible with grpc_mdstr */
@@ -54,6 +58,10 @@ typedef struct internal_string {
   /* private only data */
   gpr_uint32 refs;
   gpr_uint8 has_base64_and_huffman_encoded;
+  /* is this string in strtab? if not, it's reference counted by atomic_refs
+     without holding the context lock */
+  gpr_uint8 interned;
+  gpr_atm atomic_refs;
   gpr_slice_refcount refcount;
 
   gpr_slice base64_and_huffman;
@@ -73,10 +81,21 @@ typedef struct internal_metadata {
   void (*destroy_user_data)(void *user_data);
 
   gpr_uint32 refs;
+  /* as for internal_string */
+  gpr_uint8 interned;
+  gpr_atm atomic_refs;
   grpc_mdctx *context;
   struct internal_metadata *bucket_next;
 } internal_metadata;
 
+/* A non-interned element and its value string share one allocation, with
+   the value bytes following. The element holds a ref to the value, so the
+   block is freed when the value dies. */
+typedef struct uninterned_metadata {
+  internal_metadata md;
+  internal_string value;
+} uninterned_metadata;
+
 struct grpc_mdctx {
   gpr_uint32 hash_seed;
   int refs;
@@ -91,12 +110,23 @@ struct grpc_mdctx {
   size_t mdtab_count;
   size_t mdtab_free;
   size_t mdtab_capacity;
+  /* number of live non-interned strings: incremented without the lock */
+  gpr_atm uninterned_count;
+  /* next bucket to be visited by the incremental collector */
+  size_t mdtab_gc_cursor;
+
+  /* counters reported by grpc_mdctx_get_stats */
+  gpr_uint64 mdtab_gc_steps;
+  gpr_uint64 mdtab_gc_freed;
+  gpr_uint64 mdtab_grows;
+  gpr_timespec mdtab_gc_pause_total;
+  gpr_timespec mdtab_gc_pause_max;
 };
 
 static void internal_string_ref(internal_string *s);
 static void internal_string_unref(internal_string *s);
 static void discard_metadata(grpc_mdctx *ctx);
-static void gc_mdtab(grpc_mdctx *ctx);
+static void gc_mdtab(grpc_mdctx *ctx, size_t nbuckets);
 static void metadata_context_destroy(grpc_mdctx *ctx);
 
 static void lock(grpc_mdctx *ctx) { gpr_mu_lock(&ctx->mu); }
@@ -117,11 +147,12 @@ static void unlock(grpc_mdctx *ctx) {
   if (ctx->refs == 0) {
     /* uncomment if you're having trouble diagnosing an mdelem leak to make
        things clearer (slows down destruction a lot, however) */
-    /* gc_mdtab(ctx); */
+    /* gc_mdtab(ctx, ctx->mdtab_capacity); */
     if (ctx->mdtab_count && ctx->mdtab_count == ctx->mdtab_free) {
       discard_metadata(ctx);
     }
-    if (ctx->strtab_count == 0) {
+    if (ctx->strtab_count == 0 &&
+        gpr_atm_acq_load(&ctx->uninterned_count) == 0) {
       gpr_mu_unlock(&ctx->mu);
       metadata_context_destroy(ctx);
       return;
@@ -151,6 +182,13 @@ grpc_mdctx *grpc_mdctx_create_with_seed(gpr_uint32 seed) {
   ctx->mdtab_count = 0;
   ctx->mdtab_capacity = INITIAL_MDTAB_CAPACITY;
   ctx->mdtab_free = 0;
+  gpr_atm_rel_store(&ctx->uninterned_count, 0);
+  ctx->mdtab_gc_cursor = 0;
+  ctx->mdtab_gc_steps = 0;
+  ctx->mdtab_gc_freed = 0;
+  ctx->mdtab_grows = 0;
+  ctx->mdtab_gc_pause_total = gpr_time_0;
+  ctx->mdtab_gc_pause_max = gpr_time_0;
 
   return ctx;
 }
@@ -190,6 +228,7 @@ static void metadata_context_destroy(grpc_mdctx *ctx) {
   GPR_ASSERT(ctx->strtab_count == 0);
   GPR_ASSERT(ctx->mdtab_count == 0);
   GPR_ASSERT(ctx->mdtab_free == 0);
+  GPR_ASSERT(gpr_atm_acq_load(&ctx->uninterned_count) == 0);
   gpr_free(ctx->strtab);
   gpr_free(ctx->mdtab);
   gpr_mu_unlock(&ctx->mu);
@@ -247,15 +286,47 @@ static void internal_destroy_string(internal_string *is) {
   gpr_free(is);
 }
 
-static void internal_string_ref(internal_string *s) { ++s->refs; }
+/* called with the context locked */
+static void destroy_uninterned_string(internal_string *is) {
+  grpc_mdctx *ctx = is->context;
+  if (is->has_base64_and_huffman_encoded) {
+    gpr_slice_unref(is->base64_and_huffman);
+  }
+  gpr_atm_no_barrier_fetch_add(&ctx->uninterned_count, -1);
+  gpr_free((char *)is - offsetof(uninterned_metadata, value));
+}
+
+static void internal_string_ref(internal_string *s) {
+  if (s->interned) {
+    ++s->refs;
+  } else {
+    gpr_atm_no_barrier_fetch_add(&s->atomic_refs, 1);
+  }
+}
 
 static void internal_string_unref(internal_string *s) {
+  if (!s->interned) {
+    if (1 == gpr_atm_full_fetch_add(&s->atomic_refs, -1)) {
+      destroy_uninterned_string(s);
+    }
+    return;
+  }
   GPR_ASSERT(s->refs > 0);
   if (0 == --s->refs) {
     internal_destroy_string(s);
   }
 }
 
+static void uninterned_string_unref(internal_string *s) {
+  grpc_mdctx *ctx = s->context;
+  if (1 == gpr_atm_full_fetch_add(&s->atomic_refs, -1)) {
+    /* the context may be waiting on this string to be destroyed */
+    lock(ctx);
+    destroy_uninterned_string(s);
+    unlock(ctx);
+  }
+}
+
 static void slice_ref(void *p) {
   internal_string *is =
       (internal_string *)((char *)p - offsetof(internal_string, refcount));
@@ -274,6 +345,17 @@ static void slice_unref(void *p) {
   unlock(ctx);
 }
 
+static void uninterned_slice_ref(void *p) {
+  internal_string *is =
+      (internal_string *)((char *)p - offsetof(internal_string, refcount));
+  gpr_atm_no_barrier_fetch_add(&is->atomic_refs, 1);
+}
+
+static void uninterned_slice_unref(void *p) {
+  uninterned_string_unref(
+      (internal_string *)((char *)p - offsetof(internal_string, refcount)));
+}
+
 grpc_mdstr *grpc_mdstr_from_string(grpc_mdctx *ctx, const char *str) {
   return grpc_mdstr_from_buffer(ctx, (const gpr_uint8 *)str, strlen(str));
 }
@@ -326,6 +408,7 @@ grpc_mdstr *grpc_mdstr_from_buffer(grpc_mdctx *ctx, const gpr_uint8 *buf,
     s->slice.data.refcounted.bytes[length] = 0;
   }
   s->has_base64_and_huffman_encoded = 0;
+  s->interned = 1;
   s->hash = hash;
   s->context = ctx;
   s->bucket_next = ctx->strtab[hash % ctx->strtab_capacity];
@@ -342,12 +425,19 @@ grpc_mdstr *grpc_mdstr_from_buffer(grpc_mdctx *ctx, const gpr_uint8 *buf,
   return (grpc_mdstr *)s;
 }
 
-static void gc_mdtab(grpc_mdctx *ctx) {
+/* Sweep nbuckets buckets of mdtab starting at the gc cursor, freeing any
+   elements that are no longer referenced. */
+static void gc_mdtab(grpc_mdctx *ctx, size_t nbuckets) {
   size_t i;
   internal_metadata **prev_next;
   internal_metadata *md, *next;
+  gpr_timespec start = gpr_now();
+  gpr_timespec pause;
 
-  for (i = 0; i < ctx->mdtab_capacity; i++) {
+  nbuckets = GPR_MIN(nbuckets, ctx->mdtab_capacity);
+  for (; nbuckets > 0; nbuckets--) {
+    i = ctx->mdtab_gc_cursor;
+    ctx->mdtab_gc_cursor = (i + 1) % ctx->mdtab_capacity;
     prev_next = &ctx->mdtab[i];
     for (md = ctx->mdtab[i]; md; md = next) {
       next = md->bucket_next;
@@ -361,13 +451,28 @@ static void gc_mdtab(grpc_mdctx *ctx) {
         *prev_next = next;
         ctx->mdtab_free--;
         ctx->mdtab_count--;
+        ctx->mdtab_gc_freed++;
       } else {
         prev_next = &md->bucket_next;
       }
     }
   }
 
-  GPR_ASSERT(ctx->mdtab_free == 0);
+  pause = gpr_time_sub(gpr_now(), start);
+  ctx->mdtab_gc_steps++;
+  ctx->mdtab_gc_pause_total = gpr_time_add(ctx->mdtab_gc_pause_total, pause);
+  ctx->mdtab_gc_pause_max = gpr_time_max(ctx->mdtab_gc_pause_max, pause);
+}
+
+/* Collection is incremental: once the table is loaded and a good fraction of
+   it is unreferenced, every intern and unref sweeps a few more buckets, so no
+   caller ever pays for a sweep of the whole table. Below that threshold unused
+   elements are left in place to be revived cheaply. */
+static void maybe_gc_mdtab(grpc_mdctx *ctx) {
+  if (ctx->mdtab_count > ctx->mdtab_capacity &&
+      ctx->mdtab_free > ctx->mdtab_capacity / 4) {
+    gc_mdtab(ctx, MDTAB_GC_BUCKETS_PER_OP);
+  }
 }
 
 static void grow_mdtab(grpc_mdctx *ctx) {
@@ -391,12 +496,14 @@ static void grow_mdtab(grpc_mdctx *ctx) {
   gpr_free(ctx->mdtab);
   ctx->mdtab = mdtab;
   ctx->mdtab_capacity = capacity;
+  ctx->mdtab_gc_cursor = 0;
+  ctx->mdtab_grows++;
 }
 
 static void rehash_mdtab(grpc_mdctx *ctx) {
-  if (ctx->mdtab_free > ctx->mdtab_capacity / 4) {
-    gc_mdtab(ctx);
-  } else {
+  /* if most of the load is garbage, leave it to the incremental collector
+     (which is necessarily active at this point) rather than growing */
+  if (ctx->mdtab_count - ctx->mdtab_free > ctx->mdtab_capacity) {
     grow_mdtab(ctx);
   }
 }
@@ -428,6 +535,7 @@ grpc_mdelem *grpc_mdelem_from_metadata_strings(grpc_mdctx *ctx,
   /* not found: create a new pair */
   md = gpr_malloc(sizeof(internal_metadata));
   md->refs = 1;
+  md->interned = 1;
   md->context = ctx;
   md->key = key;
   md->value = value;
@@ -440,6 +548,7 @@ grpc_mdelem *grpc_mdelem_from_metadata_strings(grpc_mdctx *ctx,
   if (ctx->mdtab_count > ctx->mdtab_capacity * 2) {
     rehash_mdtab(ctx);
   }
+  maybe_gc_mdtab(ctx);
 
   unlock(ctx);
 
@@ -468,9 +577,72 @@ grpc_mdelem *grpc_mdelem_from_string_and_buffer(grpc_mdctx *ctx,
       grpc_mdstr_from_buffer(ctx, value, value_length));
 }
 
+grpc_mdelem *grpc_mdelem_from_uninterned_value(grpc_mdctx *ctx,
+                                               grpc_mdstr *mkey,
+                                               const gpr_uint8 *value,
+                                               size_t value_length) {
+  uninterned_metadata *um =
+      gpr_malloc(sizeof(uninterned_metadata) + value_length + 1);
+  internal_metadata *md = &um->md;
+  internal_string *s = &um->value;
+
+  GPR_ASSERT(((internal_string *)mkey)->context == ctx);
+
+  s->refs = 0;
+  s->interned = 0;
+  gpr_atm_rel_store(&s->atomic_refs, 1);
+  s->refcount.ref = uninterned_slice_ref;
+  s->refcount.unref = uninterned_slice_unref;
+  s->slice.refcount = &s->refcount;
+  s->slice.data.refcounted.bytes = (gpr_uint8 *)(um + 1);
+  s->slice.data.refcounted.length = value_length;
+  memcpy(s->slice.data.refcounted.bytes, value, value_length);
+  s->slice.data.refcounted.bytes[value_length] = 0;
+  /* not hashed: the value is never looked up */
+  s->hash = 0;
+  s->has_base64_and_huffman_encoded = 0;
+  s->context = ctx;
+  s->bucket_next = NULL;
+
+  md->key = (internal_string *)mkey;
+  md->value = s;
+  md->user_data = NULL;
+  md->destroy_user_data = NULL;
+  md->refs = 0;
+  md->interned = 0;
+  gpr_atm_rel_store(&md->atomic_refs, 1);
+  md->context = ctx;
+  md->bucket_next = NULL;
+
+  /* the caller's ref on key keeps the context alive until this is counted */
+  gpr_atm_no_barrier_fetch_add(&ctx->uninterned_count, 1);
+
+  return (grpc_mdelem *)md;
+}
+
+static void destroy_uninterned_metadata(internal_metadata *md) {
+  grpc_mdctx *ctx = md->context;
+  lock(ctx);
+  if (md->user_data) {
+    md->destroy_user_data(md->user_data);
+  }
+  internal_string_unref(md->key);
+  /* may free md */
+  internal_string_unref(md->value);
+  unlock(ctx);
+}
+
+int grpc_mdelem_is_interned(grpc_mdelem *gmd) {
+  return ((internal_metadata *)gmd)->interned;
+}
+
 grpc_mdelem *grpc_mdelem_ref(grpc_mdelem *gmd) {
   internal_metadata *md = (internal_metadata *)gmd;
   grpc_mdctx *ctx = md->context;
+  if (!md->interned) {
+    gpr_atm_no_barrier_fetch_add(&md->atomic_refs, 1);
+    return gmd;
+  }
   lock(ctx);
   ref_md(md);
   unlock(ctx);
@@ -480,10 +652,17 @@ grpc_mdelem *grpc_mdelem_ref(grpc_mdelem *gmd) {
 void grpc_mdelem_unref(grpc_mdelem *gmd) {
   internal_metadata *md = (internal_metadata *)gmd;
   grpc_mdctx *ctx = md->context;
+  if (!md->interned) {
+    if (1 == gpr_atm_full_fetch_add(&md->atomic_refs, -1)) {
+      destroy_uninterned_metadata(md);
+    }
+    return;
+  }
   lock(ctx);
   GPR_ASSERT(md->refs);
   if (0 == --md->refs) {
     ctx->mdtab_free++;
+    maybe_gc_mdtab(ctx);
   }
   unlock(ctx);
 }
@@ -495,6 +674,10 @@ const char *grpc_mdstr_as_c_string(grpc_mdstr *s) {
 grpc_mdstr *grpc_mdstr_ref(grpc_mdstr *gs) {
   internal_string *s = (internal_string *)gs;
   grpc_mdctx *ctx = s->context;
+  if (!s->interned) {
+    gpr_atm_no_barrier_fetch_add(&s->atomic_refs, 1);
+    return gs;
+  }
   lock(ctx);
   internal_string_ref(s);
   unlock(ctx);
@@ -504,6 +687,10 @@ grpc_mdstr *grpc_mdstr_ref(grpc_mdstr *gs) {
 void grpc_mdstr_unref(grpc_mdstr *gs) {
   internal_string *s = (internal_string *)gs;
   grpc_mdctx *ctx = s->context;
+  if (!s->interned) {
+    uninterned_string_unref(s);
+    return;
+  }
   lock(ctx);
   internal_string_unref(s);
   unlock(ctx);
@@ -521,6 +708,22 @@ size_t grpc_mdctx_get_mdtab_free_test_only(grpc_mdctx *ctx) {
   return ctx->mdtab_free;
 }
 
+void grpc_mdctx_get_stats(grpc_mdctx *ctx, grpc_mdctx_stats *stats) {
+  lock(ctx);
+  stats->strtab_count = ctx->strtab_count;
+  stats->strtab_capacity = ctx->strtab_capacity;
+  stats->mdtab_count = ctx->mdtab_count;
+  stats->mdtab_free = ctx->mdtab_free;
+  stats->mdtab_capacity = ctx->mdtab_capacity;
+  stats->uninterned_count = gpr_atm_acq_load(&ctx->uninterned_count);
+  stats->mdtab_gc_steps = ctx->mdtab_gc_steps;
+  stats->mdtab_gc_freed = ctx->mdtab_gc_freed;
+  stats->mdtab_grows = ctx->mdtab_grows;
+  stats->mdtab_gc_pause_total = ctx->mdtab_gc_pause_total;
+  stats->mdtab_gc_pause_max = ctx->mdtab_gc_pause_max;
+  unlock(ctx);
+}
+
 void *grpc_mdelem_get_user_data(grpc_mdelem *md,
                                 void (*if_destroy_func)(void *)) {
   internal_metadata *im = (internal_metadata *)md;
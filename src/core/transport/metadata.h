@@ -35,6 +35,7 @@
 #define GRPC_INTERNAL_CORE_TRANSPORT_METADATA_H
 
 #include <grpc/support/slice.h>
+#include <grpc/support/time.h>
 #include <grpc/support/useful.h>
 
 /* This file provides a mechanism for tracking metadata through the grpc stack.
@@ -58,8 +59,9 @@
    ops per metadata element on the fast path.
 
    grpc_mdelem instances MAY live longer than their refcount implies, and are
-   garbage collected periodically, meaning cached data can easily outlive a
-   single request. */
+   garbage collected incrementally once unreferenced elements start to
+   dominate the table, meaning cached data can easily outlive a single
+   request. */
 
 /* Forward declarations */
 typedef struct grpc_mdctx grpc_mdctx;
@@ -93,6 +95,28 @@ size_t grpc_mdctx_get_mdtab_capacity_test_only(grpc_mdctx *mdctx);
 size_t grpc_mdctx_get_mdtab_count_test_only(grpc_mdctx *mdctx);
 size_t grpc_mdctx_get_mdtab_free_test_only(grpc_mdctx *mdctx);
 
+/* Table sizes and garbage collection counters for a metadata context */
+typedef struct grpc_mdctx_stats {
+  size_t strtab_count;
+  size_t strtab_capacity;
+  size_t mdtab_count;
+  size_t mdtab_free;
+  size_t mdtab_capacity;
+  /* number of live non-interned values */
+  size_t uninterned_count;
+  /* number of incremental collection steps run, and elements they freed */
+  gpr_uint64 mdtab_gc_steps;
+  gpr_uint64 mdtab_gc_freed;
+  /* number of times the mdelem table has been resized */
+  gpr_uint64 mdtab_grows;
+  /* time spent collecting under the context lock: in total, and the longest
+     single step */
+  gpr_timespec mdtab_gc_pause_total;
+  gpr_timespec mdtab_gc_pause_max;
+} grpc_mdctx_stats;
+
+void grpc_mdctx_get_stats(grpc_mdctx *mdctx, grpc_mdctx_stats *stats);
+
 /* Constructors for grpc_mdstr instances; take a variety of data types that
    clients may have handy */
 grpc_mdstr *grpc_mdstr_from_string(grpc_mdctx *ctx, const char *str);
@@ -117,6 +141,22 @@ grpc_mdelem *grpc_mdelem_from_string_and_buffer(grpc_mdctx *ctx,
                                                 const gpr_uint8 *value,
                                                 size_t value_length);
 
+/* Create a grpc_mdelem whose value is not interned: for values that are
+   unlikely to be seen twice (request ids, trace spans, bearer tokens), this
+   costs a single allocation with no hashing or locking, and keeps them out of
+   the context's tables. Takes ownership of key.
+   Each call returns a distinct element, and its value is only equal (by
+   pointer) to itself, so never use this for values that are compared by
+   identity (pseudo-headers, content-type, te, ...). The value's hash is
+   zero. */
+grpc_mdelem *grpc_mdelem_from_uninterned_value(grpc_mdctx *ctx,
+                                               grpc_mdstr *key,
+                                               const gpr_uint8 *value,
+                                               size_t value_length);
+
+/* Returns non-zero if md was created by the interning constructors above */
+int grpc_mdelem_is_interned(grpc_mdelem *md);
+
 /* Mutator and accessor for grpc_mdelem user data. The destructor function
    is used as a type tag and is checked during user_data fetch. */
 void *grpc_mdelem_get_user_data(grpc_mdelem *md,
@@ -71,6 +71,42 @@ void grpc_sopb_swap(grpc_stream_op_buffer *a, grpc_stream_op_buffer *b) {
   }
 }
 
+void grpc_sopb_storage_cache_init(grpc_sopb_storage_cache *cache) {
+  cache->count = 0;
+}
+
+void grpc_sopb_storage_cache_destroy(grpc_sopb_storage_cache *cache) {
+  size_t i;
+  for (i = 0; i < cache->count; i++) {
+    gpr_free(cache->entries[i].ops);
+  }
+}
+
+int grpc_sopb_storage_cache_put(grpc_sopb_storage_cache *cache,
+                                grpc_stream_op_buffer *sopb) {
+  GPR_ASSERT(sopb->nops == 0);
+  if (sopb->ops == sopb->inlined_ops ||
+      sopb->capacity > GRPC_SOPB_STORAGE_CACHE_MAX_CAPACITY ||
+      cache->count == GRPC_SOPB_STORAGE_CACHE_SIZE) {
+    return 0;
+  }
+  cache->entries[cache->count].ops = sopb->ops;
+  cache->entries[cache->count].capacity = sopb->capacity;
+  cache->count++;
+  grpc_sopb_init(sopb);
+  return 1;
+}
+
+void grpc_sopb_storage_cache_take(grpc_sopb_storage_cache *cache,
+                                  grpc_stream_op_buffer *sopb) {
+  GPR_ASSERT(sopb->nops == 0);
+  GPR_ASSERT(sopb->ops == sopb->inlined_ops);
+  if (cache->count == 0) return;
+  cache->count--;
+  sopb->ops = cache->entries[cache->count].ops;
+  sopb->capacity = cache->entries[cache->count].capacity;
+}
+
 void grpc_stream_ops_unref_owned_objects(grpc_stream_op *ops, size_t nops) {
   size_t i;
   for (i = 0; i < nops; i++) {
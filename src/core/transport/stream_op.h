@@ -111,6 +111,36 @@ void grpc_sopb_reset(grpc_stream_op_buffer *sopb);
 /* Swap two sopbs */
 void grpc_sopb_swap(grpc_stream_op_buffer *a, grpc_stream_op_buffer *b);
 
+/* Number of op arrays a grpc_sopb_storage_cache holds */
+#define GRPC_SOPB_STORAGE_CACHE_SIZE 16
+/* Op arrays with room for more ops than this are freed rather than cached,
+   so that one outsized batch doesn't pin its memory for good */
+#define GRPC_SOPB_STORAGE_CACHE_MAX_CAPACITY (8 * GRPC_SOPB_INLINE_ELEMENTS)
+
+/* Op arrays of sopbs that outgrew their inline storage, kept so that later
+   sopbs need not grow from scratch. Not thread safe. */
+typedef struct grpc_sopb_storage_cache {
+  struct {
+    grpc_stream_op *ops;
+    size_t capacity;
+  } entries[GRPC_SOPB_STORAGE_CACHE_SIZE];
+  size_t count;
+} grpc_sopb_storage_cache;
+
+void grpc_sopb_storage_cache_init(grpc_sopb_storage_cache *cache);
+/* Frees the cached op arrays */
+void grpc_sopb_storage_cache_destroy(grpc_sopb_storage_cache *cache);
+/* Move the op array of an empty sopb into cache, leaving sopb on its inline
+   storage. Returns 0 and leaves sopb alone if it has no op array of its own,
+   if the array is larger than GRPC_SOPB_STORAGE_CACHE_MAX_CAPACITY, or if
+   cache is full. */
+int grpc_sopb_storage_cache_put(grpc_sopb_storage_cache *cache,
+                                grpc_stream_op_buffer *sopb);
+/* Have an empty sopb on its inline storage use a cached op array instead, if
+   there is one */
+void grpc_sopb_storage_cache_take(grpc_sopb_storage_cache *cache,
+                                  grpc_stream_op_buffer *sopb);
+
 void grpc_stream_ops_unref_owned_objects(grpc_stream_op *ops, size_t nops);
 
 /* Append a GRPC_NO_OP to a buffer */
@@ -69,7 +69,7 @@ void CallOpBuffer::Reset(void* next_return_tag) {
 
   send_initial_metadata_ = false;
   initial_metadata_count_ = 0;
-  gpr_free(initial_metadata_);
+  ReleaseMetadataArray(&initial_metadata_, initial_metadata_storage_);
 
   recv_initial_metadata_ = nullptr;
   recv_initial_metadata_arr_.count = 0;
@@ -97,12 +97,14 @@ void CallOpBuffer::Reset(void* next_return_tag) {
 
   send_status_ = nullptr;
   trailing_metadata_count_ = 0;
-  trailing_metadata_ = nullptr;
+  ReleaseMetadataArray(&trailing_metadata_, trailing_metadata_storage_);
 
   recv_closed_ = nullptr;
 }
 
 CallOpBuffer::~CallOpBuffer() {
+  ReleaseMetadataArray(&initial_metadata_, initial_metadata_storage_);
+  ReleaseMetadataArray(&trailing_metadata_, trailing_metadata_storage_);
   gpr_free(status_details_);
   gpr_free(recv_initial_metadata_arr_.metadata);
   gpr_free(recv_trailing_metadata_arr_.metadata);
@@ -114,16 +116,19 @@ CallOpBuffer::~CallOpBuffer() {
   }
 }
 
-namespace {
 // TODO(yangg) if the map is changed before we send, the pointers will be a
 // mess. Make sure it does not happen.
-grpc_metadata* FillMetadataArray(
-    std::multimap<grpc::string, grpc::string>* metadata) {
+grpc_metadata* CallOpBuffer::FillMetadataArray(
+    std::multimap<grpc::string, grpc::string>* metadata,
+    grpc_metadata* storage) {
   if (metadata->empty()) {
     return nullptr;
   }
   grpc_metadata* metadata_array =
-      (grpc_metadata*)gpr_malloc(metadata->size() * sizeof(grpc_metadata));
+      metadata->size() <= kInlineMetadata
+          ? storage
+          : (grpc_metadata*)gpr_malloc(metadata->size() *
+                                       sizeof(grpc_metadata));
   size_t i = 0;
   for (auto iter = metadata->cbegin(); iter != metadata->cend(); ++iter, ++i) {
     metadata_array[i].key = iter->first.c_str();
@@ -133,6 +138,17 @@ grpc_metadata* FillMetadataArray(
   return metadata_array;
 }
 
+void CallOpBuffer::ReleaseMetadataArray(grpc_metadata** array,
+                                        grpc_metadata* storage) {
+  if (*array != storage) {
+    gpr_free(*array);
+  }
+  *array = nullptr;
+}
+
+namespace {
+// Copies the received metadata out and empties the array, keeping its
+// capacity for the next batch that uses this buffer.
 void FillMetadataMap(grpc_metadata_array* arr,
                      std::multimap<grpc::string, grpc::string>* metadata) {
   for (size_t i = 0; i < arr->count; i++) {
@@ -141,8 +157,7 @@ void FillMetadataMap(grpc_metadata_array* arr,
         arr->metadata[i].key,
         {arr->metadata[i].value, arr->metadata[i].value_length}));
   }
-  grpc_metadata_array_destroy(arr);
-  grpc_metadata_array_init(arr);
+  arr->count = 0;
 }
 }  // namespace
 
@@ -150,7 +165,7 @@ void CallOpBuffer::AddSendInitialMetadata(
     std::multimap<grpc::string, grpc::string>* metadata) {
   send_initial_metadata_ = true;
   initial_metadata_count_ = metadata->size();
-  initial_metadata_ = FillMetadataArray(metadata);
+  initial_metadata_ = FillMetadataArray(metadata, initial_metadata_storage_);
 }
 
 void CallOpBuffer::AddRecvInitialMetadata(ClientContext* ctx) {
@@ -186,7 +201,8 @@ void CallOpBuffer::AddServerSendStatus(
     std::multimap<grpc::string, grpc::string>* metadata, const Status& status) {
   if (metadata != NULL) {
     trailing_metadata_count_ = metadata->size();
-    trailing_metadata_ = FillMetadataArray(metadata);
+    trailing_metadata_ =
+        FillMetadataArray(metadata, trailing_metadata_storage_);
   } else {
     trailing_metadata_count_ = 0;
   }
@@ -260,14 +276,8 @@ bool CallOpBuffer::FinalizeResult(void** tag, bool* status) {
     grpc_byte_buffer_destroy(send_message_buf_);
     send_message_buf_ = nullptr;
   }
-  if (initial_metadata_) {
-    gpr_free(initial_metadata_);
-    initial_metadata_ = nullptr;
-  }
-  if (trailing_metadata_count_) {
-    gpr_free(trailing_metadata_);
-    trailing_metadata_ = nullptr;
-  }
+  ReleaseMetadataArray(&initial_metadata_, initial_metadata_storage_);
+  ReleaseMetadataArray(&trailing_metadata_, trailing_metadata_storage_);
   // Set user-facing tag.
   *tag = return_tag_;
   // Process received initial metadata
@@ -34,21 +34,38 @@
 #include "src/cpp/proto/proto_utils.h"
 #include <grpc++/config.h>
 
+#include <climits>
+#include <cstring>
+
 #include <grpc/grpc.h>
 #include <grpc/byte_buffer.h>
 #include <grpc/support/slice.h>
 #include <grpc/support/slice_buffer.h>
+#include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream.h>
 
-const int kMaxBufferLength = 8192;
+// Messages up to this size are serialized into a single slice of exactly
+// the right size; larger ones into slices of this size plus a right-sized
+// last slice.
+const int kMaxSliceLength = 1024 * 1024;
+
+// Multi-slice messages up to this size are copied into a stack buffer and
+// parsed as one flat array rather than through GrpcBufferReader.
+const size_t kMaxCoalesceLength = 4096;
 
 class GrpcBufferWriter GRPC_FINAL
     : public ::google::protobuf::io::ZeroCopyOutputStream {
  public:
-  explicit GrpcBufferWriter(grpc_byte_buffer **bp,
-                            int block_size = kMaxBufferLength)
-      : block_size_(block_size), byte_count_(0), have_backup_(false) {
+  // total_size is the number of bytes that will be written, so that the
+  // final block can be sized to fit.
+  GrpcBufferWriter(grpc_byte_buffer **bp, gpr_int64 total_size,
+                   int block_size = kMaxSliceLength)
+      : block_size_(block_size),
+        total_size_(total_size),
+        byte_count_(0),
+        have_backup_(false) {
     *bp = grpc_byte_buffer_create(NULL, 0);
     slice_buffer_ = &(*bp)->data.slice_buffer;
   }
@@ -64,7 +81,10 @@ class GrpcBufferWriter GRPC_FINAL
       slice_ = backup_slice_;
       have_backup_ = false;
     } else {
-      slice_ = gpr_slice_malloc(block_size_);
+      gpr_int64 remaining = total_size_ - byte_count_;
+      slice_ = gpr_slice_malloc(remaining > 0 && remaining < block_size_
+                                    ? remaining
+                                    : block_size_);
     }
     *data = GPR_SLICE_START_PTR(slice_);
     byte_count_ += *size = GPR_SLICE_LENGTH(slice_);
@@ -74,7 +94,7 @@ class GrpcBufferWriter GRPC_FINAL
 
   void BackUp(int count) GRPC_OVERRIDE {
     gpr_slice_buffer_pop(slice_buffer_);
-    if (count == block_size_) {
+    if (static_cast<size_t>(count) == GPR_SLICE_LENGTH(slice_)) {
       backup_slice_ = slice_;
     } else {
       backup_slice_ =
@@ -89,6 +109,7 @@ class GrpcBufferWriter GRPC_FINAL
 
  private:
   const int block_size_;
+  const gpr_int64 total_size_;
   gpr_int64 byte_count_;
   gpr_slice_buffer *slice_buffer_;
   bool have_backup_;
@@ -156,12 +177,76 @@ class GrpcBufferReader GRPC_FINAL
 
 namespace grpc {
 
+namespace {
+
+// protobuf 3.1 added ByteSizeLong and deprecated the int returning ByteSize.
+size_t MessageByteSize(const grpc::protobuf::Message &msg) {
+#if GOOGLE_PROTOBUF_VERSION >= 3001000
+  return msg.ByteSizeLong();
+#else
+  return msg.ByteSize();
+#endif
+}
+
+}  // namespace
+
 bool SerializeProto(const grpc::protobuf::Message &msg, grpc_byte_buffer **bp) {
-  GrpcBufferWriter writer(bp);
-  return msg.SerializeToZeroCopyStream(&writer);
+  // The serializers below write whatever fields are set; refuse messages
+  // missing required fields, as SerializeToZeroCopyStream would.
+  if (!msg.IsInitialized()) {
+    gpr_log(GPR_ERROR, "Cannot serialize %s: missing required fields %s",
+            msg.GetTypeName().c_str(),
+            msg.InitializationErrorString().c_str());
+    return false;
+  }
+  size_t byte_size = MessageByteSize(msg);
+  if (byte_size > static_cast<size_t>(INT_MAX)) {
+    gpr_log(GPR_ERROR, "Cannot serialize %s: %lu bytes is too large",
+            msg.GetTypeName().c_str(), static_cast<unsigned long>(byte_size));
+    return false;
+  }
+  if (byte_size <= static_cast<size_t>(kMaxSliceLength)) {
+    // Serialize straight into one exactly sized slice.
+    *bp = grpc_byte_buffer_create(NULL, 0);
+    if (byte_size > 0) {
+      gpr_slice slice = gpr_slice_malloc(byte_size);
+      gpr_uint8 *end =
+          msg.SerializeWithCachedSizesToArray(GPR_SLICE_START_PTR(slice));
+      GPR_ASSERT(end == GPR_SLICE_END_PTR(slice));
+      gpr_slice_buffer_add(&(*bp)->data.slice_buffer, slice);
+    }
+    return true;
+  }
+  GrpcBufferWriter writer(bp, static_cast<gpr_int64>(byte_size));
+  ::google::protobuf::io::CodedOutputStream output(&writer);
+  msg.SerializeWithCachedSizes(&output);
+  return !output.HadError();
 }
 
 bool DeserializeProto(grpc_byte_buffer *buffer, grpc::protobuf::Message *msg) {
+  if (buffer->type == GRPC_BB_SLICE_BUFFER) {
+    gpr_slice_buffer *slices = &buffer->data.slice_buffer;
+    if (slices->count == 0) {
+      return msg->ParseFromArray(NULL, 0);
+    }
+    if (slices->count == 1 &&
+        GPR_SLICE_LENGTH(slices->slices[0]) <= static_cast<size_t>(INT_MAX)) {
+      // Common case: the whole message is contiguous, so let protobuf use
+      // its flat array parser.
+      return msg->ParseFromArray(GPR_SLICE_START_PTR(slices->slices[0]),
+                                 GPR_SLICE_LENGTH(slices->slices[0]));
+    }
+    if (slices->length <= kMaxCoalesceLength) {
+      gpr_uint8 flat[kMaxCoalesceLength];
+      gpr_uint8 *p = flat;
+      for (size_t i = 0; i < slices->count; i++) {
+        memcpy(p, GPR_SLICE_START_PTR(slices->slices[i]),
+               GPR_SLICE_LENGTH(slices->slices[i]));
+        p += GPR_SLICE_LENGTH(slices->slices[i]);
+      }
+      return msg->ParseFromArray(flat, slices->length);
+    }
+  }
   GrpcBufferReader reader(buffer);
   return msg->ParseFromZeroCopyStream(&reader);
 }
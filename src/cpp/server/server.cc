@@ -45,15 +45,17 @@
 #include <grpc++/thread_pool_interface.h>
 
 #include "src/cpp/proto/proto_utils.h"
+#include "src/cpp/util/free_list.h"
 #include "src/cpp/util/time.h"
 
 namespace grpc {
 
 class Server::SyncRequest GRPC_FINAL : public CompletionQueueTag {
  public:
-  SyncRequest(RpcServiceMethod* method, void* tag)
+  SyncRequest(RpcServiceMethod* method, void* tag, CompletionQueue* notify_cq)
       : method_(method),
         tag_(tag),
+        notify_cq_(notify_cq),
         in_flight_(false),
         has_request_payload_(method->method_type() == RpcMethod::NORMAL_RPC ||
                              method->method_type() ==
@@ -75,15 +77,26 @@ class Server::SyncRequest GRPC_FINAL : public CompletionQueueTag {
     return mrd;
   }
 
-  void Request(grpc_server* server) {
+  // Returns false, leaving the method without a request for this queue, if
+  // the server already has GRPC_MAX_REQUESTED_CALLS calls requested.
+  bool Request(grpc_server* server) {
     GPR_ASSERT(!in_flight_);
+    // Set first: the call may be delivered before the request returns.
     in_flight_ = true;
     cq_ = grpc_completion_queue_create();
-    GPR_ASSERT(GRPC_CALL_OK ==
-               grpc_server_request_registered_call(
-                   server, tag_, &call_, &deadline_, &request_metadata_,
-                   has_request_payload_ ? &request_payload_ : nullptr, cq_,
-                   this));
+    grpc_call_error error = grpc_server_request_registered_call(
+        server, tag_, &call_, &deadline_, &request_metadata_,
+        has_request_payload_ ? &request_payload_ : nullptr, cq_,
+        notify_cq_->cq(), this);
+    if (error != GRPC_CALL_OK) {
+      gpr_log(GPR_ERROR, "Failed to request a call for %s: error %d",
+              method_->name(), error);
+      grpc_completion_queue_destroy(cq_);
+      cq_ = nullptr;
+      in_flight_ = false;
+      return false;
+    }
+    return true;
   }
 
   bool FinalizeResult(void** tag, bool* status) GRPC_OVERRIDE {
@@ -160,6 +173,8 @@ class Server::SyncRequest GRPC_FINAL : public CompletionQueueTag {
  private:
   RpcServiceMethod* const method_;
   void* const tag_;
+  // The server completion queue this request is reported on.
+  CompletionQueue* const notify_cq_;
   bool in_flight_;
   const bool has_request_payload_;
   const bool has_response_payload_;
@@ -170,13 +185,19 @@ class Server::SyncRequest GRPC_FINAL : public CompletionQueueTag {
   grpc_completion_queue* cq_;
 };
 
-Server::Server(ThreadPoolInterface* thread_pool, bool thread_pool_owned)
+Server::Server(ThreadPoolInterface* thread_pool, bool thread_pool_owned,
+               int num_sync_cqs)
     : started_(false),
       shutdown_(false),
       num_running_cb_(0),
       server_(grpc_server_create(cq_.cq(), nullptr)),
       thread_pool_(thread_pool),
-      thread_pool_owned_(thread_pool_owned) {}
+      thread_pool_owned_(thread_pool_owned) {
+  for (int i = 0; i < num_sync_cqs; i++) {
+    sync_cqs_.emplace_back(new CompletionQueue());
+    grpc_server_register_completion_queue(server_, sync_cqs_.back()->cq());
+  }
+}
 
 Server::~Server() {
   std::unique_lock<std::mutex> lock(mu_);
@@ -202,7 +223,11 @@ bool Server::RegisterService(RpcService* service) {
               method->name());
       return false;
     }
-    sync_methods_.emplace_back(method, tag);
+    // Each sync completion queue gets its own outstanding request for every
+    // method, so that an incoming call can be picked up from any of them.
+    for (auto& cq : sync_cqs_) {
+      sync_methods_.emplace_back(method, tag, cq.get());
+    }
   }
   return true;
 }
@@ -242,7 +267,9 @@ bool Server::Start() {
       m.Request(server_);
     }
 
-    ScheduleCallback();
+    for (auto& cq : sync_cqs_) {
+      ScheduleCallback(cq.get());
+    }
   }
 
   return true;
@@ -254,6 +281,9 @@ void Server::Shutdown() {
     shutdown_ = true;
     grpc_server_shutdown(server_);
     cq_.Shutdown();
+    for (auto& cq : sync_cqs_) {
+      cq->Shutdown();
+    }
 
     // Wait for running callbacks to finish.
     while (num_running_cb_ != 0) {
@@ -282,20 +312,31 @@ class Server::AsyncRequest GRPC_FINAL : public CompletionQueueTag {
  public:
   AsyncRequest(Server* server, void* registered_method, ServerContext* ctx,
                grpc::protobuf::Message* request,
-               ServerAsyncStreamingInterface* stream, CompletionQueue* cq,
-               void* tag)
+               ServerAsyncStreamingInterface* stream, CompletionQueue* call_cq,
+               CompletionQueue* notification_cq, void* tag)
       : tag_(tag),
         request_(request),
         stream_(stream),
-        cq_(cq),
+        cq_(call_cq),
         ctx_(ctx),
         server_(server),
         call_(nullptr),
         payload_(nullptr) {
     memset(&array_, 0, sizeof(array_));
-    grpc_server_request_registered_call(
-        server->server_, registered_method, &call_, &deadline_, &array_,
-        request ? &payload_ : nullptr, cq->cq(), this);
+  }
+
+  // Returns false if the server already has GRPC_MAX_REQUESTED_CALLS calls
+  // requested; the request then never completes.
+  bool Request(void* registered_method, CompletionQueue* notification_cq) {
+    grpc_call_error error = grpc_server_request_registered_call(
+        server_->server_, registered_method, &call_, &deadline_, &array_,
+        request_ ? &payload_ : nullptr, cq_->cq(), notification_cq->cq(),
+        this);
+    if (error != GRPC_CALL_OK) {
+      gpr_log(GPR_ERROR, "Failed to request an async call: error %d", error);
+      return false;
+    }
+    return true;
   }
 
   ~AsyncRequest() {
@@ -305,6 +346,14 @@ class Server::AsyncRequest GRPC_FINAL : public CompletionQueueTag {
     grpc_metadata_array_destroy(&array_);
   }
 
+  // One request is created for every async rpc; reuse their memory.
+  static void* operator new(size_t size) {
+    return FreeList<AsyncRequest>::Allocate(size);
+  }
+  static void operator delete(void* p, size_t size) {
+    FreeList<AsyncRequest>::Free(p, size);
+  }
+
   bool FinalizeResult(void** tag, bool* status) GRPC_OVERRIDE {
     *tag = tag_;
     bool orig_status = *status;
@@ -352,29 +401,42 @@ class Server::AsyncRequest GRPC_FINAL : public CompletionQueueTag {
 void Server::RequestAsyncCall(void* registered_method, ServerContext* context,
                               grpc::protobuf::Message* request,
                               ServerAsyncStreamingInterface* stream,
-                              CompletionQueue* cq, void* tag) {
-  new AsyncRequest(this, registered_method, context, request, stream, cq, tag);
+                              CompletionQueue* call_cq,
+                              CompletionQueue* notification_cq, void* tag) {
+  AsyncRequest* async_request =
+      new AsyncRequest(this, registered_method, context, request, stream,
+                       call_cq, notification_cq, tag);
+  if (!async_request->Request(registered_method, notification_cq)) {
+    delete async_request;
+  }
 }
 
-void Server::ScheduleCallback() {
+void Server::ScheduleCallback(CompletionQueue* cq) {
   {
     std::unique_lock<std::mutex> lock(mu_);
     num_running_cb_++;
   }
-  thread_pool_->ScheduleCallback(std::bind(&Server::RunRpc, this));
+  // A lambda capturing two pointers fits in std::function's inline storage,
+  // so scheduling does not allocate.
+  thread_pool_->ScheduleCallback([this, cq]() { RunRpc(cq); });
 }
 
-void Server::RunRpc() {
+void Server::RunRpc(CompletionQueue* cq) {
   // Wait for one more incoming rpc.
   bool ok;
-  auto* mrd = SyncRequest::Wait(&cq_, &ok);
+  auto* mrd = SyncRequest::Wait(cq, &ok);
   if (mrd) {
-    ScheduleCallback();
+    ScheduleCallback(cq);
     if (ok) {
       SyncRequest::CallData cd(this, mrd);
-      mrd->Request(server_);
+      bool requested = mrd->Request(server_);
 
       cd.Run();
+      if (!requested) {
+        // Async requests may have been matched while the call ran. If this
+        // fails too, the method takes no more calls on this queue.
+        mrd->Request(server_);
+      }
     }
   }
 
@@ -33,6 +33,8 @@
 
 #include <grpc++/server_builder.h>
 
+#include <algorithm>
+
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc++/impl/service_type.h>
@@ -41,7 +43,11 @@
 
 namespace grpc {
 
-ServerBuilder::ServerBuilder() : thread_pool_(nullptr) {}
+ServerBuilder::ServerBuilder()
+    : thread_pool_(nullptr),
+      num_sync_cqs_(1),
+      min_threads_(0),
+      max_threads_(0) {}
 
 void ServerBuilder::RegisterService(SynchronousService* service) {
   services_.push_back(service->service());
@@ -61,6 +67,17 @@ void ServerBuilder::SetThreadPool(ThreadPoolInterface* thread_pool) {
   thread_pool_ = thread_pool;
 }
 
+void ServerBuilder::SetThreadPoolSize(int min_threads, int max_threads) {
+  GPR_ASSERT(min_threads > 0 && min_threads <= max_threads);
+  min_threads_ = min_threads;
+  max_threads_ = max_threads;
+}
+
+void ServerBuilder::SetNumSyncCompletionQueues(int num_cqs) {
+  GPR_ASSERT(num_cqs > 0);
+  num_sync_cqs_ = num_cqs;
+}
+
 std::unique_ptr<Server> ServerBuilder::BuildAndStart() {
   bool thread_pool_owned = false;
   if (!async_services_.empty() && !services_.empty()) {
@@ -68,12 +85,30 @@ std::unique_ptr<Server> ServerBuilder::BuildAndStart() {
     return nullptr;
   }
   if (!thread_pool_ && !services_.empty()) {
-    int cores = gpr_cpu_num_cores();
-    if (!cores) cores = 4;
-    thread_pool_ = new ThreadPool(cores);
+    int min_threads = min_threads_;
+    int max_threads = max_threads_;
+    if (!min_threads) {
+      int cores = gpr_cpu_num_cores();
+      if (!cores) cores = 4;
+      // Each completion queue keeps a thread waiting on it; the rest run
+      // handlers.
+      min_threads = num_sync_cqs_ + 1;
+      max_threads = std::max(min_threads, 4 * cores + num_sync_cqs_);
+    } else if (max_threads <= num_sync_cqs_) {
+      // Each completion queue keeps a thread waiting on it, so with no
+      // thread left over some queues would go unserved while rpcs run.
+      gpr_log(GPR_INFO,
+              "Raising max threads from %d to %d to serve %d sync completion "
+              "queues",
+              max_threads, num_sync_cqs_ + 1, num_sync_cqs_);
+      max_threads = num_sync_cqs_ + 1;
+    }
+    thread_pool_ = new ThreadPool(min_threads, max_threads);
     thread_pool_owned = true;
   }
-  std::unique_ptr<Server> server(new Server(thread_pool_, thread_pool_owned));
+  std::unique_ptr<Server> server(
+      new Server(thread_pool_, thread_pool_owned,
+                 services_.empty() ? 0 : num_sync_cqs_));
   for (auto* service : services_) {
     if (!server->RegisterService(service)) {
       return nullptr;
@@ -38,6 +38,7 @@
 #include <grpc++/impl/call.h>
 #include <grpc/grpc.h>
 #include <grpc/support/log.h>
+#include "src/cpp/util/free_list.h"
 #include "src/cpp/util/time.h"
 
 namespace grpc {
@@ -56,6 +57,14 @@ class ServerContext::CompletionOp GRPC_FINAL : public CallOpBuffer {
 
   void Unref();
 
+  // One op is created for every rpc; reuse their memory.
+  static void* operator new(size_t size) {
+    return FreeList<CompletionOp>::Allocate(size);
+  }
+  static void operator delete(void* p, size_t size) {
+    FreeList<CompletionOp>::Free(p, size);
+  }
+
  private:
   std::mutex mu_;
   int refs_;
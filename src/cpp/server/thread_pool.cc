@@ -33,30 +33,151 @@
 
 #include "src/cpp/server/thread_pool.h"
 
+#include <algorithm>
+#include <utility>
+
+#include <grpc/support/log.h>
+
 namespace grpc {
 
-ThreadPool::ThreadPool(int num_threads) : shutdown_(false) {
-  for (int i = 0; i < num_threads; i++) {
-    threads_.push_back(std::thread([this]() {
-      for (;;) {
-        // Wait until work is available or we are shutting down.
-        auto have_work = [this]() { return shutdown_ || !callbacks_.empty(); };
-        std::unique_lock<std::mutex> lock(mu_);
-        if (!have_work()) {
-          cv_.wait(lock, have_work);
+namespace {
+
+// How many times an idle thread checks for new work before sleeping.
+const int kSpinCount = 1000;
+// How long a callback may wait in a queue before the pool grows.
+const std::chrono::milliseconds kMaxQueueDelay(10);
+// How long a thread above the minimum may sleep before it exits.
+const std::chrono::seconds kIdleTimeout(30);
+
+}  // namespace
+
+// A thread slot and its queue of callbacks. The queue is a bounded
+// multi-producer, multi-consumer ring: each slot carries a sequence number
+// that says whether it is free for the producer claiming position pos
+// (sequence == pos) or holds a callback for the consumer claiming pos
+// (sequence == pos + 1). Producers and consumers claim positions with a
+// compare and swap, so the owner, other threads scheduling onto this queue
+// and thieves never take a lock.
+class ThreadPool::Worker GRPC_FINAL {
+ public:
+  explicit Worker(size_t i)
+      : index(i), active(false), enqueue_pos_(0), dequeue_pos_(0) {
+    for (size_t pos = 0; pos < kCapacity; pos++) {
+      slots_[pos].sequence.store(pos, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false if the queue is full.
+  bool Push(const std::function<void()>& callback) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[pos & (kCapacity - 1)];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
         }
-        // Drain callbacks before considering shutdown to ensure all work
-        // gets completed.
-        if (!callbacks_.empty()) {
-          auto cb = callbacks_.front();
-          callbacks_.pop();
-          lock.unlock();
-          cb();
-        } else if (shutdown_) {
-          return;
+      } else if (sequence < pos) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->callback = callback;
+    auto now = std::chrono::steady_clock::now();
+    slot->queued.store(now.time_since_epoch().count(),
+                       std::memory_order_relaxed);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Takes the oldest callback. Returns false if the queue is empty.
+  bool Pop(std::function<void()>* callback) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[pos & (kCapacity - 1)];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      if (sequence == pos + 1) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
         }
+      } else if (sequence < pos + 1) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
       }
-    }));
+    }
+    *callback = std::move(slot->callback);
+    slot->callback = nullptr;
+    slot->sequence.store(pos + kCapacity, std::memory_order_release);
+    return true;
+  }
+
+  // When the oldest queued callback was scheduled, if there is one. Racing
+  // with Pop may report a slightly newer callback, which is good enough to
+  // decide whether the pool should grow.
+  bool OldestQueued(std::chrono::steady_clock::time_point* queued) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[pos & (kCapacity - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+      return false;
+    }
+    *queued = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(
+            slot.queued.load(std::memory_order_relaxed)));
+    return true;
+  }
+
+  // Position in ThreadPool::workers_.
+  const size_t index;
+  // The following are protected by ThreadPool::mu_.
+  bool active;
+  std::thread thread;
+
+ private:
+  // Must be a power of two.
+  static const size_t kCapacity = 256;
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::function<void()> callback;
+    std::atomic<std::chrono::steady_clock::rep> queued;
+  };
+
+  Slot slots_[kCapacity];
+  std::atomic<size_t> enqueue_pos_;
+  std::atomic<size_t> dequeue_pos_;
+};
+
+thread_local ThreadPool::Worker* ThreadPool::current_worker_ = nullptr;
+
+ThreadPool::ThreadPool(int num_threads)
+    : ThreadPool(num_threads, num_threads) {}
+
+ThreadPool::ThreadPool(int min_threads, int max_threads)
+    : min_threads_(min_threads),
+      max_threads_(max_threads),
+      num_slots_(0),
+      pending_(0),
+      next_queue_(0),
+      num_sleeping_(0),
+      has_overflow_(false),
+      shutdown_(false),
+      num_threads_(0) {
+  GPR_ASSERT(min_threads > 0 && min_threads <= max_threads);
+  for (int i = 0; i < max_threads; i++) {
+    workers_.emplace_back(new Worker(i));
+  }
+  std::lock_guard<std::mutex> lock(mu_);
+  for (int i = 0; i < min_threads; i++) {
+    StartThread();
+  }
+  if (max_threads > min_threads) {
+    supervisor_ = std::thread([this]() { SupervisorLoop(); });
   }
 }
 
@@ -65,16 +186,165 @@ ThreadPool::~ThreadPool() {
     std::lock_guard<std::mutex> lock(mu_);
     shutdown_ = true;
     cv_.notify_all();
+    supervisor_cv_.notify_all();
   }
-  for (auto &t : threads_) {
-    t.join();
+  // No threads are started once the supervisor has exited.
+  if (supervisor_.joinable()) {
+    supervisor_.join();
+  }
+  for (auto& w : workers_) {
+    if (w->thread.joinable()) {
+      w->thread.join();
+    }
   }
 }
 
-void ThreadPool::ScheduleCallback(const std::function<void()> &callback) {
+void ThreadPool::ScheduleCallback(const std::function<void()>& callback) {
+  Worker* worker = CurrentWorker();
+  if (worker == nullptr) {
+    worker = workers_[next_queue_++ % num_slots_].get();
+  }
+  bool pushed = worker->Push(callback);
+  size_t num_slots = num_slots_;
+  for (size_t i = 1; i < num_slots && !pushed; i++) {
+    pushed = workers_[(worker->index + i) % num_slots]->Push(callback);
+  }
+  if (!pushed) {
+    std::lock_guard<std::mutex> lock(mu_);
+    overflow_.push_back(callback);
+    has_overflow_ = true;
+  }
+  pending_++;
+  // A thread about to sleep increments num_sleeping_ before it checks
+  // pending_ under mu_, so either it sees this callback or we see it here.
+  if (num_sleeping_ > 0) {
+    std::lock_guard<std::mutex> lock(mu_);
+    cv_.notify_one();
+  }
+}
+
+int ThreadPool::num_threads() {
   std::lock_guard<std::mutex> lock(mu_);
-  callbacks_.push(callback);
-  cv_.notify_one();
+  return num_threads_;
+}
+
+void ThreadPool::WorkerLoop(Worker* worker) {
+  current_worker_ = worker;
+  std::function<void()> callback;
+  for (;;) {
+    if (TakeWork(worker, &callback)) {
+      callback();
+      callback = nullptr;
+    } else if (!WaitForWork(worker)) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::TakeWork(Worker* worker, std::function<void()>* callback) {
+  if (pending_ == 0) {
+    return false;
+  }
+  bool found = worker->Pop(callback);
+  // Start with the next slot so that thieves spread across the queues.
+  size_t num_slots = num_slots_;
+  for (size_t i = 1; i < num_slots && !found; i++) {
+    Worker* victim = workers_[(worker->index + i) % num_slots].get();
+    found = victim->Pop(callback);
+  }
+  if (!found && has_overflow_) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!overflow_.empty()) {
+      *callback = std::move(overflow_.front());
+      overflow_.pop_front();
+      found = true;
+    }
+    has_overflow_ = !overflow_.empty();
+  }
+  if (found) {
+    pending_--;
+  }
+  return found;
+}
+
+bool ThreadPool::WaitForWork(Worker* worker) {
+  for (int i = 0; i < kSpinCount; i++) {
+    if (pending_ > 0) {
+      return true;
+    }
+    std::this_thread::yield();
+  }
+  std::unique_lock<std::mutex> lock(mu_);
+  num_sleeping_++;
+  bool woken = cv_.wait_for(lock, kIdleTimeout,
+                            [this]() { return shutdown_ || pending_ > 0; });
+  num_sleeping_--;
+  if (pending_ > 0) {
+    return true;
+  }
+  if (shutdown_ || (!woken && num_threads_ > min_threads_)) {
+    // The thread object is joined by the destructor, or by StartThread when
+    // the slot is reused.
+    worker->active = false;
+    num_threads_--;
+    return false;
+  }
+  return true;
+}
+
+ThreadPool::Worker* ThreadPool::CurrentWorker() {
+  Worker* worker = current_worker_;
+  if (worker != nullptr && worker->index < workers_.size() &&
+      workers_[worker->index].get() == worker) {
+    return worker;
+  }
+  return nullptr;
+}
+
+void ThreadPool::SupervisorLoop() {
+  std::unique_lock<std::mutex> lock(mu_);
+  while (!shutdown_) {
+    supervisor_cv_.wait_for(lock, kMaxQueueDelay / 2);
+    if (shutdown_ || num_threads_ == max_threads_ || pending_ == 0) {
+      continue;
+    }
+    if (!overflow_.empty()) {
+      // Every queue is full.
+      StartThread();
+      continue;
+    }
+    auto now = std::chrono::steady_clock::now();
+    size_t num_slots = num_slots_;
+    for (size_t i = 0; i < num_slots; i++) {
+      std::chrono::steady_clock::time_point queued;
+      if (workers_[i]->OldestQueued(&queued) &&
+          now - queued >= kMaxQueueDelay) {
+        StartThread();
+        break;
+      }
+    }
+  }
+}
+
+void ThreadPool::StartThread() {
+  for (auto& w : workers_) {
+    if (!w->active) {
+      Worker* worker = w.get();
+      if (worker->thread.joinable()) {
+        // The previous thread on this slot has marked it inactive under mu_
+        // and does not touch the pool again.
+        worker->thread.join();
+      }
+      worker->active = true;
+      if (worker->index >= num_slots_) {
+        num_slots_ = worker->index + 1;
+      }
+      num_threads_++;
+      worker->thread = std::thread([this, worker]() { WorkerLoop(worker); });
+      return;
+    }
+  }
+  GPR_ASSERT(false);
 }
 
 }  // namespace grpc
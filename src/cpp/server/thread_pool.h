@@ -37,27 +37,89 @@
 #include <grpc++/config.h>
 #include <grpc++/thread_pool_interface.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <thread>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <thread>
 #include <vector>
 
 namespace grpc {
 
+// A work-stealing thread pool. Each thread has its own queue of callbacks:
+// callbacks scheduled from a pool thread go to that thread's queue, others
+// are spread across the queues round robin. A thread runs the work on its
+// own queue first and steals from other queues when its own is empty. Idle
+// threads spin briefly before going to sleep.
+//
+// The queues are fixed-size lock-free rings whose slots are allocated with
+// the pool, so scheduling a callback takes no lock and, for callbacks small
+// enough for std::function to store inline, makes no heap allocation. When
+// every ring is full, callbacks wait in a shared locked overflow queue.
+//
+// The pool keeps between min_threads and max_threads threads. A thread is
+// added when a queued callback has waited longer than a short delay (all
+// threads are busy), and a thread above min_threads exits after it has been
+// idle for a while.
 class ThreadPool GRPC_FINAL : public ThreadPoolInterface {
  public:
   explicit ThreadPool(int num_threads);
+  ThreadPool(int min_threads, int max_threads);
   ~ThreadPool();
 
-  void ScheduleCallback(const std::function<void()> &callback) GRPC_OVERRIDE;
+  void ScheduleCallback(const std::function<void()>& callback) GRPC_OVERRIDE;
+
+  // The number of threads currently in the pool.
+  int num_threads();
 
  private:
+  class Worker;
+
+  void WorkerLoop(Worker* worker);
+  // Take a callback from worker's own queue, or steal one from another
+  // thread's queue. Returns false if no work was found.
+  bool TakeWork(Worker* worker, std::function<void()>* callback);
+  // Wait until there may be work to take. Returns false when the thread
+  // should exit: the pool is shutting down and all work has been drained,
+  // or the thread has been idle and the pool is above min_threads_.
+  bool WaitForWork(Worker* worker);
+  // The worker of this pool running on the calling thread, or nullptr.
+  Worker* CurrentWorker();
+  // Grows the pool while callbacks are waiting too long to run.
+  void SupervisorLoop();
+  // Start a thread on an unused worker slot. Requires mu_.
+  void StartThread();
+
+  const int min_threads_;
+  const int max_threads_;
+
+  // One slot per possible thread. Queues of slots without a running thread
+  // may still hold callbacks, which the running threads steal.
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Number of slots that have ever had a thread; only these are scanned.
+  std::atomic<size_t> num_slots_;
+  // Number of callbacks scheduled but not yet taken by a thread.
+  std::atomic<int> pending_;
+  // Used to pick a queue for callbacks scheduled from outside the pool.
+  std::atomic<unsigned> next_queue_;
+  std::atomic<int> num_sleeping_;
+  // Whether overflow_ may be non-empty.
+  std::atomic<bool> has_overflow_;
+
+  // The worker running on the calling thread, in whichever pool.
+  static thread_local Worker* current_worker_;
+
   std::mutex mu_;
+  // Callbacks scheduled while every queue was full.
+  std::deque<std::function<void()>> overflow_;
   std::condition_variable cv_;
+  std::condition_variable supervisor_cv_;
   bool shutdown_;
-  std::queue<std::function<void()>> callbacks_;
-  std::vector<std::thread> threads_;
+  int num_threads_;
+  std::thread supervisor_;
 };
 
 }  // namespace grpc
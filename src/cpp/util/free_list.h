@@ -0,0 +1,137 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef GRPC_INTERNAL_CPP_UTIL_FREE_LIST_H
+#define GRPC_INTERNAL_CPP_UTIL_FREE_LIST_H
+
+#include <new>
+
+namespace grpc {
+
+// Recycles the memory of objects of class T, which is created and destroyed
+// for every rpc. T routes its class-specific operator new and delete here,
+// so steady state traffic does not go back to the heap. Each thread keeps
+// its own list of at most kMaxFreePerThread blocks, so threads never
+// contend. A block freed on another thread than the one that allocated it
+// lands in the freeing thread's list; once that list is full, further
+// blocks go back to the heap.
+//
+// The per-thread list is plain data with no destructor, so it stays usable
+// for the whole life of the thread. The first block a thread keeps
+// registers a teardown that returns the list to the heap when the thread
+// exits; from then on that thread's blocks go straight to the heap.
+template <class T>
+class FreeList {
+ public:
+  static void* Allocate(size_t size) {
+    if (size == sizeof(T)) {
+      Cache* cache = LocalCache();
+      if (cache->head != nullptr) {
+        Block* block = cache->head;
+        cache->head = block->next;
+        cache->num_free--;
+        return block;
+      }
+    }
+    return ::operator new(size);
+  }
+
+  static void Free(void* p, size_t size) {
+    if (p == nullptr) {
+      return;
+    }
+    if (size == sizeof(T)) {
+      Cache* cache = LocalCache();
+      if (!cache->released && cache->num_free < kMaxFreePerThread) {
+        if (!cache->registered) {
+          RegisterTeardown();
+          cache->registered = true;
+        }
+        Block* block = static_cast<Block*>(p);
+        block->next = cache->head;
+        cache->head = block;
+        cache->num_free++;
+        return;
+      }
+    }
+    ::operator delete(p);
+  }
+
+  // Returns the calling thread's blocks to the heap. Blocks freed on this
+  // thread afterwards are not kept.
+  static void ReleaseThreadCache() {
+    Cache* cache = LocalCache();
+    while (cache->head != nullptr) {
+      Block* block = cache->head;
+      cache->head = block->next;
+      ::operator delete(block);
+    }
+    cache->num_free = 0;
+    cache->released = true;
+  }
+
+  static const size_t kMaxFreePerThread = 64;
+
+ private:
+  struct Block {
+    Block* next;
+  };
+
+  // Trivially destructible, so it is never used after a destructor ran.
+  struct Cache {
+    Block* head;
+    size_t num_free;
+    bool registered;
+    bool released;
+  };
+
+  struct Teardown {
+    ~Teardown() { ReleaseThreadCache(); }
+  };
+
+  static Cache* LocalCache() {
+    static thread_local Cache cache;
+    return &cache;
+  }
+
+  // Constructs this thread's Teardown, which schedules its destructor for
+  // thread exit.
+  static void RegisterTeardown() {
+    static thread_local Teardown teardown;
+    (void)teardown;
+  }
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_UTIL_FREE_LIST_H
@@ -34,10 +34,15 @@
 #include <string.h>
 #include <malloc.h>
 
+#include <vector>
+
 #include <node.h>
 #include <nan.h>
+#include <uv.h>
 #include "grpc/grpc.h"
+#include "grpc/support/log.h"
 #include "grpc/support/slice.h"
+#include "grpc/support/sync.h"
 
 #include "byte_buffer.h"
 
@@ -49,14 +54,96 @@ using v8::Function;
 using v8::Handle;
 using v8::Object;
 using v8::Number;
+using v8::Persistent;
 using v8::Value;
 
+namespace {
+
+/* Buffers shorter than this are copied: pinning costs more than copying */
+const size_t kMinZeroCopyLength = 4096;
+
+/* The refcount of a slice that points into a JS Buffer's memory, keeping the
+   Buffer alive for as long as grpc holds the slice. */
+struct PinnedBuffer {
+  gpr_slice_refcount base;
+  gpr_refcount refs;
+  Persistent<Value> buffer;
+};
+
+/* The last unref may come from any thread, but the Buffer can only be
+   released on the main thread, so releases are queued up for it */
+uv_mutex_t unpin_mu;
+std::vector<PinnedBuffer *> *to_unpin;
+uv_async_t unpin_async;
+
+void PinnedBufferRef(void *p) {
+  gpr_ref(&static_cast<PinnedBuffer *>(p)->refs);
+}
+
+void PinnedBufferUnref(void *p) {
+  PinnedBuffer *pin = static_cast<PinnedBuffer *>(p);
+  if (gpr_unref(&pin->refs)) {
+    uv_mutex_lock(&unpin_mu);
+    to_unpin->push_back(pin);
+    uv_mutex_unlock(&unpin_mu);
+    uv_async_send(&unpin_async);
+  }
+}
+
+#if UV_VERSION_MAJOR == 0
+void UnpinBuffers(uv_async_t *handle, int status) {
+#else
+void UnpinBuffers(uv_async_t *handle) {
+#endif
+  NanScope();
+  std::vector<PinnedBuffer *> pins;
+  uv_mutex_lock(&unpin_mu);
+  pins.swap(*to_unpin);
+  uv_mutex_unlock(&unpin_mu);
+  for (size_t i = 0; i < pins.size(); i++) {
+    NanDisposePersistent(pins[i]->buffer);
+    delete pins[i];
+  }
+}
+
+/* Releases the slice backing a Buffer made by ByteBufferToBuffer */
+void FreeSlice(char *data, void *hint) {
+  gpr_slice *slice = static_cast<gpr_slice *>(hint);
+  gpr_slice_unref(*slice);
+  delete slice;
+}
+
+void FreeCopy(char *data, void *hint) { free(data); }
+
+}  // namespace
+
+void InitByteBuffer() {
+  to_unpin = new std::vector<PinnedBuffer *>();
+  GPR_ASSERT(uv_mutex_init(&unpin_mu) == 0);
+  GPR_ASSERT(uv_async_init(uv_default_loop(), &unpin_async, UnpinBuffers) ==
+             0);
+  /* pending releases should not keep the process alive */
+  uv_unref(reinterpret_cast<uv_handle_t *>(&unpin_async));
+}
+
 grpc_byte_buffer *BufferToByteBuffer(Handle<Value> buffer) {
   NanScope();
-  int length = ::node::Buffer::Length(buffer);
+  size_t length = ::node::Buffer::Length(buffer);
   char *data = ::node::Buffer::Data(buffer);
-  gpr_slice slice = gpr_slice_malloc(length);
-  memcpy(GPR_SLICE_START_PTR(slice), data, length);
+  gpr_slice slice;
+  if (length < kMinZeroCopyLength) {
+    slice = gpr_slice_malloc(length);
+    memcpy(GPR_SLICE_START_PTR(slice), data, length);
+  } else {
+    PinnedBuffer *pin = new PinnedBuffer;
+    pin->base.ref = PinnedBufferRef;
+    pin->base.unref = PinnedBufferUnref;
+    gpr_ref_init(&pin->refs, 1);
+    NanAssignPersistent(pin->buffer, buffer);
+    slice.refcount = &pin->base;
+    slice.data.refcounted.bytes = reinterpret_cast<gpr_uint8 *>(data);
+    slice.data.refcounted.length = length;
+  }
   grpc_byte_buffer *byte_buffer(grpc_byte_buffer_create(&slice, 1));
   gpr_slice_unref(slice);
   return byte_buffer;
@@ -68,19 +155,39 @@ Handle<Value> ByteBufferToBuffer(grpc_byte_buffer *buffer) {
     return NanEscapeScope(NanNull());
   }
   size_t length = grpc_byte_buffer_length(buffer);
-  char *result = reinterpret_cast<char *>(calloc(length, sizeof(char)));
-  size_t offset = 0;
   grpc_byte_buffer_reader *reader = grpc_byte_buffer_reader_create(buffer);
   gpr_slice next;
-  while (grpc_byte_buffer_reader_next(reader, &next) != 0) {
+  if (!grpc_byte_buffer_reader_next(reader, &next)) {
+    grpc_byte_buffer_reader_destroy(reader);
+    return NanEscapeScope(MakeFastBuffer(NanNewBufferHandle(0)));
+  }
+  if (GPR_SLICE_LENGTH(next) == length) {
+    /* the whole message is in one slice: wrap its memory, and keep the slice
+       until the Buffer is collected */
+    grpc_byte_buffer_reader_destroy(reader);
+    gpr_slice *slice = new gpr_slice(next);
+    return NanEscapeScope(MakeFastBuffer(NanNewBufferHandle(
+        reinterpret_cast<char *>(GPR_SLICE_START_PTR(*slice)), length,
+        FreeSlice, slice)));
+  }
+  char *result = reinterpret_cast<char *>(malloc(length));
+  size_t offset = 0;
+  do {
     memcpy(result + offset, GPR_SLICE_START_PTR(next), GPR_SLICE_LENGTH(next));
     offset += GPR_SLICE_LENGTH(next);
-  }
-  return NanEscapeScope(MakeFastBuffer(NanNewBufferHandle(result, length)));
+    gpr_slice_unref(next);
+  } while (grpc_byte_buffer_reader_next(reader, &next) != 0);
+  grpc_byte_buffer_reader_destroy(reader);
+  return NanEscapeScope(MakeFastBuffer(
+      NanNewBufferHandle(result, length, FreeCopy, NULL)));
 }
 
 Handle<Value> MakeFastBuffer(Handle<Value> slowBuffer) {
   NanEscapableScope();
+#if (NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION)
+  /* Buffers are already fast, and the constructor below would copy */
+  return NanEscapeScope(slowBuffer);
+#else
   Handle<Object> globalObj = NanGetCurrentContext()->Global();
   Handle<Function> bufferConstructor = Handle<Function>::Cast(
       globalObj->Get(NanNew("Buffer")));
@@ -91,6 +198,7 @@ Handle<Value> MakeFastBuffer(Handle<Value> slowBuffer) {
   };
   Handle<Object> fastBuffer = bufferConstructor->NewInstance(3, consArgs);
   return NanEscapeScope(fastBuffer);
+#endif
 }
 }  // namespace node
 }  // namespace grpc
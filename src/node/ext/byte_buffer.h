@@ -43,6 +43,10 @@
 namespace grpc {
 namespace node {
 
+/* Set up the state used to release Node.js Buffers referenced by byte buffers.
+   Must be called once from the module initializer */
+void InitByteBuffer();
+
 /* Convert a Node.js Buffer to grpc_byte_buffer. Requires that
    ::node::Buffer::HasInstance(buffer) */
 grpc_byte_buffer *BufferToByteBuffer(v8::Handle<v8::Value> buffer);
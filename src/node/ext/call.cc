@@ -186,6 +186,14 @@ class SendMetadataOp : public Op {
 
 class SendMessageOp : public Op {
  public:
+  SendMessageOp() {
+    send_message = NULL;
+  }
+  ~SendMessageOp() {
+    if (send_message != NULL) {
+      grpc_byte_buffer_destroy(send_message);
+    }
+  }
   Handle<Value> GetNodeValue() const {
     NanEscapableScope();
     return NanEscapeScope(NanTrue());
@@ -195,17 +203,16 @@ class SendMessageOp : public Op {
     if (!::node::Buffer::HasInstance(value)) {
       return false;
     }
-    out->data.send_message = BufferToByteBuffer(value);
-    Persistent<Value> *handle = new Persistent<Value>();
-    NanAssignPersistent(*handle, value);
-    resources->handles.push_back(unique_ptr<PersistentHolder>(
-        new PersistentHolder(handle)));
+    send_message = BufferToByteBuffer(value);
+    out->data.send_message = send_message;
     return true;
   }
  protected:
   std::string GetTypeString() const {
     return "send message";
   }
+ private:
+  grpc_byte_buffer *send_message;
 };
 
 class SendClientCloseOp : public Op {
@@ -305,7 +312,7 @@ class ReadMessageOp : public Op {
   }
   ~ReadMessageOp() {
     if (recv_message != NULL) {
-      gpr_free(recv_message);
+      grpc_byte_buffer_destroy(recv_message);
     }
   }
   Handle<Value> GetNodeValue() const {
@@ -31,8 +31,11 @@
  *
  */
 
+#include <vector>
+
 #include <node.h>
 #include <nan.h>
+#include <uv.h>
 
 #include "grpc/grpc.h"
 #include "grpc/support/log.h"
@@ -50,53 +53,75 @@ using v8::Persistent;
 using v8::Value;
 
 grpc_completion_queue *CompletionQueueAsyncWorker::queue;
+uv_mutex_t CompletionQueueAsyncWorker::ready_mu;
+std::vector<grpc_event *> *CompletionQueueAsyncWorker::ready;
+uv_async_t CompletionQueueAsyncWorker::ready_async;
+uv_thread_t CompletionQueueAsyncWorker::poll_thread;
+size_t CompletionQueueAsyncWorker::pending = 0;
+
+void CompletionQueueAsyncWorker::PollQueue(void *arg) {
+  grpc_event *batch[GRPC_COMPLETION_QUEUE_BATCH_SIZE];
+  for (;;) {
+    /* block for one event, and take any others already queued with it */
+    size_t count = grpc_completion_queue_next_batch(
+        queue, batch, GRPC_COMPLETION_QUEUE_BATCH_SIZE, gpr_inf_future);
+    uv_mutex_lock(&ready_mu);
+    ready->insert(ready->end(), batch, batch + count);
+    uv_mutex_unlock(&ready_mu);
+    /* sends made before the main loop wakes are coalesced */
+    uv_async_send(&ready_async);
+  }
+}
 
-CompletionQueueAsyncWorker::CompletionQueueAsyncWorker()
-    : NanAsyncWorker(NULL) {}
-
-CompletionQueueAsyncWorker::~CompletionQueueAsyncWorker() {}
-
-void CompletionQueueAsyncWorker::Execute() {
-  result = grpc_completion_queue_next(queue, gpr_inf_future);
-  if (result->data.op_complete != GRPC_OP_OK) {
-    SetErrorMessage("The batch encountered an error");
+#if UV_VERSION_MAJOR == 0
+void CompletionQueueAsyncWorker::HandleEvents(uv_async_t *handle,
+                                              int status) {
+#else
+void CompletionQueueAsyncWorker::HandleEvents(uv_async_t *handle) {
+#endif
+  NanScope();
+  std::vector<grpc_event *> events;
+  uv_mutex_lock(&ready_mu);
+  events.swap(*ready);
+  uv_mutex_unlock(&ready_mu);
+
+  for (size_t i = 0; i < events.size(); i++) {
+    grpc_event *event = events[i];
+    NanCallback *callback = GetTagCallback(event->tag);
+    if (event->data.op_complete == GRPC_OP_OK) {
+      Handle<Value> argv[] = {NanNull(), GetTagNodeValue(event->tag)};
+      callback->Call(2, argv);
+    } else {
+      Handle<Value> argv[] = {NanError("The batch encountered an error")};
+      callback->Call(1, argv);
+    }
+    DestroyTag(event->tag);
+    grpc_event_finish(event);
+    pending--;
+  }
+  if (pending == 0) {
+    /* nothing outstanding: let the process exit */
+    uv_unref(reinterpret_cast<uv_handle_t *>(&ready_async));
   }
 }
 
 grpc_completion_queue *CompletionQueueAsyncWorker::GetQueue() { return queue; }
 
 void CompletionQueueAsyncWorker::Next() {
-  NanScope();
-  CompletionQueueAsyncWorker *worker = new CompletionQueueAsyncWorker();
-  NanAsyncQueueWorker(worker);
+  if (pending++ == 0) {
+    uv_ref(reinterpret_cast<uv_handle_t *>(&ready_async));
+  }
 }
 
 void CompletionQueueAsyncWorker::Init(Handle<Object> exports) {
   NanScope();
   queue = grpc_completion_queue_create();
-}
-
-void CompletionQueueAsyncWorker::HandleOKCallback() {
-  NanScope();
-  NanCallback *callback = GetTagCallback(result->tag);
-  Handle<Value> argv[] = {NanNull(), GetTagNodeValue(result->tag)};
-  callback->Call(2, argv);
-
-  DestroyTag(result->tag);
-  grpc_event_finish(result);
-  result = NULL;
-}
-
-void CompletionQueueAsyncWorker::HandleErrorCallback() {
-  NanScope();
-  NanCallback *callback = GetTagCallback(result->tag);
-  Handle<Value> argv[] = {NanError(ErrorMessage())};
-
-  callback->Call(1, argv);
-
-  DestroyTag(result->tag);
-  grpc_event_finish(result);
-  result = NULL;
+  ready = new std::vector<grpc_event *>();
+  GPR_ASSERT(uv_mutex_init(&ready_mu) == 0);
+  GPR_ASSERT(uv_async_init(uv_default_loop(), &ready_async, HandleEvents) ==
+             0);
+  uv_unref(reinterpret_cast<uv_handle_t *>(&ready_async));
+  GPR_ASSERT(uv_thread_create(&poll_thread, PollQueue, NULL) == 0);
 }
 
 }  // namespace node
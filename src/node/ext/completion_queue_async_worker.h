@@ -33,46 +33,55 @@
 
 #ifndef NET_GRPC_NODE_COMPLETION_QUEUE_ASYNC_WORKER_H_
 #define NET_GRPC_NODE_COMPLETION_QUEUE_ASYNC_WORKER_H_
+#include <vector>
+
 #include <nan.h>
+#include <uv.h>
 
 #include "grpc/grpc.h"
 
 namespace grpc {
 namespace node {
 
-/* A worker that asynchronously calls completion_queue_next, and queues onto the
-   node event loop a call to the function stored in the event's tag. */
-class CompletionQueueAsyncWorker : public NanAsyncWorker {
+/* Drains the completion queue on one dedicated thread, and queues onto the
+   node event loop calls to the functions stored in the events' tags. Events
+   are handed over in batches through a single uv_async_t, so polling never
+   occupies the libuv threadpool. */
+class CompletionQueueAsyncWorker {
  public:
-  CompletionQueueAsyncWorker();
-
-  ~CompletionQueueAsyncWorker();
-  /* Calls completion_queue_next with the provided deadline, and stores the
-     event if there was one or sets an error message if there was not */
-  void Execute();
-
   /* Returns the completion queue attached to this class */
   static grpc_completion_queue *GetQueue();
 
-  /* Convenience function to create a worker with the given arguments and queue
-     it to run asynchronously */
+  /* Notes that one more event is expected on the queue, which keeps the event
+     loop alive until that event has been handled */
   static void Next();
 
   /* Initialize the CompletionQueueAsyncWorker class */
   static void Init(v8::Handle<v8::Object> exports);
 
- protected:
-  /* Called when Execute has succeeded (completed without setting an error
-     message). Calls the saved callback with the event that came from
-     completion_queue_next */
-  void HandleOKCallback();
-
-  void HandleErrorCallback();
-
  private:
-  grpc_event *result;
+  /* Body of the polling thread: waits for an event, takes whatever else is
+     already on the queue, and passes the lot to the main loop */
+  static void PollQueue(void *arg);
+
+  /* Runs on the main loop; calls the saved callback of each event that the
+     polling thread has handed over */
+#if UV_VERSION_MAJOR == 0
+  static void HandleEvents(uv_async_t *handle, int status);
+#else
+  static void HandleEvents(uv_async_t *handle);
+#endif
 
   static grpc_completion_queue *queue;
+
+  /* Events taken off the queue but not yet handled, guarded by ready_mu */
+  static uv_mutex_t ready_mu;
+  static std::vector<grpc_event *> *ready;
+  /* Wakes the main loop when ready becomes non-empty */
+  static uv_async_t ready_async;
+  static uv_thread_t poll_thread;
+  /* Number of events expected but not yet handled; main loop only */
+  static size_t pending;
 };
 
 }  // namespace node
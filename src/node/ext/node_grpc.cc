@@ -36,6 +36,7 @@
 #include <v8.h>
 #include "grpc/grpc.h"
 
+#include "byte_buffer.h"
 #include "call.h"
 #include "channel.h"
 #include "server.h"
@@ -165,6 +166,7 @@ void init(Handle<Object> exports) {
   InitStatusConstants(exports);
   InitCallErrorConstants(exports);
   InitOpTypeConstants(exports);
+  grpc::node::InitByteBuffer();
 
   grpc::node::Call::Init(exports);
   grpc::node::Channel::Init(exports);
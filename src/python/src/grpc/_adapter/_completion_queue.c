@@ -266,20 +266,54 @@ static int pygrpc_completion_queue_init(CompletionQueue *self, PyObject *args,
     return -1;
   }
   self->c_completion_queue = grpc_completion_queue_create();
+  self->pending = NULL;
+  self->pending_begin = 0;
+  self->pending_end = 0;
+  self->pending_capacity = 0;
   return 0;
 }
 
 static void pygrpc_completion_queue_dealloc(CompletionQueue *self) {
+  size_t i;
+  for (i = self->pending_begin; i < self->pending_end; i++) {
+    Py_XDECREF((PyObject *)self->pending[i]->tag);
+    grpc_event_finish(self->pending[i]);
+  }
+  gpr_free(self->pending);
   grpc_completion_queue_destroy(self->c_completion_queue);
   self->ob_type->tp_free((PyObject *)self);
 }
 
+/* Appends events to self's pending events, growing the array if another
+   thread's batch has not been consumed yet. */
+static void pygrpc_completion_queue_save_pending(CompletionQueue *self,
+                                                 grpc_event **events,
+                                                 size_t count) {
+  size_t live = self->pending_end - self->pending_begin;
+  if (self->pending_begin > 0) {
+    memmove(self->pending, self->pending + self->pending_begin,
+            live * sizeof(grpc_event *));
+    self->pending_begin = 0;
+    self->pending_end = live;
+  }
+  if (live + count > self->pending_capacity) {
+    self->pending_capacity = live + count;
+    self->pending = gpr_realloc(self->pending,
+                                self->pending_capacity * sizeof(grpc_event *));
+  }
+  memcpy(self->pending + self->pending_end, events,
+         count * sizeof(grpc_event *));
+  self->pending_end += count;
+}
+
 static PyObject *pygrpc_completion_queue_get(CompletionQueue *self,
                                              PyObject *args) {
   PyObject *deadline;
   double double_deadline;
   gpr_timespec deadline_timespec;
+  grpc_event *c_events[GRPC_COMPLETION_QUEUE_BATCH_SIZE];
   grpc_event *c_event;
+  size_t count;
 
   PyObject *event_args;
   PyObject *event;
@@ -288,26 +322,38 @@ static PyObject *pygrpc_completion_queue_get(CompletionQueue *self,
     return NULL;
   }
 
-  if (deadline == Py_None) {
-    deadline_timespec = gpr_inf_future;
+  if (self->pending_begin < self->pending_end) {
+    /* Left over from an earlier batch; no need to release the GIL. */
+    c_event = self->pending[self->pending_begin++];
   } else {
-    double_deadline = PyFloat_AsDouble(deadline);
-    if (PyErr_Occurred()) {
-      return NULL;
+    if (deadline == Py_None) {
+      deadline_timespec = gpr_inf_future;
+    } else {
+      double_deadline = PyFloat_AsDouble(deadline);
+      if (PyErr_Occurred()) {
+        return NULL;
+      }
+      deadline_timespec =
+          gpr_time_from_nanos((long)(double_deadline * 1.0E9));
     }
-    deadline_timespec = gpr_time_from_nanos((long)(double_deadline * 1.0E9));
-  }
-
-  /* TODO(nathaniel): Suppress clang-format in this block and remove the
-     unnecessary and unPythonic semicolons trailing the _ALLOW_THREADS macros.
-     (Right now clang-format only understands //-demarcated suppressions.) */
-  Py_BEGIN_ALLOW_THREADS;
-  c_event =
-      grpc_completion_queue_next(self->c_completion_queue, deadline_timespec);
-  Py_END_ALLOW_THREADS;
 
-  if (c_event == NULL) {
-    Py_RETURN_NONE;
+    /* TODO(nathaniel): Suppress clang-format in this block and remove the
+       unnecessary and unPythonic semicolons trailing the _ALLOW_THREADS
+       macros. (Right now clang-format only understands //-demarcated
+       suppressions.) */
+    Py_BEGIN_ALLOW_THREADS;
+    count = grpc_completion_queue_next_batch(
+        self->c_completion_queue, c_events, GRPC_COMPLETION_QUEUE_BATCH_SIZE,
+        deadline_timespec);
+    Py_END_ALLOW_THREADS;
+
+    if (count == 0) {
+      Py_RETURN_NONE;
+    }
+    c_event = c_events[0];
+    if (count > 1) {
+      pygrpc_completion_queue_save_pending(self, c_events + 1, count - 1);
+    }
   }
 
   switch (c_event->type) {
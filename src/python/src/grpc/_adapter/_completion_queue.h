@@ -39,6 +39,16 @@
 
 typedef struct {
   PyObject_HEAD grpc_completion_queue *c_completion_queue;
+  /* Events taken from c_completion_queue by an earlier batch but not yet
+     returned by get; entries [pending_begin, pending_end) are live.
+     They cannot be handed back to the core queue, so they only reach a
+     thread that calls get after they were taken: a thread already blocked in
+     get waits for a new event or its deadline. With the single thread per
+     queue that fore and rear use, nothing waits on them. */
+  grpc_event **pending;
+  size_t pending_begin;
+  size_t pending_end;
+  size_t pending_capacity;
 } CompletionQueue;
 
 PyTypeObject pygrpc_CompletionQueueType;
@@ -67,6 +67,13 @@ static ID id_status;
  */
 static VALUE hash_all_calls;
 
+/* Returns the core tag for an operation on the call, whose event carries tag
+   on the call's completion queue. */
+static void *grpc_rb_call_expect(VALUE self, VALUE tag) {
+  return grpc_rb_completion_queue_expect(rb_ivar_get(self, id_cq),
+                                         ROBJECT(tag));
+}
+
 /* Destroys a Call. */
 void grpc_rb_call_destroy(void *p) {
   grpc_call *call = NULL;
@@ -210,6 +217,8 @@ static VALUE grpc_rb_call_invoke(int argc, VALUE *argv, VALUE self) {
   VALUE flags = Qnil;
   grpc_call *call = NULL;
   grpc_completion_queue *cq = NULL;
+  void *core_metadata_read_tag = NULL;
+  void *core_finished_tag = NULL;
   grpc_call_error err;
 
   /* "31" == 3 mandatory args, 1 (flags) is optional */
@@ -220,9 +229,15 @@ static VALUE grpc_rb_call_invoke(int argc, VALUE *argv, VALUE self) {
   }
   cq = grpc_rb_get_wrapped_completion_queue(cqueue);
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_invoke_old(call, cq, ROBJECT(metadata_read_tag),
-                             ROBJECT(finished_tag), NUM2UINT(flags));
+  core_metadata_read_tag =
+      grpc_rb_completion_queue_expect(cqueue, ROBJECT(metadata_read_tag));
+  core_finished_tag =
+      grpc_rb_completion_queue_expect(cqueue, ROBJECT(finished_tag));
+  err = grpc_call_invoke_old(call, cq, core_metadata_read_tag,
+                             core_finished_tag, NUM2UINT(flags));
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_metadata_read_tag);
+    grpc_rb_completion_queue_unexpect(core_finished_tag);
     rb_raise(rb_eCallError, "invoke failed: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
@@ -240,10 +255,13 @@ static VALUE grpc_rb_call_invoke(int argc, VALUE *argv, VALUE self) {
    the next read after the corresponding read event is received. */
 static VALUE grpc_rb_call_start_read(VALUE self, VALUE tag) {
   grpc_call *call = NULL;
+  void *core_tag = NULL;
   grpc_call_error err;
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_start_read_old(call, ROBJECT(tag));
+  core_tag = grpc_rb_call_expect(self, tag);
+  err = grpc_call_start_read_old(call, core_tag);
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_tag);
     rb_raise(rb_eCallError, "start read failed: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
@@ -321,6 +339,8 @@ static VALUE grpc_rb_call_start_write(int argc, VALUE *argv, VALUE self) {
   VALUE flags = Qnil;
   grpc_call *call = NULL;
   grpc_byte_buffer *bfr = NULL;
+  gpr_uint32 write_flags;
+  void *core_tag = NULL;
   grpc_call_error err;
 
   /* "21" == 2 mandatory args, 1 (flags) is optional */
@@ -328,10 +348,13 @@ static VALUE grpc_rb_call_start_write(int argc, VALUE *argv, VALUE self) {
   if (NIL_P(flags)) {
     flags = UINT2NUM(0); /* Default to no flags */
   }
+  write_flags = NUM2UINT(flags);
   bfr = grpc_rb_get_wrapped_byte_buffer(byte_buffer);
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_start_write_old(call, bfr, ROBJECT(tag), NUM2UINT(flags));
+  core_tag = grpc_rb_call_expect(self, tag);
+  err = grpc_call_start_write_old(call, bfr, core_tag, write_flags);
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_tag);
     rb_raise(rb_eCallError, "start write failed: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
@@ -356,11 +379,15 @@ static VALUE grpc_rb_call_start_write(int argc, VALUE *argv, VALUE self) {
 static VALUE grpc_rb_call_start_write_status(VALUE self, VALUE code,
                                              VALUE status, VALUE tag) {
   grpc_call *call = NULL;
+  grpc_status_code status_code = NUM2UINT(code);
+  const char *details = StringValueCStr(status);
+  void *core_tag = NULL;
   grpc_call_error err;
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_start_write_status_old(call, NUM2UINT(code),
-                                         StringValueCStr(status), ROBJECT(tag));
+  core_tag = grpc_rb_call_expect(self, tag);
+  err = grpc_call_start_write_status_old(call, status_code, details, core_tag);
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_tag);
     rb_raise(rb_eCallError, "start write status: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
@@ -372,10 +399,13 @@ static VALUE grpc_rb_call_start_write_status(VALUE self, VALUE code,
    REQUIRES: No other writes are pending on the call. */
 static VALUE grpc_rb_call_writes_done(VALUE self, VALUE tag) {
   grpc_call *call = NULL;
+  void *core_tag = NULL;
   grpc_call_error err;
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_writes_done_old(call, ROBJECT(tag));
+  core_tag = grpc_rb_call_expect(self, tag);
+  err = grpc_call_writes_done_old(call, core_tag);
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_tag);
     rb_raise(rb_eCallError, "writes done: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
@@ -428,10 +458,13 @@ static VALUE grpc_rb_call_server_accept(VALUE self, VALUE cqueue,
                                         VALUE finished_tag) {
   grpc_call *call = NULL;
   grpc_completion_queue *cq = grpc_rb_get_wrapped_completion_queue(cqueue);
+  void *core_tag = NULL;
   grpc_call_error err;
   Data_Get_Struct(self, grpc_call, call);
-  err = grpc_call_server_accept_old(call, cq, ROBJECT(finished_tag));
+  core_tag = grpc_rb_completion_queue_expect(cqueue, ROBJECT(finished_tag));
+  err = grpc_call_server_accept_old(call, cq, core_tag);
   if (err != GRPC_CALL_OK) {
+    grpc_rb_completion_queue_unexpect(core_tag);
     rb_raise(rb_eCallError, "server_accept failed: %s (code=%d)",
              grpc_call_error_detail_of(err), err);
   }
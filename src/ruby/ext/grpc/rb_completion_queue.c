@@ -31,135 +31,300 @@
  *
  */
 
+
 #include "rb_completion_queue.h"
 
 #include <ruby.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
 #include <grpc/support/time.h>
+#include <grpc/support/useful.h>
 #include "rb_grpc.h"
 #include "rb_event.h"
 
-/* Used to allow grpc_completion_queue_next call to release the GIL */
-typedef struct next_call_stack {
-  grpc_completion_queue *cq;
-  grpc_event *event;
-  gpr_timespec timeout;
+/* All ruby CompletionQueues share one core completion queue, which a single
+   native thread drains. Each operation is started with its own core tag that
+   names the ruby CompletionQueue and the ruby tag, so its event goes straight
+   to that queue, and a ruby thread waiting in next or pluck only gives up the
+   GVL when its event has not arrived yet. */
+
+/* How long grpc_rb_completion_queue_shutdown_poller waits for operations
+   still in flight */
+#define POLLER_SHUTDOWN_TIMEOUT_MS 1000
+
+/* The state behind a ruby CompletionQueue. */
+typedef struct grpc_rb_cq {
+  /* Events routed to this queue but not yet returned, oldest first */
+  grpc_event **ready;
+  size_t ready_count;
+  size_t ready_capacity;
+  /* Signalled when an event is routed here */
+  gpr_cv cv;
+  /* One ref for the ruby object, one per expected event */
+  size_t refs;
+  /* Set once the ruby object has been GCed; events for it are dropped */
+  int dead;
+} grpc_rb_cq;
+
+/* The core tag of an operation started for a ruby CompletionQueue */
+typedef struct grpc_rb_tag {
+  grpc_rb_cq *cq;
+  /* The ruby tag, which the event carries once routed */
   void *tag;
-} next_call_stack;
+} grpc_rb_tag;
 
-/* Calls grpc_completion_queue_next without holding the ruby GIL */
-static void *grpc_rb_completion_queue_next_no_gil(next_call_stack *next_call) {
-  next_call->event =
-      grpc_completion_queue_next(next_call->cq, next_call->timeout);
-  return NULL;
+/* Guards the contents of every grpc_rb_cq */
+static gpr_mu g_mu;
+/* Owned by the polling thread, which destroys it on the way out */
+static grpc_completion_queue *g_cq = NULL;
+/* Set by the polling thread when it exits */
+static gpr_event g_poller_done;
+
+/* Appends ev to a growable array of events. */
+static void append_event(grpc_event ***events, size_t *count,
+                         size_t *capacity, grpc_event *ev) {
+  if (*count == *capacity) {
+    *capacity = GPR_MAX(8, 2 * *capacity);
+    *events = gpr_realloc(*events, *capacity * sizeof(grpc_event *));
+  }
+  (*events)[(*count)++] = ev;
+}
+
+/* Removes and returns events[i], keeping the rest in order. */
+static grpc_event *remove_event(grpc_event **events, size_t *count,
+                                size_t i) {
+  grpc_event *ev = events[i];
+  memmove(events + i, events + i + 1, (*count - i - 1) * sizeof(grpc_event *));
+  (*count)--;
+  return ev;
 }
 
-/* Calls grpc_completion_queue_pluck without holding the ruby GIL */
-static void *grpc_rb_completion_queue_pluck_no_gil(next_call_stack *next_call) {
-  next_call->event = grpc_completion_queue_pluck(next_call->cq, next_call->tag,
-                                                 next_call->timeout);
+/* Drops a ref to cq, freeing it when the last one goes.
+   Requires g_mu locked. */
+static void cq_unref_locked(grpc_rb_cq *cq) {
+  if (--cq->refs == 0) {
+    GPR_ASSERT(cq->ready_count == 0);
+    gpr_free(cq->ready);
+    gpr_cv_destroy(&cq->cv);
+    gpr_free(cq);
+  }
+}
+
+/* Hands ev to the queue its core tag names, restoring the ruby tag. Returns
+   ev if that queue is dead and the caller must finish it, NULL otherwise.
+   Requires g_mu locked. */
+static grpc_event *route_locked(grpc_event *ev) {
+  grpc_rb_tag *rb_tag = ev->tag;
+  grpc_rb_cq *cq = rb_tag->cq;
+  ev->tag = rb_tag->tag;
+  gpr_free(rb_tag);
+  if (!cq->dead) {
+    append_event(&cq->ready, &cq->ready_count, &cq->ready_capacity, ev);
+    gpr_cv_broadcast(&cq->cv);
+    ev = NULL;
+  }
+  cq_unref_locked(cq);
+  return ev;
+}
+
+/* Body of the polling thread. */
+static void grpc_rb_completion_queue_poll(void *ignored) {
+  grpc_event *events[GRPC_COMPLETION_QUEUE_BATCH_SIZE];
+  grpc_event *to_finish[GRPC_COMPLETION_QUEUE_BATCH_SIZE];
+  size_t count;
+  size_t finish_count;
+  size_t i;
+  int shutdown = 0;
+  while (!shutdown) {
+    count = grpc_completion_queue_next_batch(
+        g_cq, events, GPR_ARRAY_SIZE(events), gpr_inf_future);
+    finish_count = 0;
+    gpr_mu_lock(&g_mu);
+    for (i = 0; i < count; i++) {
+      if (events[i]->type == GRPC_QUEUE_SHUTDOWN) {
+        shutdown = 1;
+        to_finish[finish_count++] = events[i];
+      } else if ((events[i] = route_locked(events[i])) != NULL) {
+        to_finish[finish_count++] = events[i];
+      }
+    }
+    gpr_mu_unlock(&g_mu);
+    for (i = 0; i < finish_count; i++) {
+      grpc_event_finish(to_finish[i]);
+    }
+  }
+  grpc_completion_queue_destroy(g_cq);
+  gpr_event_set(&g_poller_done, (void *)1);
+}
+
+void *grpc_rb_completion_queue_expect(VALUE cqueue, void *tag) {
+  grpc_rb_tag *rb_tag = gpr_malloc(sizeof(grpc_rb_tag));
+  Data_Get_Struct(cqueue, grpc_rb_cq, rb_tag->cq);
+  rb_tag->tag = tag;
+  gpr_mu_lock(&g_mu);
+  rb_tag->cq->refs++;
+  gpr_mu_unlock(&g_mu);
+  return rb_tag;
+}
+
+void grpc_rb_completion_queue_unexpect(void *core_tag) {
+  grpc_rb_tag *rb_tag = core_tag;
+  gpr_mu_lock(&g_mu);
+  cq_unref_locked(rb_tag->cq);
+  gpr_mu_unlock(&g_mu);
+  gpr_free(rb_tag);
+}
+
+/* Used to allow a wait for an event to release the GIL */
+typedef struct wait_stack {
+  grpc_rb_cq *cq;
+  void *tag;
+  int any_tag;
+  gpr_timespec deadline;
+  int interrupted;
+  grpc_event *event;
+} wait_stack;
+
+/* Removes and returns the oldest event on cq that matches the wait, or NULL.
+   Requires g_mu locked. */
+static grpc_event *take_locked(wait_stack *wait) {
+  grpc_rb_cq *cq = wait->cq;
+  size_t i;
+  for (i = 0; i < cq->ready_count; i++) {
+    if (wait->any_tag || cq->ready[i]->tag == wait->tag) {
+      return remove_event(cq->ready, &cq->ready_count, i);
+    }
+  }
   return NULL;
 }
 
-/* Shuts down and drains the completion queue if necessary.
- *
- * This is done when the ruby completion queue object is about to be GCed.
- */
-static void grpc_rb_completion_queue_shutdown_drain(grpc_completion_queue *cq) {
-  next_call_stack next_call;
-  grpc_completion_type type;
-  int drained = 0;
-  MEMZERO(&next_call, next_call_stack, 1);
-
-  grpc_completion_queue_shutdown(cq);
-  next_call.cq = cq;
-  next_call.event = NULL;
-  /* TODO: the timeout should be a module level constant that defaults
-   * to gpr_inf_future.
-   *
-   * - at the moment this does not work, it stalls.  Using a small timeout like
-   *   this one works, and leads to fast test run times; a longer timeout was
-   *   causing unnecessary delays in the test runs.
-   *
-   * - investigate further, this is probably another example of C-level cleanup
-   * not working consistently in all cases.
-   */
-  next_call.timeout = gpr_time_add(gpr_now(), gpr_time_from_micros(5e3));
-  do {
-    rb_thread_call_without_gvl(grpc_rb_completion_queue_next_no_gil,
-                               (void *)&next_call, NULL, NULL);
-    if (next_call.event == NULL) {
+/* Waits for a matching event without holding the ruby GIL */
+static void *grpc_rb_completion_queue_wait_no_gil(wait_stack *wait) {
+  gpr_mu_lock(&g_mu);
+  while ((wait->event = take_locked(wait)) == NULL && !wait->interrupted) {
+    if (gpr_cv_wait(&wait->cq->cv, &g_mu, wait->deadline)) {
       break;
     }
-    type = next_call.event->type;
-    if (type != GRPC_QUEUE_SHUTDOWN) {
-      ++drained;
-      rb_warning("completion queue shutdown: %d undrained events", drained);
-    }
-    grpc_event_finish(next_call.event);
-    next_call.event = NULL;
-  } while (type != GRPC_QUEUE_SHUTDOWN);
+  }
+  gpr_mu_unlock(&g_mu);
+  return NULL;
+}
+
+/* Lets ruby interrupt a thread blocked in
+   grpc_rb_completion_queue_wait_no_gil */
+static void grpc_rb_completion_queue_unblock_wait(void *p) {
+  wait_stack *wait = (wait_stack *)p;
+  gpr_mu_lock(&g_mu);
+  wait->interrupted = 1;
+  gpr_cv_broadcast(&wait->cq->cv);
+  gpr_mu_unlock(&g_mu);
 }
 
-/* Helper function to free a completion queue. */
+/* Returns the event that wait asks for, releasing the GIL only if it has not
+   already been routed to the queue. */
+static VALUE grpc_rb_completion_queue_wait(wait_stack *wait) {
+  gpr_mu_lock(&g_mu);
+  wait->event = take_locked(wait);
+  gpr_mu_unlock(&g_mu);
+  if (wait->event == NULL) {
+    rb_thread_call_without_gvl(grpc_rb_completion_queue_wait_no_gil,
+                               (void *)wait,
+                               grpc_rb_completion_queue_unblock_wait,
+                               (void *)wait);
+  }
+  if (wait->event == NULL) {
+    return Qnil;
+  }
+  return grpc_rb_new_event(wait->event);
+}
+
+/* Helper function to free a completion queue.
+ *
+ * This is done when the ruby completion queue object is about to be GCed;
+ * events still waiting to be returned are discarded.
+ */
 static void grpc_rb_completion_queue_destroy(void *p) {
-  grpc_completion_queue *cq = NULL;
+  grpc_rb_cq *cq = NULL;
+  grpc_event **undrained;
+  size_t count;
+  size_t i;
   if (p == NULL) {
     return;
   }
-  cq = (grpc_completion_queue *)p;
-  grpc_rb_completion_queue_shutdown_drain(cq);
-  grpc_completion_queue_destroy(cq);
+  cq = (grpc_rb_cq *)p;
+  gpr_mu_lock(&g_mu);
+  cq->dead = 1;
+  undrained = cq->ready;
+  count = cq->ready_count;
+  cq->ready = NULL;
+  cq->ready_count = 0;
+  cq->ready_capacity = 0;
+  cq_unref_locked(cq);
+  gpr_mu_unlock(&g_mu);
+  if (count > 0) {
+    rb_warning("completion queue shutdown: %d undrained events", (int)count);
+  }
+  for (i = 0; i < count; i++) {
+    grpc_event_finish(undrained[i]);
+  }
+  gpr_free(undrained);
 }
 
 /* Allocates a completion queue. */
 static VALUE grpc_rb_completion_queue_alloc(VALUE cls) {
-  grpc_completion_queue *cq = grpc_completion_queue_create();
-  if (cq == NULL) {
-    rb_raise(rb_eArgError, "could not create a completion queue: not sure why");
-  }
+  grpc_rb_cq *cq = gpr_malloc(sizeof(grpc_rb_cq));
+  cq->ready = NULL;
+  cq->ready_count = 0;
+  cq->ready_capacity = 0;
+  gpr_cv_init(&cq->cv);
+  cq->refs = 1;
+  cq->dead = 0;
   return Data_Wrap_Struct(cls, GC_NOT_MARKED, grpc_rb_completion_queue_destroy,
                           cq);
 }
 
 /* Blocks until the next event is available, and returns the event. */
 static VALUE grpc_rb_completion_queue_next(VALUE self, VALUE timeout) {
-  next_call_stack next_call;
-  MEMZERO(&next_call, next_call_stack, 1);
-  Data_Get_Struct(self, grpc_completion_queue, next_call.cq);
-  next_call.timeout = grpc_rb_time_timeval(timeout, /* absolute time*/ 0);
-  next_call.event = NULL;
-  rb_thread_call_without_gvl(grpc_rb_completion_queue_next_no_gil,
-                             (void *)&next_call, NULL, NULL);
-  if (next_call.event == NULL) {
-    return Qnil;
-  }
-  return grpc_rb_new_event(next_call.event);
+  wait_stack wait;
+  MEMZERO(&wait, wait_stack, 1);
+  Data_Get_Struct(self, grpc_rb_cq, wait.cq);
+  wait.deadline = grpc_rb_time_timeval(timeout, /* absolute time*/ 0);
+  wait.any_tag = 1;
+  return grpc_rb_completion_queue_wait(&wait);
 }
 
 /* Blocks until the next event for given tag is available, and returns the
  * event. */
 static VALUE grpc_rb_completion_queue_pluck(VALUE self, VALUE tag,
                                             VALUE timeout) {
-  next_call_stack next_call;
-  MEMZERO(&next_call, next_call_stack, 1);
-  Data_Get_Struct(self, grpc_completion_queue, next_call.cq);
-  next_call.timeout = grpc_rb_time_timeval(timeout, /* absolute time*/ 0);
-  next_call.tag = ROBJECT(tag);
-  next_call.event = NULL;
-  rb_thread_call_without_gvl(grpc_rb_completion_queue_pluck_no_gil,
-                             (void *)&next_call, NULL, NULL);
-  if (next_call.event == NULL) {
-    return Qnil;
-  }
-  return grpc_rb_new_event(next_call.event);
+  wait_stack wait;
+  MEMZERO(&wait, wait_stack, 1);
+  Data_Get_Struct(self, grpc_rb_cq, wait.cq);
+  wait.deadline = grpc_rb_time_timeval(timeout, /* absolute time*/ 0);
+  wait.tag = ROBJECT(tag);
+  return grpc_rb_completion_queue_wait(&wait);
+}
+
+int grpc_rb_completion_queue_shutdown_poller() {
+  gpr_timespec deadline;
+  grpc_completion_queue_shutdown(g_cq);
+  /* The queue only shuts down once every operation on it has completed. By
+     now the VM has freed every Call, cancelling it, but a server left
+     running still holds its requests, so the wait is bounded. */
+  deadline = gpr_time_add(gpr_now(),
+                          gpr_time_from_millis(POLLER_SHUTDOWN_TIMEOUT_MS));
+  return gpr_event_wait(&g_poller_done, deadline) != NULL;
 }
 
 /* rb_cCompletionQueue is the ruby class that proxies grpc_completion_queue. */
 VALUE rb_cCompletionQueue = Qnil;
 
 void Init_grpc_completion_queue() {
+  gpr_thd_id poller;
   rb_cCompletionQueue =
       rb_define_class_under(rb_mGrpcCore, "CompletionQueue", rb_cObject);
 
@@ -175,11 +340,19 @@ void Init_grpc_completion_queue() {
   /* Add the pluck method that waits for the next event of given tag */
   rb_define_method(rb_cCompletionQueue, "pluck", grpc_rb_completion_queue_pluck,
                    2);
+
+  gpr_mu_init(&g_mu);
+  gpr_event_init(&g_poller_done);
+  g_cq = grpc_completion_queue_create();
+  GPR_ASSERT(
+      gpr_thd_new(&poller, grpc_rb_completion_queue_poll, NULL, NULL));
 }
 
 /* Gets the wrapped completion queue from the ruby wrapper */
 grpc_completion_queue *grpc_rb_get_wrapped_completion_queue(VALUE v) {
-  grpc_completion_queue *cq = NULL;
-  Data_Get_Struct(v, grpc_completion_queue, cq);
-  return cq;
+  grpc_rb_cq *cq = NULL;
+  /* Checks that v is a CompletionQueue; all of them share g_cq */
+  Data_Get_Struct(v, grpc_rb_cq, cq);
+  GPR_ASSERT(cq != NULL);
+  return g_cq;
 }
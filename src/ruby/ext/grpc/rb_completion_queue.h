@@ -40,6 +40,21 @@
 /* Gets the wrapped completion queue from the ruby wrapper */
 grpc_completion_queue *grpc_rb_get_wrapped_completion_queue(VALUE v);
 
+/* Returns the core tag to start an operation with, so that its event is
+   returned by the ruby completion queue cqueue and carries tag. Call
+   grpc_rb_completion_queue_unexpect with it if the operation fails to
+   start. */
+void *grpc_rb_completion_queue_expect(VALUE cqueue, void *tag);
+
+/* Releases a core tag whose operation never started. */
+void grpc_rb_completion_queue_unexpect(void *core_tag);
+
+/* Shuts down the queue that the completion events come from. Returns
+   non-zero once the thread that polls it has exited; if operations are
+   still in flight it gives up and returns 0, and the core must not be shut
+   down under the thread. Called at exit. */
+int grpc_rb_completion_queue_shutdown_poller();
+
 /* rb_cCompletionQueue is the CompletionQueue class whose instances proxy
    grpc_completion_queue. */
 extern VALUE rb_cCompletionQueue;
@@ -238,7 +238,14 @@ void Init_grpc_time_consts() {
   id_tv_nsec = rb_intern("tv_nsec");
 }
 
-void grpc_rb_shutdown(void *vm) { grpc_shutdown(); }
+void grpc_rb_shutdown(void *vm) {
+  /* If operations outlive the VM, the polling thread is still inside the
+     core; leave it to process exit rather than pull the core from under
+     it. */
+  if (grpc_rb_completion_queue_shutdown_poller()) {
+    grpc_shutdown();
+  }
+}
 
 /* Initialize the GRPC module structs */
 
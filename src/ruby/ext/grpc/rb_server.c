@@ -155,12 +155,15 @@ static VALUE grpc_rb_server_init_copy(VALUE copy, VALUE orig) {
 static VALUE grpc_rb_server_request_call(VALUE self, VALUE tag_new) {
   grpc_call_error err;
   grpc_rb_server *s = NULL;
+  void *core_tag = NULL;
   Data_Get_Struct(self, grpc_rb_server, s);
   if (s->wrapped == NULL) {
     rb_raise(rb_eRuntimeError, "closed!");
   } else {
-    err = grpc_server_request_call_old(s->wrapped, ROBJECT(tag_new));
+    core_tag = grpc_rb_completion_queue_expect(s->mark, ROBJECT(tag_new));
+    err = grpc_server_request_call_old(s->wrapped, core_tag);
     if (err != GRPC_CALL_OK) {
+      grpc_rb_completion_queue_unexpect(core_tag);
       rb_raise(rb_eCallError, "server request failed: %s (code=%d)",
                grpc_call_error_detail_of(err), err);
     }
@@ -28,6 +28,9 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 require 'grpc'
+require 'rbconfig'
+
+include GRPC::Core::CompletionType
 
 describe GRPC::Core::CompletionQueue do
   before(:example) do
@@ -71,4 +74,95 @@ describe GRPC::Core::CompletionQueue do
       expect { @cq.pluck(tag, a_time) }.not_to raise_error
     end
   end
+
+  describe 'with operations in flight' do
+    before(:example) do
+      @server = GRPC::Core::Server.new(@cq, nil)
+      port = @server.add_http2_port('0.0.0.0:0')
+      @server.start
+      @ch = GRPC::Core::Channel.new("0.0.0.0:#{port}", nil)
+    end
+
+    after(:example) do
+      @ch.close
+      @server.close
+    end
+
+    def deadline
+      Time.now + 2
+    end
+
+    # invokes a call on queue, and accepts it on the server
+    def start_call(queue, tag)
+      call = @ch.create_call('/method', 'localhost', deadline)
+      call.invoke(queue, Object.new, Object.new)
+      @server.request_call(tag)
+      ev = @cq.pluck(tag, deadline)
+      expect(ev.type).to be(SERVER_RPC_NEW)
+      server_call = ev.call
+      server_call.server_accept(@cq, Object.new)
+      server_call.server_end_initial_metadata
+      [call, server_call]
+    end
+
+    it 'returns each event on the queue that started its operation' do
+      tag = Object.new
+      queues = [GRPC::Core::CompletionQueue.new,
+                GRPC::Core::CompletionQueue.new]
+      calls = queues.map { |q| start_call(q, tag) }
+
+      # both queues wait for a read with the same tag, and the reads
+      # complete in the order they were started
+      calls.each { |call, _| call.start_read(tag) }
+      calls.each_with_index do |(_, server_call), i|
+        reply = GRPC::Core::ByteBuffer.new("message #{i}")
+        server_call.start_write(reply, tag)
+        expect(@cq.pluck(tag, deadline).type).to be(WRITE_ACCEPTED)
+      end
+
+      queues.each_with_index do |queue, i|
+        ev = queue.pluck(tag, deadline)
+        expect(ev).not_to be_nil
+        expect(ev.type).to be(READ)
+        expect(ev.tag).to be(tag)
+        expect(ev.result.to_s).to eq("message #{i}")
+        expect(queue.pluck(tag, GRPC::Core::TimeConsts::ZERO)).to be_nil
+      end
+    end
+
+    it 'can pluck a request that was pending when its server shut down' do
+      tag = Object.new
+      @server.request_call(tag)
+      @server.close
+      ev = @cq.pluck(tag, deadline)
+      expect(ev).not_to be_nil
+      expect(ev.type).to be(SERVER_RPC_NEW)
+      expect(ev.call).to be_nil
+    end
+
+    it 'lets the process exit with calls still in flight' do
+      lib_dir = File.join(File.dirname(File.expand_path(__FILE__)), '../lib')
+      script = <<-RUBY
+        cq = GRPC::Core::CompletionQueue.new
+        server = GRPC::Core::Server.new(cq, nil)
+        port = server.add_http2_port('0.0.0.0:0')
+        server.start
+        server.request_call(Object.new)
+        ch = GRPC::Core::Channel.new("0.0.0.0:\#{port}", nil)
+        call = ch.create_call('/method', 'localhost', Time.now + 60)
+        call.invoke(cq, Object.new, Object.new)
+        call.start_read(Object.new)
+      RUBY
+      args = $LOAD_PATH.map { |dir| "-I#{dir}" }
+      pid = Process.spawn(RbConfig.ruby, "-I#{lib_dir}", *args, '-rgrpc',
+                          '-e', script)
+      # the server's request never completes, so exit must not wait on it
+      waiter = Process.detach(pid)
+      unless waiter.join(5)
+        Process.kill('KILL', pid)
+        fail 'the process did not exit in time'
+      end
+      expect(waiter.value.success?).to be(true)
+    end
+  end
 end
@@ -31,11 +31,17 @@
  *
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <grpc/grpc.h>
 
 #include <stdio.h>
 #include <string.h>
 
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
 #include <grpc/support/cmdline.h>
 #include <grpc/support/histogram.h>
 #include <grpc/support/log.h>
@@ -44,6 +50,12 @@
 #include "test/core/util/grpc_profiler.h"
 #include "test/core/util/test_config.h"
 
+#ifdef GPR_LINUX
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 static gpr_histogram *histogram;
 static grpc_byte_buffer *the_buffer;
 static grpc_channel *channel;
@@ -99,6 +111,52 @@ static void step_ping_pong_request(void) {
   call = NULL;
 }
 
+/* Starts BURST_SIZE unary calls back to back and waits for all of them: with
+   several calls outstanding, their writes have a chance to coalesce. */
+#define BURST_SIZE 8
+
+static void step_unary_burst(void) {
+  grpc_call *calls[BURST_SIZE];
+  grpc_byte_buffer *responses[BURST_SIZE];
+  grpc_metadata_array initial_metadata[BURST_SIZE];
+  grpc_metadata_array trailing_metadata[BURST_SIZE];
+  grpc_status_code statuses[BURST_SIZE];
+  char *call_details[BURST_SIZE];
+  size_t call_details_capacity[BURST_SIZE];
+  grpc_op burst_ops[6];
+  int i;
+
+  for (i = 0; i < BURST_SIZE; i++) {
+    grpc_metadata_array_init(&initial_metadata[i]);
+    grpc_metadata_array_init(&trailing_metadata[i]);
+    call_details[i] = NULL;
+    call_details_capacity[i] = 0;
+    memcpy(burst_ops, ops, sizeof(burst_ops));
+    burst_ops[3].data.recv_initial_metadata = &initial_metadata[i];
+    burst_ops[4].data.recv_message = &responses[i];
+    burst_ops[5].data.recv_status_on_client.trailing_metadata =
+        &trailing_metadata[i];
+    burst_ops[5].data.recv_status_on_client.status = &statuses[i];
+    burst_ops[5].data.recv_status_on_client.status_details = &call_details[i];
+    burst_ops[5].data.recv_status_on_client.status_details_capacity =
+        &call_details_capacity[i];
+    calls[i] = grpc_channel_create_call(channel, cq, "/Reflector/reflectUnary",
+                                        "localhost", gpr_inf_future);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(calls[i], burst_ops, 6, (void *)1));
+  }
+  for (i = 0; i < BURST_SIZE; i++) {
+    grpc_event_finish(grpc_completion_queue_next(cq, gpr_inf_future));
+  }
+  for (i = 0; i < BURST_SIZE; i++) {
+    grpc_call_destroy(calls[i]);
+    grpc_byte_buffer_destroy(responses[i]);
+    grpc_metadata_array_destroy(&initial_metadata[i]);
+    grpc_metadata_array_destroy(&trailing_metadata[i]);
+    gpr_free(call_details[i]);
+  }
+}
+
 static void init_ping_pong_stream(void) {
   call = grpc_channel_create_call(channel, cq, "/Reflector/reflectStream",
                                   "localhost", gpr_inf_future);
@@ -128,31 +186,61 @@ static double now(void) {
   return 1e9 * tv.tv_sec + tv.tv_nsec;
 }
 
+static gpr_atm socket_syscalls;
+
+#if defined(GPR_LINUX) && defined(SYS_sendmsg) && defined(SYS_recvmsg)
+/* The tcp endpoint's sendmsg() and recvmsg() calls land here rather than in
+   libc, so that we can report how many socket syscalls each rpc costs.
+   These are the only calls the endpoint makes to move data, but the count
+   covers this (client) process only: the server's syscalls, and poll() and
+   the pollset wakeup fd's read()/write() on either side, are not included. */
+#define COUNTS_SOCKET_SYSCALLS 1
+
+ssize_t sendmsg(int fd, const struct msghdr *msg, int flags) {
+  gpr_atm_no_barrier_fetch_add(&socket_syscalls, 1);
+  return syscall(SYS_sendmsg, fd, msg, flags);
+}
+
+ssize_t recvmsg(int fd, struct msghdr *msg, int flags) {
+  gpr_atm_no_barrier_fetch_add(&socket_syscalls, 1);
+  return syscall(SYS_recvmsg, fd, msg, flags);
+}
+#else
+#define COUNTS_SOCKET_SYSCALLS 0
+#endif
+
 typedef struct {
   const char *name;
   void (*init)();
   void (*do_one_step)();
+  int rpcs_per_step;
 } scenario;
 
 static const scenario scenarios[] = {
-    {"ping-pong-request", init_ping_pong_request, step_ping_pong_request},
-    {"ping-pong-stream", init_ping_pong_stream, step_ping_pong_stream},
+    {"ping-pong-request", init_ping_pong_request, step_ping_pong_request, 1},
+    {"ping-pong-stream", init_ping_pong_stream, step_ping_pong_stream, 1},
+    {"unary-burst", init_ping_pong_request, step_unary_burst, BURST_SIZE},
 };
 
 int main(int argc, char **argv) {
   gpr_slice slice = gpr_slice_from_copied_string("x");
   double start, stop;
   unsigned i;
+  gpr_atm syscalls_start, syscalls_stop;
+  gpr_alloc_stats allocs_start, allocs_stop;
 
   char *fake_argv[1];
 
   int payload_size = 1;
   int done;
   int secure = 0;
+  int write_coalesce_us = 0;
   char *target = "localhost:443";
   gpr_cmdline *cl;
   char *scenario_name = "ping-pong-request";
-  scenario sc = {NULL, NULL, NULL};
+  scenario sc = {NULL, NULL, NULL, 0};
+  grpc_arg arg;
+  grpc_channel_args args;
 
   GPR_ASSERT(argc >= 1);
   fake_argv[0] = argv[0];
@@ -166,6 +254,9 @@ int main(int argc, char **argv) {
   gpr_cmdline_add_string(cl, "target", "Target host:port", &target);
   gpr_cmdline_add_flag(cl, "secure", "Run with security?", &secure);
   gpr_cmdline_add_string(cl, "scenario", "Scenario", &scenario_name);
+  gpr_cmdline_add_int(cl, "write_coalesce_us",
+                      "Hold writes up to this long to coalesce them (0: off)",
+                      &write_coalesce_us);
   gpr_cmdline_parse(cl, argc, argv);
   gpr_cmdline_destroy(cl);
 
@@ -182,7 +273,12 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  channel = grpc_channel_create(target, NULL);
+  arg.type = GRPC_ARG_INTEGER;
+  arg.key = GRPC_ARG_HTTP2_WRITE_COALESCE_US;
+  arg.value.integer = write_coalesce_us;
+  args.num_args = 1;
+  args.args = &arg;
+  channel = grpc_channel_create(target, write_coalesce_us ? &args : NULL);
   cq = grpc_completion_queue_create();
   the_buffer = grpc_byte_buffer_create(&slice, payload_size);
   histogram = gpr_histogram_create(0.01, 60e9);
@@ -195,12 +291,18 @@ int main(int argc, char **argv) {
 
   gpr_log(GPR_INFO, "start profiling");
   grpc_profiler_start("client.prof");
+  syscalls_start = gpr_atm_acq_load(&socket_syscalls);
+  gpr_alloc_enable_counting(1);
+  gpr_alloc_get_stats(&allocs_start);
   for (i = 0; i < 100000; i++) {
     start = now();
     sc.do_one_step();
     stop = now();
     gpr_histogram_add(histogram, stop - start);
   }
+  syscalls_stop = gpr_atm_acq_load(&socket_syscalls);
+  gpr_alloc_get_stats(&allocs_stop);
+  gpr_alloc_enable_counting(0);
   grpc_profiler_stop();
 
   if (call) {
@@ -224,6 +326,13 @@ int main(int argc, char **argv) {
           gpr_histogram_percentile(histogram, 95),
           gpr_histogram_percentile(histogram, 99),
           gpr_histogram_percentile(histogram, 99.9));
+  if (COUNTS_SOCKET_SYSCALLS) {
+    gpr_log(GPR_INFO, "client sendmsg+recvmsg calls per rpc: %f",
+            (double)(syscalls_stop - syscalls_start) / i / sc.rpcs_per_step);
+  }
+  gpr_log(GPR_INFO, "client allocations per rpc: %f",
+          (double)(allocs_stop.allocs - allocs_start.allocs) / i /
+              sc.rpcs_per_step);
   gpr_histogram_destroy(histogram);
 
   grpc_shutdown();
@@ -176,7 +176,11 @@ int main(int argc, char **argv) {
   int shutdown_finished = 0;
 
   int secure = 0;
+  int write_coalesce_us = 0;
   char *addr = NULL;
+  grpc_arg arg;
+  grpc_channel_args args;
+  grpc_channel_args *server_args;
 
   char *fake_argv[1];
 
@@ -190,6 +194,9 @@ int main(int argc, char **argv) {
   cl = gpr_cmdline_create("fling server");
   gpr_cmdline_add_string(cl, "bind", "Bind host:port", &addr);
   gpr_cmdline_add_flag(cl, "secure", "Run with security?", &secure);
+  gpr_cmdline_add_int(cl, "write_coalesce_us",
+                      "Hold writes up to this long to coalesce them (0: off)",
+                      &write_coalesce_us);
   gpr_cmdline_parse(cl, argc, argv);
   gpr_cmdline_destroy(cl);
 
@@ -199,17 +206,24 @@ int main(int argc, char **argv) {
   }
   gpr_log(GPR_INFO, "creating server on: %s", addr);
 
+  arg.type = GRPC_ARG_INTEGER;
+  arg.key = GRPC_ARG_HTTP2_WRITE_COALESCE_US;
+  arg.value.integer = write_coalesce_us;
+  args.num_args = 1;
+  args.args = &arg;
+  server_args = write_coalesce_us ? &args : NULL;
+
   cq = grpc_completion_queue_create();
   if (secure) {
     grpc_ssl_pem_key_cert_pair pem_key_cert_pair = {test_server1_key,
                                                     test_server1_cert};
     grpc_server_credentials *ssl_creds =
         grpc_ssl_server_credentials_create(NULL, &pem_key_cert_pair, 1);
-    server = grpc_server_create(cq, NULL);
+    server = grpc_server_create(cq, server_args);
     GPR_ASSERT(grpc_server_add_secure_http2_port(server, addr, ssl_creds));
     grpc_server_credentials_release(ssl_creds);
   } else {
-    server = grpc_server_create(cq, NULL);
+    server = grpc_server_create(cq, server_args);
     GPR_ASSERT(grpc_server_add_http2_port(server, addr));
   }
   grpc_server_start(server);
@@ -36,10 +36,10 @@
 #include "src/core/statistics/census_interface.h"
 #include "src/core/statistics/census_rpc_stats.h"
 #include "src/core/statistics/census_tracing.h"
+#include "src/core/support/string.h"
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/port_platform.h>
-#include <grpc/support/string.h>
 #include <grpc/support/thd.h>
 #include <grpc/support/time.h>
 #include "test/core/util/test_config.h"
@@ -149,6 +149,36 @@ static void test_record_and_get_stats(void) {
   census_shutdown();
 }
 
+static void test_record_and_get_latencies(void) {
+  census_rpc_stats stats = {1, 2, 3, 4, 5.1, 6.2, 7.3, 8.4};
+  census_op_id id;
+  gpr_histogram* latencies = census_rpc_latency_histogram_create();
+  gpr_histogram* earlier = census_rpc_latency_histogram_create();
+
+  census_init();
+  /* Discard latencies recorded by earlier tests. */
+  census_get_client_latencies(earlier);
+  census_get_server_latencies(earlier);
+  gpr_histogram_destroy(earlier);
+  id = census_tracing_start_op();
+  census_add_method_tag(id, "m1");
+  census_record_rpc_client_stats(id, &stats);
+  stats.elapsed_time_ms = 6;
+  census_record_rpc_client_stats(id, &stats);
+  census_tracing_end_op(id);
+  census_get_server_latencies(latencies);
+  GPR_ASSERT(gpr_histogram_count(latencies) == 0);
+  census_get_client_latencies(latencies);
+  GPR_ASSERT(gpr_histogram_count(latencies) == 2);
+  GPR_ASSERT(gpr_histogram_minimum(latencies) == 4000);
+  GPR_ASSERT(gpr_histogram_maximum(latencies) == 6000);
+  /* Latencies are handed out once. */
+  census_get_client_latencies(latencies);
+  GPR_ASSERT(gpr_histogram_count(latencies) == 2);
+  census_shutdown();
+  gpr_histogram_destroy(latencies);
+}
+
 static void test_record_stats_on_unknown_op_id(void) {
   census_op_id unknown_id = {0xDEAD, 0xBEEF};
   census_rpc_stats stats = {1, 2, 3, 4, 5.1, 6.2, 7.3, 8.4};
@@ -191,6 +221,7 @@ int main(int argc, char** argv) {
   test_init_shutdown();
   test_create_and_destroy();
   test_record_and_get_stats();
+  test_record_and_get_latencies();
   test_record_stats_on_unknown_op_id();
   test_record_stats_with_trace_store_uninitialized();
   return 0;
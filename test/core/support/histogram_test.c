@@ -33,6 +33,8 @@
 
 #include <grpc/support/histogram.h>
 #include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
 
 #define LOG_TEST() gpr_log(GPR_INFO, "%s", __FUNCTION__);
 
@@ -169,10 +171,94 @@ static void test_merge(void) {
   gpr_histogram_destroy(h2);
 }
 
+#define CONCURRENT_THREADS 8
+#define CONCURRENT_ADDS_PER_THREAD 100000
+
+typedef struct {
+  gpr_concurrent_histogram *h;
+  gpr_mu mu;
+  gpr_cv done_cv;
+  int running;
+} concurrent_test;
+
+static void concurrent_adder(void *arg) {
+  concurrent_test *t = arg;
+  int i;
+  for (i = 0; i < CONCURRENT_ADDS_PER_THREAD; i++) {
+    gpr_concurrent_histogram_add(t->h, 1.0 + i % 10);
+  }
+  gpr_mu_lock(&t->mu);
+  t->running--;
+  gpr_cv_signal(&t->done_cv);
+  gpr_mu_unlock(&t->mu);
+}
+
+static void test_concurrent(void) {
+  concurrent_test t;
+  gpr_histogram *collected;
+  gpr_histogram *snapshot;
+  gpr_thd_id thd;
+  double expected_count = CONCURRENT_THREADS * CONCURRENT_ADDS_PER_THREAD;
+  int i;
+
+  LOG_TEST();
+
+  t.h = gpr_concurrent_histogram_create(0.05, 1e9);
+  gpr_mu_init(&t.mu);
+  gpr_cv_init(&t.done_cv);
+  t.running = CONCURRENT_THREADS;
+
+  /* mismatched layouts are rejected */
+  snapshot = gpr_histogram_create(0.01, 1e9);
+  GPR_ASSERT(gpr_histogram_merge_concurrent(snapshot, t.h) == 0);
+  gpr_histogram_destroy(snapshot);
+
+  collected = gpr_histogram_create(0.05, 1e9);
+  for (i = 0; i < CONCURRENT_THREADS; i++) {
+    GPR_ASSERT(gpr_thd_new(&thd, concurrent_adder, &t, NULL));
+  }
+  /* drain while the adders are running: every sample must be collected
+     exactly once */
+  gpr_mu_lock(&t.mu);
+  while (t.running > 0) {
+    gpr_mu_unlock(&t.mu);
+    GPR_ASSERT(gpr_histogram_merge_and_reset_concurrent(collected, t.h) == 1);
+    gpr_mu_lock(&t.mu);
+  }
+  gpr_mu_unlock(&t.mu);
+  GPR_ASSERT(gpr_histogram_merge_and_reset_concurrent(collected, t.h) == 1);
+
+  GPR_ASSERT(gpr_histogram_count(collected) == expected_count);
+  GPR_ASSERT(gpr_histogram_sum(collected) == expected_count * 5.5);
+  GPR_ASSERT(gpr_histogram_sum_of_squares(collected) == expected_count * 38.5);
+  GPR_ASSERT(gpr_histogram_minimum(collected) == 1.0);
+  GPR_ASSERT(gpr_histogram_maximum(collected) == 10.0);
+  expect_percentile(collected, 50, 5, 6);
+
+  /* after a reset, a plain snapshot sees nothing and leaves new samples in
+     place */
+  snapshot = gpr_histogram_create(0.05, 1e9);
+  GPR_ASSERT(gpr_histogram_merge_concurrent(snapshot, t.h) == 1);
+  GPR_ASSERT(gpr_histogram_count(snapshot) == 0);
+  gpr_concurrent_histogram_add(t.h, 3.0);
+  GPR_ASSERT(gpr_histogram_merge_concurrent(snapshot, t.h) == 1);
+  GPR_ASSERT(gpr_histogram_merge_concurrent(snapshot, t.h) == 1);
+  GPR_ASSERT(gpr_histogram_count(snapshot) == 2);
+  GPR_ASSERT(gpr_histogram_minimum(snapshot) == 3.0);
+  GPR_ASSERT(gpr_histogram_maximum(snapshot) == 3.0);
+  gpr_histogram_destroy(snapshot);
+
+  gpr_histogram_destroy(collected);
+  gpr_concurrent_histogram_destroy(t.h);
+  gpr_mu_destroy(&t.mu);
+  gpr_cv_destroy(&t.done_cv);
+}
+
 int main(void) {
   test_no_op();
   test_simple();
   test_percentile();
   test_merge();
+  test_concurrent();
   return 0;
 }
@@ -0,0 +1,225 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "src/core/support/stack_lockfree.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/atm.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/thd.h>
+#include "test/core/util/test_config.h"
+
+#define MAX_STACK_SIZE 65534
+#define MAX_THREADS 32
+#define OPS_PER_THREAD 20000
+
+static void test_serial_sized(size_t size) {
+  gpr_stack_lockfree *stack = gpr_stack_lockfree_create(size);
+  size_t i;
+
+  /* First try popping empty */
+  GPR_ASSERT(gpr_stack_lockfree_pop(stack) == -1);
+
+  /* Now add one item and check it */
+  GPR_ASSERT(gpr_stack_lockfree_push(stack, 3) == 1);
+  GPR_ASSERT(gpr_stack_lockfree_pop(stack) == 3);
+  GPR_ASSERT(gpr_stack_lockfree_pop(stack) == -1);
+
+  /* Now add repeatedly more items and check them in lifo order */
+  for (i = 1; i < size; i *= 2) {
+    size_t j;
+    for (j = 0; j <= i; j++) {
+      GPR_ASSERT(gpr_stack_lockfree_push(stack, (int)j) == (j == 0));
+    }
+    for (j = 0; j <= i; j++) {
+      GPR_ASSERT(gpr_stack_lockfree_pop(stack) == (int)(i - j));
+    }
+    GPR_ASSERT(gpr_stack_lockfree_pop(stack) == -1);
+  }
+
+  gpr_stack_lockfree_destroy(stack);
+}
+
+static void test_serial(void) {
+  size_t i;
+  for (i = 128; i < MAX_STACK_SIZE; i *= 2) {
+    test_serial_sized(i);
+  }
+  test_serial_sized(MAX_STACK_SIZE);
+}
+
+typedef struct concurrent_test {
+  gpr_stack_lockfree *stack;
+  /* which thread holds each entry, or -1 if it is on the stack */
+  gpr_atm *owner;
+  gpr_mu mu;
+  gpr_cv done_cv;
+  int running;
+  int nth;
+  size_t size;
+} concurrent_test;
+
+typedef struct thread_args {
+  concurrent_test *test;
+  int id;
+} thread_args;
+
+static void finish_thread(concurrent_test *t) {
+  gpr_mu_lock(&t->mu);
+  if (--t->running == 0) {
+    gpr_cv_broadcast(&t->done_cv);
+  }
+  gpr_mu_unlock(&t->mu);
+}
+
+/* pops an entry, checks nobody else holds it, and pushes it back */
+static void pop_push_thread(void *arg) {
+  thread_args *args = arg;
+  concurrent_test *t = args->test;
+  int i;
+  int entry;
+  for (i = 0; i < OPS_PER_THREAD; i++) {
+    entry = gpr_stack_lockfree_pop(t->stack);
+    if (entry == -1) continue;
+    GPR_ASSERT(gpr_atm_no_barrier_cas(&t->owner[entry], -1, args->id));
+    GPR_ASSERT(gpr_atm_no_barrier_cas(&t->owner[entry], args->id, -1));
+    gpr_stack_lockfree_push(t->stack, entry);
+  }
+  finish_thread(t);
+}
+
+/* pushes every nth id, so that all threads first touch the same storage
+   blocks of a fresh stack at once */
+static void push_thread(void *arg) {
+  thread_args *args = arg;
+  concurrent_test *t = args->test;
+  size_t i;
+  for (i = (size_t)args->id; i < t->size; i += (size_t)t->nth) {
+    gpr_stack_lockfree_push(t->stack, (int)i);
+  }
+  finish_thread(t);
+}
+
+static void concurrent_test_init(concurrent_test *t, size_t size, int nth) {
+  t->stack = gpr_stack_lockfree_create(size);
+  t->owner = gpr_malloc(sizeof(gpr_atm) * size);
+  gpr_mu_init(&t->mu);
+  gpr_cv_init(&t->done_cv);
+  t->nth = nth;
+  t->size = size;
+}
+
+static void concurrent_test_destroy(concurrent_test *t) {
+  gpr_free(t->owner);
+  gpr_mu_destroy(&t->mu);
+  gpr_cv_destroy(&t->done_cv);
+  gpr_stack_lockfree_destroy(t->stack);
+}
+
+static void run_threads(concurrent_test *t, void (*body)(void *arg)) {
+  thread_args args[MAX_THREADS];
+  gpr_thd_id thd;
+  int i;
+  t->running = t->nth;
+  for (i = 0; i < t->nth; i++) {
+    args[i].test = t;
+    args[i].id = i;
+    GPR_ASSERT(gpr_thd_new(&thd, body, &args[i], NULL));
+  }
+  gpr_mu_lock(&t->mu);
+  while (t->running > 0) {
+    gpr_cv_wait(&t->done_cv, &t->mu, gpr_inf_future);
+  }
+  gpr_mu_unlock(&t->mu);
+}
+
+/* every entry must be on the stack exactly once */
+static void expect_all_entries(concurrent_test *t) {
+  int *seen = gpr_malloc(sizeof(int) * t->size);
+  size_t i;
+  int entry;
+  memset(seen, 0, sizeof(int) * t->size);
+  for (i = 0; i < t->size; i++) {
+    entry = gpr_stack_lockfree_pop(t->stack);
+    GPR_ASSERT(entry >= 0 && (size_t)entry < t->size);
+    GPR_ASSERT(!seen[entry]);
+    seen[entry] = 1;
+  }
+  GPR_ASSERT(gpr_stack_lockfree_pop(t->stack) == -1);
+  gpr_free(seen);
+}
+
+static void test_mt_sized(size_t size, int nth) {
+  concurrent_test t;
+  size_t i;
+
+  concurrent_test_init(&t, size, nth);
+  for (i = 0; i < size; i++) {
+    gpr_atm_rel_store(&t.owner[i], -1);
+    gpr_stack_lockfree_push(t.stack, (int)i);
+  }
+  run_threads(&t, pop_push_thread);
+  expect_all_entries(&t);
+  concurrent_test_destroy(&t);
+}
+
+static void test_mt_first_push_sized(size_t size, int nth) {
+  concurrent_test t;
+
+  concurrent_test_init(&t, size, nth);
+  run_threads(&t, push_thread);
+  expect_all_entries(&t);
+  concurrent_test_destroy(&t);
+}
+
+static void test_mt(void) {
+  size_t size;
+  int nth;
+  for (nth = 1; nth <= MAX_THREADS; nth *= 2) {
+    for (size = 2; size < MAX_STACK_SIZE; size *= 4) {
+      test_mt_sized(size, nth);
+      test_mt_first_push_sized(size, nth);
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  test_serial();
+  test_mt();
+  return 0;
+}
@@ -184,6 +184,50 @@ static void test_cq_end_client_metadata_read(void) {
   shutdown_and_destroy(cc);
 }
 
+static void test_next_batch(void) {
+  grpc_event *events[16];
+  grpc_completion_queue *cc;
+  void *tags[40];
+  size_t i, n, taken;
+  int on_finish_called = 0;
+
+  LOG_TEST();
+
+  cc = grpc_completion_queue_create();
+
+  GPR_ASSERT(grpc_completion_queue_next_batch(
+                 cc, events, GPR_ARRAY_SIZE(events), gpr_now()) == 0);
+
+  for (i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+    grpc_cq_begin_op(cc, NULL, GRPC_WRITE_ACCEPTED);
+    grpc_cq_end_write_accepted(cc, tags[i], NULL, increment_int_on_finish,
+                               &on_finish_called, GRPC_OP_OK);
+  }
+
+  /* events come back in order, at most max_events at a time */
+  for (taken = 0; taken < GPR_ARRAY_SIZE(tags); taken += n) {
+    n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                         gpr_inf_past);
+    GPR_ASSERT(n == GPR_MIN(GPR_ARRAY_SIZE(events),
+                            GPR_ARRAY_SIZE(tags) - taken));
+    for (i = 0; i < n; i++) {
+      GPR_ASSERT(events[i]->type == GRPC_WRITE_ACCEPTED);
+      GPR_ASSERT(events[i]->tag == tags[taken + i]);
+      grpc_event_finish(events[i]);
+    }
+  }
+  GPR_ASSERT(on_finish_called == GPR_ARRAY_SIZE(tags));
+
+  grpc_completion_queue_shutdown(cc);
+  n = grpc_completion_queue_next_batch(cc, events, GPR_ARRAY_SIZE(events),
+                                       gpr_inf_past);
+  GPR_ASSERT(n == 1);
+  GPR_ASSERT(events[0]->type == GRPC_QUEUE_SHUTDOWN);
+  grpc_event_finish(events[0]);
+  grpc_completion_queue_destroy(cc);
+}
+
 static void test_pluck(void) {
   grpc_event *ev;
   grpc_completion_queue *cc;
@@ -398,6 +442,7 @@ int main(int argc, char **argv) {
   test_cq_end_write_accepted();
   test_cq_end_finish_accepted();
   test_cq_end_client_metadata_read();
+  test_next_batch();
   test_pluck();
   test_threading(1, 1);
   test_threading(1, 10);
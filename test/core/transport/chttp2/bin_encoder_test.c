@@ -33,11 +33,13 @@
 
 #include "src/core/transport/chttp2/bin_encoder.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "src/core/support/string.h"
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 static int all_ok = 1;
 
@@ -112,6 +114,136 @@ static void expect_binary_header(const char *hdr, int binary) {
   }
 }
 
+static void expect_same(gpr_slice a, gpr_slice b, const char *what) {
+  if (0 != gpr_slice_cmp(a, b)) {
+    gpr_log(GPR_ERROR, "FAILED: vectorized and scalar %s differ", what);
+    all_ok = 0;
+  }
+}
+
+/* check the vectorized base64 paths (where this cpu has them) against the
+   scalar ones on random input, and on random input with a character
+   replaced by an arbitrary byte */
+static void test_vectorized_base64(void) {
+  gpr_uint8 raw[300];
+  gpr_uint8 encoded[400];
+  gpr_uint8 decoded[2][300];
+  size_t consumed[2];
+  size_t length;
+  size_t encoded_length;
+  gpr_slice input;
+  gpr_slice b64[2];
+  gpr_slice huff[2];
+  int corrupt;
+  int scalar;
+  int i;
+  size_t j;
+
+  for (i = 0; i < 2000; i++) {
+    length = rand() % sizeof(raw);
+    for (j = 0; j < length; j++) {
+      raw[j] = (gpr_uint8)rand();
+    }
+    input = gpr_slice_from_copied_buffer((const char *)raw, length);
+
+    for (scalar = 0; scalar < 2; scalar++) {
+      grpc_chttp2_base64_force_scalar_for_testing = scalar;
+      b64[scalar] = grpc_chttp2_base64_encode(input);
+      huff[scalar] = grpc_chttp2_base64_encode_and_huffman_compress(input);
+    }
+    expect_same(b64[0], b64[1], "base64 encodings");
+    expect_same(huff[0], huff[1], "base64+huffman encodings");
+
+    encoded_length = GPR_SLICE_LENGTH(b64[1]);
+    memcpy(encoded, GPR_SLICE_START_PTR(b64[1]), encoded_length);
+    corrupt = encoded_length > 0 && i % 2;
+    if (corrupt) {
+      encoded[rand() % encoded_length] = (gpr_uint8)rand();
+    }
+    for (scalar = 0; scalar < 2; scalar++) {
+      grpc_chttp2_base64_force_scalar_for_testing = scalar;
+      consumed[scalar] = grpc_chttp2_base64_decode_groups(
+          encoded, encoded_length, decoded[scalar]);
+    }
+    if (consumed[0] != consumed[1] ||
+        0 != memcmp(decoded[0], decoded[1], consumed[0] / 4 * 3)) {
+      gpr_log(GPR_ERROR, "FAILED: vectorized and scalar base64 decodes differ");
+      all_ok = 0;
+    }
+    if (!corrupt && (consumed[1] != encoded_length / 4 * 4 ||
+                     0 != memcmp(decoded[1], raw, consumed[1] / 4 * 3))) {
+      gpr_log(GPR_ERROR, "FAILED: base64 decode did not round trip");
+      all_ok = 0;
+    }
+
+    for (scalar = 0; scalar < 2; scalar++) {
+      gpr_slice_unref(b64[scalar]);
+      gpr_slice_unref(huff[scalar]);
+    }
+    gpr_slice_unref(input);
+  }
+  grpc_chttp2_base64_force_scalar_for_testing = 0;
+}
+
+static double mb_per_sec(size_t bytes, int iterations, gpr_timespec start) {
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(), start);
+  return bytes * (double)iterations /
+         (elapsed.tv_sec + 1e-9 * elapsed.tv_nsec) / 1e6;
+}
+
+/* measure base64 throughput on a blob the size of our tracing headers */
+static void bench_base64(void) {
+  const size_t length = 8192;
+  const int iterations = 2000;
+  gpr_slice input = gpr_slice_malloc(length);
+  gpr_slice encoded;
+  gpr_uint8 *decoded = gpr_malloc(length);
+  gpr_timespec start;
+  double encode_rate;
+  double huff_rate;
+  double decode_rate;
+  size_t i;
+  int scalar;
+  int j;
+
+  for (i = 0; i < length; i++) {
+    GPR_SLICE_START_PTR(input)[i] = (gpr_uint8)rand();
+  }
+  encoded = grpc_chttp2_base64_encode(input);
+
+  for (scalar = 0; scalar < 2; scalar++) {
+    grpc_chttp2_base64_force_scalar_for_testing = scalar;
+    start = gpr_now();
+    for (j = 0; j < iterations; j++) {
+      gpr_slice_unref(grpc_chttp2_base64_encode(input));
+    }
+    encode_rate = mb_per_sec(length, iterations, start);
+    start = gpr_now();
+    for (j = 0; j < iterations; j++) {
+      gpr_slice_unref(grpc_chttp2_base64_encode_and_huffman_compress(input));
+    }
+    huff_rate = mb_per_sec(length, iterations, start);
+    start = gpr_now();
+    for (j = 0; j < iterations; j++) {
+      GPR_ASSERT(GPR_SLICE_LENGTH(encoded) / 4 * 4 ==
+                 grpc_chttp2_base64_decode_groups(GPR_SLICE_START_PTR(encoded),
+                                                  GPR_SLICE_LENGTH(encoded),
+                                                  decoded));
+    }
+    decode_rate = mb_per_sec(length, iterations, start);
+    gpr_log(GPR_INFO,
+            "%s: base64 encode %.1f MB/s, base64+huffman encode %.1f MB/s, "
+            "base64 decode %.1f MB/s",
+            scalar ? "scalar" : "default", encode_rate, huff_rate,
+            decode_rate);
+  }
+  grpc_chttp2_base64_force_scalar_for_testing = 0;
+
+  gpr_free(decoded);
+  gpr_slice_unref(encoded);
+  gpr_slice_unref(input);
+}
+
 int main(int argc, char **argv) {
   /* Base64 test vectors from RFC 4648, with padding removed */
   /* BASE64("") = "" */
@@ -145,6 +277,9 @@ int main(int argc, char **argv) {
   EXPECT_SLICE_EQ(
       "\x9d\x29\xad\x17\x18\x63\xc7\x8f\x0b\x97\xc8\xe9\xae\x82\xae\x43\xd3",
       HUFF("https://www.example.com"));
+  /* long codes, following a short one so that they straddle bytes */
+  EXPECT_SLICE_EQ("\x1f\xff\xfd\x8f\xff\xff\xe2\xff\xff\xfe\x3f",
+                  HUFF("a\x01\x02\x03"));
 
   /* Various test vectors for combined encoding */
   EXPECT_COMBINED_EQUIV("");
@@ -183,5 +318,8 @@ int main(int argc, char **argv) {
   expect_binary_header("foo-bar", 0);
   expect_binary_header("-bin", 0);
 
+  test_vectorized_base64();
+  bench_base64();
+
   return all_ok ? 0 : 1;
 }
@@ -0,0 +1,292 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+
+#include "src/core/transport/chttp2/frame_data.h"
+
+#include <string.h>
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include <grpc/support/useful.h>
+#include "test/core/util/test_config.h"
+
+#define LOG_TEST() gpr_log(GPR_INFO, "%s", __FUNCTION__)
+
+/* Build the grpc framing for count messages of length bytes each: a frame
+   type byte, a big endian length, then the payload ({0,1,2,...}) */
+static gpr_slice make_messages(size_t count, gpr_uint32 length) {
+  gpr_slice slice = gpr_slice_malloc(count * (5 + length));
+  gpr_uint8 *p = GPR_SLICE_START_PTR(slice);
+  size_t i;
+  gpr_uint32 j;
+
+  for (i = 0; i < count; i++) {
+    *p++ = 0;
+    *p++ = (gpr_uint8)(length >> 24);
+    *p++ = (gpr_uint8)(length >> 16);
+    *p++ = (gpr_uint8)(length >> 8);
+    *p++ = (gpr_uint8)length;
+    for (j = 0; j < length; j++) {
+      *p++ = (gpr_uint8)j;
+    }
+  }
+  return slice;
+}
+
+/* Feed data into the parser as a sequence of reads of at most chunk bytes,
+   as a single DATA frame */
+static void parse_in_chunks(grpc_chttp2_data_parser *parser, gpr_slice data,
+                            size_t chunk) {
+  grpc_chttp2_parse_state state;
+  size_t i;
+  size_t len = GPR_SLICE_LENGTH(data);
+  gpr_slice read;
+
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_begin_frame(parser, 0));
+  for (i = 0; i < len; i += chunk) {
+    memset(&state, 0, sizeof(state));
+    read = gpr_slice_sub(data, i, GPR_MIN(len, i + chunk));
+    GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+               grpc_chttp2_data_parser_parse(parser, &state, read,
+                                             i + chunk >= len));
+    gpr_slice_unref(read);
+  }
+}
+
+/* Check that incoming_sopb holds count messages of length bytes, each as a
+   single slice (or no slice at all for empty messages); clears
+   incoming_sopb */
+static void verify_single_slice_messages(grpc_chttp2_data_parser *parser,
+                                         size_t count, gpr_uint32 length) {
+  grpc_stream_op_buffer *sopb = &parser->incoming_sopb;
+  size_t ops_per_message = length == 0 ? 1 : 2;
+  gpr_slice slice;
+  size_t i;
+  gpr_uint32 j;
+
+  GPR_ASSERT(sopb->nops == ops_per_message * count);
+  for (i = 0; i < count; i++) {
+    GPR_ASSERT(sopb->ops[ops_per_message * i].type == GRPC_OP_BEGIN_MESSAGE);
+    GPR_ASSERT(sopb->ops[ops_per_message * i].data.begin_message.length ==
+               length);
+    if (length == 0) continue;
+    GPR_ASSERT(sopb->ops[2 * i + 1].type == GRPC_OP_SLICE);
+    slice = sopb->ops[2 * i + 1].data.slice;
+    GPR_ASSERT(GPR_SLICE_LENGTH(slice) == length);
+    for (j = 0; j < length; j++) {
+      GPR_ASSERT(GPR_SLICE_START_PTR(slice)[j] == (gpr_uint8)j);
+    }
+  }
+  grpc_sopb_reset(sopb);
+}
+
+/* a small message split across reads arrives as one slice */
+static void test_small_message_reassembled(gpr_uint32 length, size_t chunk) {
+  grpc_chttp2_data_parser parser;
+  gpr_slice data = make_messages(3, length);
+
+  gpr_log(GPR_INFO, "test_small_message_reassembled: length=%d chunk=%d",
+          (int)length, (int)chunk);
+
+  grpc_chttp2_data_parser_init(&parser);
+  parse_in_chunks(&parser, data, chunk);
+  GPR_ASSERT(parser.state == GRPC_CHTTP2_DATA_FH_0);
+  verify_single_slice_messages(&parser, 3, length);
+  grpc_chttp2_data_parser_destroy(&parser);
+  gpr_slice_unref(data);
+}
+
+/* a message wholly inside one read is passed up without copying */
+static void test_unsplit_messages_not_copied(void) {
+  grpc_chttp2_data_parser parser;
+  gpr_slice data = make_messages(4, 100);
+  size_t i;
+
+  LOG_TEST();
+
+  grpc_chttp2_data_parser_init(&parser);
+  parse_in_chunks(&parser, data, GPR_SLICE_LENGTH(data));
+  GPR_ASSERT(parser.incoming_sopb.nops == 8);
+  for (i = 0; i < 4; i++) {
+    GPR_ASSERT(parser.incoming_sopb.ops[2 * i + 1].data.slice.refcount ==
+               data.refcount);
+  }
+  verify_single_slice_messages(&parser, 4, 100);
+  grpc_chttp2_data_parser_destroy(&parser);
+  gpr_slice_unref(data);
+}
+
+/* a large message is passed up as references to the read slices */
+static void test_large_message_not_copied(void) {
+  grpc_chttp2_data_parser parser;
+  gpr_uint32 length = GRPC_CHTTP2_DATA_REASSEMBLY_THRESHOLD + 1;
+  gpr_slice data = make_messages(1, length);
+  grpc_stream_op *op;
+  size_t total = 0;
+  size_t i;
+
+  LOG_TEST();
+
+  grpc_chttp2_data_parser_init(&parser);
+  parse_in_chunks(&parser, data, 4000);
+  op = parser.incoming_sopb.ops;
+  GPR_ASSERT(op[0].type == GRPC_OP_BEGIN_MESSAGE);
+  GPR_ASSERT(parser.incoming_sopb.nops > 2);
+  for (i = 1; i < parser.incoming_sopb.nops; i++) {
+    GPR_ASSERT(op[i].type == GRPC_OP_SLICE);
+    GPR_ASSERT(op[i].data.slice.refcount == data.refcount);
+    GPR_ASSERT(0 == memcmp(GPR_SLICE_START_PTR(op[i].data.slice),
+                           GPR_SLICE_START_PTR(data) + 5 + total,
+                           GPR_SLICE_LENGTH(op[i].data.slice)));
+    total += GPR_SLICE_LENGTH(op[i].data.slice);
+  }
+  GPR_ASSERT(total == length);
+  grpc_chttp2_data_parser_destroy(&parser);
+  gpr_slice_unref(data);
+}
+
+/* a stream destroyed midway through reassembly releases the partial
+   message */
+static void test_destroy_while_reassembling(void) {
+  grpc_chttp2_data_parser parser;
+  grpc_chttp2_parse_state state;
+  gpr_slice data = make_messages(1, 1000);
+  gpr_slice read = gpr_slice_sub(data, 0, 500);
+
+  LOG_TEST();
+
+  grpc_chttp2_data_parser_init(&parser);
+  memset(&state, 0, sizeof(state));
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_begin_frame(&parser, 0));
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_parse(&parser, &state, read, 0));
+  GPR_ASSERT(parser.reassembling);
+  grpc_chttp2_data_parser_destroy(&parser);
+  gpr_slice_unref(read);
+  gpr_slice_unref(data);
+}
+
+/* a message can be finished by another parser once the state is swapped
+   over, and its ops land in that parser's incoming_sopb */
+static void test_swap_state_mid_message(void) {
+  grpc_chttp2_data_parser parser;
+  grpc_chttp2_data_parser other;
+  grpc_chttp2_parse_state state;
+  gpr_slice data = make_messages(1, 1000);
+  gpr_slice read;
+
+  LOG_TEST();
+
+  grpc_chttp2_data_parser_init(&parser);
+  grpc_chttp2_data_parser_init(&other);
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_begin_frame(&parser, 0));
+  memset(&state, 0, sizeof(state));
+  read = gpr_slice_sub(data, 0, 500);
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_parse(&parser, &state, read, 0));
+  gpr_slice_unref(read);
+  GPR_ASSERT(parser.reassembling);
+  GPR_ASSERT(parser.incoming_sopb.nops == 1);
+  grpc_sopb_reset(&parser.incoming_sopb);
+
+  grpc_chttp2_data_parser_swap_state(&other, &parser);
+  GPR_ASSERT(!parser.reassembling);
+  GPR_ASSERT(other.reassembling);
+  memset(&state, 0, sizeof(state));
+  read = gpr_slice_sub(data, 500, GPR_SLICE_LENGTH(data));
+  GPR_ASSERT(GRPC_CHTTP2_PARSE_OK ==
+             grpc_chttp2_data_parser_parse(&other, &state, read, 1));
+  gpr_slice_unref(read);
+  grpc_chttp2_data_parser_swap_state(&other, &parser);
+
+  GPR_ASSERT(parser.state == GRPC_CHTTP2_DATA_FH_0);
+  GPR_ASSERT(parser.incoming_sopb.nops == 0);
+  GPR_ASSERT(other.incoming_sopb.nops == 1);
+  GPR_ASSERT(other.incoming_sopb.ops[0].type == GRPC_OP_SLICE);
+  GPR_ASSERT(GPR_SLICE_LENGTH(other.incoming_sopb.ops[0].data.slice) == 1000);
+  grpc_chttp2_data_parser_destroy(&parser);
+  grpc_chttp2_data_parser_destroy(&other);
+  gpr_slice_unref(data);
+}
+
+/* time parsing 2kb messages arriving as 1000 byte reads */
+static void bench_split_messages(void) {
+  grpc_chttp2_data_parser parser;
+  gpr_slice data = make_messages(100, 2048);
+  gpr_timespec start, elapsed;
+  size_t slices = 0;
+  int i;
+
+  LOG_TEST();
+
+  grpc_chttp2_data_parser_init(&parser);
+  start = gpr_now();
+  for (i = 0; i < 1000; i++) {
+    parse_in_chunks(&parser, data, 1000);
+    slices += parser.incoming_sopb.nops - 100;
+    grpc_sopb_reset(&parser.incoming_sopb);
+  }
+  elapsed = gpr_time_sub(gpr_now(), start);
+  gpr_log(GPR_INFO, "%.1f ns/message, %.2f slices/message",
+          (elapsed.tv_sec * 1e9 + elapsed.tv_nsec) / (100 * 1000),
+          (double)slices / (100 * 1000));
+  grpc_chttp2_data_parser_destroy(&parser);
+  gpr_slice_unref(data);
+}
+
+int main(int argc, char **argv) {
+  static const gpr_uint32 lengths[] = {
+      0, 1, 10, 2048, GRPC_CHTTP2_DATA_REASSEMBLY_THRESHOLD};
+  static const size_t chunks[] = {1, 3, 1000, 8192};
+  size_t i, j;
+
+  grpc_test_init(argc, argv);
+
+  for (i = 0; i < GPR_ARRAY_SIZE(lengths); i++) {
+    for (j = 0; j < GPR_ARRAY_SIZE(chunks); j++) {
+      test_small_message_reassembled(lengths[i], chunks[j]);
+    }
+  }
+  test_unsplit_messages_not_copied();
+  test_large_message_not_copied();
+  test_destroy_while_reassembling();
+  test_swap_state_mid_message();
+  bench_split_messages();
+
+  return 0;
+}
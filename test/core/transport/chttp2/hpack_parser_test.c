@@ -34,10 +34,15 @@
 #include "src/core/transport/chttp2/hpack_parser.h"
 
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "src/core/transport/chttp2/bin_encoder.h"
+#include "src/core/transport/chttp2/huffsyms.h"
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 #include <grpc/support/slice.h>
+#include <grpc/support/time.h>
 #include "test/core/util/parse_hexstring.h"
 #include "test/core/util/slice_splitter.h"
 #include "test/core/util/test_config.h"
@@ -215,9 +220,279 @@ static void test_vectors(grpc_slice_split_mode mode) {
   grpc_mdctx_unref(mdctx);
 }
 
+static void note_interned(void *user_data, grpc_mdelem *md) {
+  int *interned = user_data;
+  *interned = grpc_mdelem_is_interned(md);
+  grpc_mdelem_unref(md);
+}
+
+static int parse_one_is_interned(grpc_chttp2_hpack_parser *parser,
+                                 const char *hexstring) {
+  gpr_slice input = parse_hexstring(hexstring);
+  int interned = -1;
+  parser->on_header = note_interned;
+  parser->on_header_user_data = &interned;
+  GPR_ASSERT(grpc_chttp2_hpack_parser_parse(
+      parser, GPR_SLICE_START_PTR(input), GPR_SLICE_END_PTR(input)));
+  gpr_slice_unref(input);
+  GPR_ASSERT(interned != -1);
+  return interned;
+}
+
+static void test_uninterned_values(void) {
+  grpc_chttp2_hpack_parser parser;
+  grpc_mdctx *mdctx = grpc_mdctx_create();
+
+  grpc_chttp2_hpack_parser_init(&parser, mdctx);
+  grpc_chttp2_hpack_parser_add_uninterned_key(
+      &parser, grpc_mdstr_from_string(mdctx, "x-request-id"));
+  /* never indexed: password: secret */
+  GPR_ASSERT(!parse_one_is_interned(
+      &parser, "1008 7061 7373 776f 7264 0673 6563 7265 74"));
+  /* never indexed, but a pseudo-header: :path: /a */
+  GPR_ASSERT(parse_one_is_interned(&parser, "1402 2f61"));
+  /* not indexed, configured key: x-request-id: abc */
+  GPR_ASSERT(!parse_one_is_interned(
+      &parser, "000c 782d 7265 7175 6573 742d 6964 0361 6263"));
+  /* not indexed, any other key: custom-key: v */
+  GPR_ASSERT(parse_one_is_interned(
+      &parser, "000a 6375 7374 6f6d 2d6b 6579 0176"));
+  /* incrementally indexed values are interned whatever their key */
+  GPR_ASSERT(parse_one_is_interned(
+      &parser, "400c 782d 7265 7175 6573 742d 6964 0361 6263"));
+  grpc_chttp2_hpack_parser_destroy(&parser);
+
+  /* reserved keys stay interned even when configured */
+  grpc_chttp2_hpack_parser_init(&parser, mdctx);
+  grpc_chttp2_hpack_parser_add_uninterned_key(
+      &parser, grpc_mdstr_from_string(mdctx, "content-type"));
+  grpc_chttp2_hpack_parser_add_uninterned_key(
+      &parser, grpc_mdstr_from_string(mdctx, ":path"));
+  /* not indexed, configured: content-type: a */
+  GPR_ASSERT(parse_one_is_interned(
+      &parser, "000c 636f 6e74 656e 742d 7479 7065 0161"));
+  /* not indexed, configured: :path: /a */
+  GPR_ASSERT(parse_one_is_interned(&parser, "0402 2f61"));
+  grpc_chttp2_hpack_parser_destroy(&parser);
+
+  grpc_mdctx_unref(mdctx);
+}
+
+/* decode a huffman encoded string a bit at a time, straight from the code
+   table: whole symbols are emitted (except end of stream), trailing bits are
+   dropped */
+static gpr_slice reference_huff_decode(gpr_slice input) {
+  size_t length = GPR_SLICE_LENGTH(input);
+  gpr_uint8 *out = gpr_malloc(length * 8 / 5 + 1);
+  size_t nout = 0;
+  unsigned code = 0;
+  unsigned code_length = 0;
+  size_t i;
+  int bit;
+  int sym;
+  gpr_slice result;
+
+  for (i = 0; i < length; i++) {
+    for (bit = 7; bit >= 0; bit--) {
+      code = (code << 1) | ((GPR_SLICE_START_PTR(input)[i] >> bit) & 1);
+      code_length++;
+      for (sym = 0; sym < GRPC_CHTTP2_NUM_HUFFSYMS; sym++) {
+        if (grpc_chttp2_huffsyms[sym].length == code_length &&
+            grpc_chttp2_huffsyms[sym].bits == code) {
+          if (sym != 256) out[nout++] = (gpr_uint8)sym;
+          code = 0;
+          code_length = 0;
+          break;
+        }
+      }
+    }
+  }
+
+  result = gpr_slice_from_copied_buffer((char *)out, nout);
+  gpr_free(out);
+  return result;
+}
+
+/* build a literal header (without indexing, with a new name) whose value is
+   given already huffman encoded */
+static gpr_slice huff_literal_header(const char *key, gpr_slice huff_value) {
+  size_t key_length = strlen(key);
+  size_t value_length = GPR_SLICE_LENGTH(huff_value);
+  gpr_uint8 *buf = gpr_malloc(2 + key_length + 6 + value_length);
+  gpr_uint8 *p = buf;
+  gpr_slice out;
+
+  GPR_ASSERT(key_length < 127);
+  *p++ = 0x00;
+  *p++ = (gpr_uint8)key_length;
+  memcpy(p, key, key_length);
+  p += key_length;
+  if (value_length < 127) {
+    *p++ = 0x80 | (gpr_uint8)value_length;
+  } else {
+    value_length -= 127;
+    *p++ = 0xff;
+    while (value_length >= 128) {
+      *p++ = 0x80 | (gpr_uint8)(value_length & 0x7f);
+      value_length >>= 7;
+    }
+    *p++ = (gpr_uint8)value_length;
+  }
+  memcpy(p, GPR_SLICE_START_PTR(huff_value), GPR_SLICE_LENGTH(huff_value));
+  p += GPR_SLICE_LENGTH(huff_value);
+  out = gpr_slice_from_copied_buffer((char *)buf, p - buf);
+  gpr_free(buf);
+  return out;
+}
+
+typedef struct {
+  gpr_slice expected_value;
+  int seen;
+} huff_checker;
+
+static void on_huff_header(void *user_data, grpc_mdelem *md) {
+  huff_checker *chk = user_data;
+  GPR_ASSERT(0 == gpr_slice_cmp(md->value->slice, chk->expected_value));
+  chk->seen++;
+  grpc_mdelem_unref(md);
+}
+
+/* parse a single huffman encoded header in the given split mode and check
+   that its value decodes to expected_value */
+static void verify_huff_value(grpc_chttp2_hpack_parser *parser,
+                              grpc_slice_split_mode mode, const char *key,
+                              gpr_slice huff_value, gpr_slice expected_value) {
+  gpr_slice input = huff_literal_header(key, huff_value);
+  gpr_slice *slices;
+  size_t nslices;
+  size_t i;
+  huff_checker chk;
+
+  chk.expected_value = expected_value;
+  chk.seen = 0;
+  parser->on_header = on_huff_header;
+  parser->on_header_user_data = &chk;
+
+  grpc_split_slices(mode, &input, 1, &slices, &nslices);
+  gpr_slice_unref(input);
+  for (i = 0; i < nslices; i++) {
+    GPR_ASSERT(grpc_chttp2_hpack_parser_parse(
+        parser, GPR_SLICE_START_PTR(slices[i]), GPR_SLICE_END_PTR(slices[i])));
+    gpr_slice_unref(slices[i]);
+  }
+  gpr_free(slices);
+  GPR_ASSERT(chk.seen == 1);
+}
+
+static gpr_slice random_slice(size_t length, int printable) {
+  gpr_slice s = gpr_slice_malloc(length);
+  size_t i;
+  for (i = 0; i < length; i++) {
+    GPR_SLICE_START_PTR(s)[i] =
+        printable ? (gpr_uint8)(' ' + rand() % 95) : (gpr_uint8)rand();
+  }
+  return s;
+}
+
+/* check the huffman decoder against the reference decoder on random bit
+   strings (including ones with long codes, end of stream symbols and
+   arbitrary trailing bits), and check that encoded strings round trip */
+static void test_huffman_fuzz(grpc_slice_split_mode mode) {
+  grpc_chttp2_hpack_parser parser;
+  grpc_mdctx *mdctx = grpc_mdctx_create();
+  gpr_slice raw;
+  gpr_slice expected;
+  gpr_slice encoded;
+  int i;
+
+  grpc_chttp2_hpack_parser_init(&parser, mdctx);
+  for (i = 0; i < 1000; i++) {
+    raw = random_slice(rand() % 300, 0);
+    expected = reference_huff_decode(raw);
+    verify_huff_value(&parser, mode, "k", raw, expected);
+    gpr_slice_unref(expected);
+    gpr_slice_unref(raw);
+
+    raw = random_slice(rand() % 300, i % 2);
+    encoded = grpc_chttp2_huffman_compress(raw);
+    verify_huff_value(&parser, mode, "k", encoded, raw);
+    gpr_slice_unref(encoded);
+    encoded = grpc_chttp2_base64_encode_and_huffman_compress(raw);
+    verify_huff_value(&parser, mode, "k-bin", encoded, raw);
+    gpr_slice_unref(encoded);
+    gpr_slice_unref(raw);
+  }
+  grpc_chttp2_hpack_parser_destroy(&parser);
+  grpc_mdctx_unref(mdctx);
+}
+
+static void discard_header(void *user_data, grpc_mdelem *md) {
+  grpc_mdelem_unref(md);
+}
+
+/* measure huffman decoding throughput on header values typical of our
+   traffic */
+static void bench_huffman_decode(void) {
+  static const char *values[] = {
+      "/grpc.testing.TestService/StreamingFromServer",
+      "grpc-c/0.5.0 (linux; chttp2)",
+      "Bearer ya29.AHES6ZRVmB7fkLtd1XTmq6mo0S1wqZZi3-Lh_s-6Uw7p8vtgSwg",
+      "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01",
+      "application/grpc+proto"};
+  const int nvalues = sizeof(values) / sizeof(*values);
+  const int iterations = 20000;
+  grpc_chttp2_hpack_parser parser;
+  grpc_mdctx *mdctx = grpc_mdctx_create();
+  gpr_slice_buffer block;
+  gpr_slice input;
+  gpr_slice raw;
+  gpr_slice encoded;
+  size_t huff_bytes = 0;
+  gpr_timespec start;
+  gpr_timespec elapsed;
+  double seconds;
+  int i;
+
+  gpr_slice_buffer_init(&block);
+  for (i = 0; i < nvalues; i++) {
+    raw = gpr_slice_from_copied_string(values[i]);
+    encoded = grpc_chttp2_huffman_compress(raw);
+    huff_bytes += GPR_SLICE_LENGTH(encoded);
+    gpr_slice_buffer_add(&block, huff_literal_header("x-bench", encoded));
+    gpr_slice_unref(encoded);
+    gpr_slice_unref(raw);
+  }
+  input = grpc_slice_merge(block.slices, block.count);
+  gpr_slice_buffer_destroy(&block);
+
+  grpc_chttp2_hpack_parser_init(&parser, mdctx);
+  parser.on_header = discard_header;
+  parser.on_header_user_data = NULL;
+  start = gpr_now();
+  for (i = 0; i < iterations; i++) {
+    GPR_ASSERT(grpc_chttp2_hpack_parser_parse(&parser,
+                                              GPR_SLICE_START_PTR(input),
+                                              GPR_SLICE_END_PTR(input)));
+  }
+  elapsed = gpr_time_sub(gpr_now(), start);
+  seconds = elapsed.tv_sec + 1e-9 * elapsed.tv_nsec;
+  gpr_log(GPR_INFO,
+          "huffman decode: %.1f MB/s of encoded input, %.1f ns/header",
+          huff_bytes * (double)iterations / seconds / 1e6,
+          seconds * 1e9 / (iterations * nvalues));
+
+  grpc_chttp2_hpack_parser_destroy(&parser);
+  gpr_slice_unref(input);
+  grpc_mdctx_unref(mdctx);
+}
+
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   test_vectors(GRPC_SLICE_SPLIT_MERGE_ALL);
   test_vectors(GRPC_SLICE_SPLIT_ONE_BYTE);
+  test_uninterned_values();
+  test_huffman_fuzz(GRPC_SLICE_SPLIT_MERGE_ALL);
+  test_huffman_fuzz(GRPC_SLICE_SPLIT_ONE_BYTE);
+  bench_huffman_decode();
   return 0;
 }
@@ -72,8 +72,8 @@ static void verify_sopb(size_t window_available, int eof,
   GPR_ASSERT(expect_window_used ==
              grpc_chttp2_preencode(g_sopb.ops, &g_sopb.nops, window_available,
                                    &encops));
-  grpc_chttp2_encode(encops.ops, encops.nops, eof, 0xdeadbeef, &g_compressor,
-                     &output);
+  grpc_chttp2_encode(encops.ops, encops.nops, eof, 0xdeadbeef,
+                     GRPC_CHTTP2_MAX_PAYLOAD_LENGTH, &g_compressor, &output);
   encops.nops = 0;
   merged = grpc_slice_merge(output.slices, output.count);
   gpr_slice_buffer_destroy(&output);
@@ -130,6 +130,60 @@ static void test_small_data_framing(void) {
   verify_sopb(10, 0, 5, "000005 0000 deadbeef 00000000ff");
 }
 
+/* encode a single data slice of length bytes with the given frame size
+   limit, and check that it is split into frames of at most that size */
+static void verify_large_frame_framing(size_t length, gpr_uint32 max_frame_size,
+                                       size_t expect_frames) {
+  gpr_slice_buffer output;
+  grpc_stream_op_buffer encops;
+  gpr_slice merged;
+  gpr_uint8 *p;
+  gpr_uint8 *end;
+  size_t frames = 0;
+  size_t payload = 0;
+  size_t frame_size;
+
+  gpr_slice_buffer_init(&output);
+  grpc_sopb_init(&encops);
+  grpc_sopb_add_slice(&g_sopb, create_test_slice(length));
+  GPR_ASSERT(length == grpc_chttp2_preencode(g_sopb.ops, &g_sopb.nops,
+                                             length, &encops));
+  grpc_chttp2_encode(encops.ops, encops.nops, 0, 0xdeadbeef, max_frame_size,
+                     &g_compressor, &output);
+  encops.nops = 0;
+  merged = grpc_slice_merge(output.slices, output.count);
+  gpr_slice_buffer_destroy(&output);
+  grpc_sopb_destroy(&encops);
+
+  p = GPR_SLICE_START_PTR(merged);
+  end = GPR_SLICE_END_PTR(merged);
+  while (p != end) {
+    GPR_ASSERT(end - p >= 9);
+    frame_size = (((size_t)p[0]) << 16) | (((size_t)p[1]) << 8) | p[2];
+    GPR_ASSERT(p[3] == GRPC_CHTTP2_FRAME_DATA);
+    GPR_ASSERT(frame_size <= max_frame_size);
+    GPR_ASSERT((size_t)(end - p) >= 9 + frame_size);
+    p += 9 + frame_size;
+    payload += frame_size;
+    frames++;
+  }
+  GPR_ASSERT(payload == length);
+  if (frames != expect_frames) {
+    gpr_log(GPR_ERROR, "expected %d frames, got %d", (int)expect_frames,
+            (int)frames);
+    g_failure = 1;
+  }
+
+  gpr_slice_unref(merged);
+}
+
+static void test_large_frame_framing(void) {
+  verify_large_frame_framing(40000, GRPC_CHTTP2_MAX_PAYLOAD_LENGTH, 3);
+  verify_large_frame_framing(40000, 16384, 3);
+  verify_large_frame_framing(40000, 65536, 1);
+  verify_large_frame_framing(1048576, 16777215, 1);
+}
+
 static void add_sopb_header(const char *key, const char *value) {
   grpc_sopb_add_metadata(&g_sopb,
                          grpc_mdelem_from_strings(g_mdctx, key, value));
@@ -264,8 +318,8 @@ static void test_decode_random_headers_inner(int max_len) {
     gpr_slice_buffer_init(&output);
     GPR_ASSERT(0 ==
                grpc_chttp2_preencode(g_sopb.ops, &g_sopb.nops, 0, &encops));
-    grpc_chttp2_encode(encops.ops, encops.nops, 0, 0xdeadbeef, &g_compressor,
-                       &output);
+    grpc_chttp2_encode(encops.ops, encops.nops, 0, 0xdeadbeef,
+                       GRPC_CHTTP2_MAX_PAYLOAD_LENGTH, &g_compressor, &output);
     encops.nops = 0;
     merged = grpc_slice_merge(output.slices, output.count);
     gpr_slice_buffer_destroy(&output);
@@ -316,6 +370,7 @@ static void run_test(void (*test)(), const char *name) {
 int main(int argc, char **argv) {
   grpc_test_init(argc, argv);
   TEST(test_small_data_framing);
+  TEST(test_large_frame_framing);
   TEST(test_basic_headers);
   TEST(test_decode_table_overflow);
   TEST(test_decode_random_headers_1);
@@ -32,7 +32,13 @@
  */
 
 #include "src/core/transport/chttp2/stream_map.h"
+
+#include <stdlib.h>
+
+#include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include <grpc/support/useful.h>
 #include "test/core/util/test_config.h"
 
 #define LOG_TEST() gpr_log(GPR_INFO, "%s", __FUNCTION__)
@@ -202,6 +208,140 @@ static void test_periodic_compaction(size_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* verify that for_each visits keys in ascending order */
+static void verify_ascending(void *user_data, gpr_uint32 stream_id,
+                             void *ptr) {
+  gpr_uint32 *last = user_data;
+  GPR_ASSERT(ptr);
+  GPR_ASSERT(*last < stream_id);
+  *last = stream_id;
+}
+
+/* keep a few early keys alive while n later ones come and go, and ensure
+   they stay findable without the backing ring growing to cover them */
+static void test_long_lived_streams(size_t n) {
+  grpc_chttp2_stream_map map;
+  gpr_uint32 last = 0;
+  size_t last_key = 3 + n;
+  size_t first_live = last_key >= 11 ? last_key - 7 : 4;
+  size_t i;
+  size_t del;
+
+  LOG_TEST();
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 16);
+  for (i = 1; i <= last_key; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void *)i);
+    if (i >= 12) {
+      del = i - 8;
+      GPR_ASSERT((void *)del == grpc_chttp2_stream_map_delete(&map, del));
+    }
+  }
+  GPR_ASSERT(map.capacity <= 128);
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == 3 + GPR_MIN(n, 8));
+  for (i = 1; i <= last_key; i++) {
+    if (i <= 3 || i >= first_live) {
+      GPR_ASSERT((void *)i == grpc_chttp2_stream_map_find(&map, i));
+    } else {
+      GPR_ASSERT(NULL == grpc_chttp2_stream_map_find(&map, i));
+    }
+  }
+  grpc_chttp2_stream_map_for_each(&map, verify_ascending, &last);
+  GPR_ASSERT(last == last_key);
+  for (i = 1; i <= 3; i++) {
+    GPR_ASSERT((void *)i == grpc_chttp2_stream_map_delete(&map, i));
+    GPR_ASSERT(NULL == grpc_chttp2_stream_map_find(&map, i));
+  }
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == GPR_MIN(n, 8));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+/* open n streams at once, then close all but the first and the last: the
+   ring must shrink back to about its initial size, and the overflow must go
+   once its last entry is deleted */
+static void test_shrink_after_burst(size_t n) {
+  grpc_chttp2_stream_map map;
+  gpr_uint32 last = 0;
+  size_t i;
+
+  LOG_TEST();
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 16);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, i, (void *)i);
+  }
+  for (i = 2; i < n; i++) {
+    GPR_ASSERT((void *)i == grpc_chttp2_stream_map_delete(&map, i));
+  }
+  /* two live entries may keep a 32 slot ring */
+  GPR_ASSERT(map.capacity <= 32);
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == GPR_MIN(n, 2));
+  GPR_ASSERT((void *)1 == grpc_chttp2_stream_map_find(&map, 1));
+  GPR_ASSERT((void *)n == grpc_chttp2_stream_map_find(&map, n));
+  grpc_chttp2_stream_map_for_each(&map, verify_ascending, &last);
+  GPR_ASSERT(last == n);
+
+  GPR_ASSERT((void *)1 == grpc_chttp2_stream_map_delete(&map, 1));
+  GPR_ASSERT(map.overflow_capacity == 0);
+  if (n > 1) {
+    GPR_ASSERT((void *)n == grpc_chttp2_stream_map_delete(&map, n));
+  }
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == 0);
+  GPR_ASSERT(map.capacity == 16);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
+static double ns_per_op(gpr_timespec start, size_t ops) {
+  gpr_timespec elapsed = gpr_time_sub(gpr_now(), start);
+  return (elapsed.tv_sec * 1e9 + elapsed.tv_nsec) / ops;
+}
+
+/* time finds, and streams closing in random order with new ones opening,
+   with 10k concurrent streams (using client stream ids, as http2 does) */
+static void bench_concurrent_streams(void) {
+  enum { STREAMS = 10000, FINDS = 1000000, CHURNS = 1000000 };
+  grpc_chttp2_stream_map map;
+  gpr_uint32 *live = gpr_malloc(sizeof(gpr_uint32) * STREAMS);
+  gpr_uint32 next_id = 1;
+  gpr_timespec start;
+  size_t i, j;
+  size_t found = 0;
+
+  LOG_TEST();
+
+  srand(42);
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 0; i < STREAMS; i++) {
+    live[i] = next_id;
+    grpc_chttp2_stream_map_add(&map, next_id, &live[i]);
+    next_id += 2;
+  }
+
+  start = gpr_now();
+  for (i = 0; i < CHURNS; i++) {
+    j = (size_t)rand() % STREAMS;
+    GPR_ASSERT(&live[j] == grpc_chttp2_stream_map_delete(&map, live[j]));
+    live[j] = next_id;
+    grpc_chttp2_stream_map_add(&map, next_id, &live[j]);
+    next_id += 2;
+  }
+  gpr_log(GPR_INFO, "delete+add: %.1f ns", ns_per_op(start, CHURNS));
+
+  start = gpr_now();
+  for (i = 0; i < FINDS; i++) {
+    j = (size_t)rand() % STREAMS;
+    found += grpc_chttp2_stream_map_find(&map, live[j]) == &live[j];
+  }
+  gpr_log(GPR_INFO, "find: %.1f ns", ns_per_op(start, FINDS));
+  GPR_ASSERT(found == FINDS);
+  GPR_ASSERT(grpc_chttp2_stream_map_size(&map) == STREAMS);
+
+  grpc_chttp2_stream_map_destroy(&map);
+  gpr_free(live);
+}
+
 int main(int argc, char **argv) {
   int n = 1;
   int prev = 1;
@@ -218,11 +358,15 @@ int main(int argc, char **argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_long_lived_streams(n);
+    test_shrink_after_burst(n);
 
     tmp = n;
     n += prev;
     prev = tmp;
   }
 
+  bench_concurrent_streams();
+
   return 0;
 }
@@ -0,0 +1,83 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "src/core/transport/metadata.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+#include "test/core/util/test_config.h"
+
+#define NUM_HEADERS 100000
+
+/* reports the cost of building a metadata element for a value seen only
+   once, as for request ids, with and without interning the value */
+static void bench_unique_values(void) {
+  grpc_mdctx *ctx;
+  char buffer[64];
+  long i;
+  int uninterned;
+  gpr_timespec start, elapsed;
+  grpc_mdstr *key;
+
+  ctx = grpc_mdctx_create();
+  key = grpc_mdstr_from_string(ctx, "x-request-id");
+  for (uninterned = 0; uninterned <= 1; uninterned++) {
+    start = gpr_now();
+    for (i = 0; i < NUM_HEADERS; i++) {
+      sprintf(buffer, "request-%08ld-0123456789abcdef", i);
+      if (uninterned) {
+        grpc_mdelem_unref(grpc_mdelem_from_uninterned_value(
+            ctx, grpc_mdstr_ref(key), (const gpr_uint8 *)buffer,
+            strlen(buffer)));
+      } else {
+        grpc_mdelem_unref(grpc_mdelem_from_metadata_strings(
+            ctx, grpc_mdstr_ref(key), grpc_mdstr_from_string(ctx, buffer)));
+      }
+    }
+    elapsed = gpr_time_sub(gpr_now(), start);
+    gpr_log(GPR_INFO, "%s: %.1f ns/header",
+            uninterned ? "uninterned" : "interned",
+            (elapsed.tv_sec * 1e9 + elapsed.tv_nsec) / NUM_HEADERS);
+  }
+  grpc_mdstr_unref(key);
+  grpc_mdctx_unref(ctx);
+}
+
+int main(int argc, char **argv) {
+  grpc_test_init(argc, argv);
+  bench_unique_values();
+  return 0;
+}
@@ -34,6 +34,7 @@
 #include "src/core/transport/metadata.h"
 
 #include <stdio.h>
+#include <string.h>
 
 #include "src/core/support/string.h"
 #include "src/core/transport/chttp2/bin_encoder.h"
@@ -174,6 +175,107 @@ static void test_spin_creating_the_same_thing(void) {
   grpc_mdctx_unref(ctx);
 }
 
+static void test_incremental_gc(void) {
+  grpc_mdctx *ctx;
+  char buffer[GPR_LTOA_MIN_BUFSIZE];
+  long i;
+  grpc_mdelem **created = gpr_malloc(sizeof(grpc_mdelem *) * MANY);
+  grpc_mdelem *md;
+  grpc_mdctx_stats stats;
+  size_t max_free = 0;
+  size_t capacity;
+
+  LOG_TEST();
+
+  ctx = grpc_mdctx_create();
+  /* a population of live elements... */
+  for (i = 0; i < MANY; i++) {
+    gpr_ltoa(i, buffer);
+    created[i] = grpc_mdelem_from_strings(ctx, "live", buffer);
+  }
+  capacity = grpc_mdctx_get_mdtab_capacity_test_only(ctx);
+  /* ...interleaved with a stream of unique, immediately discarded ones: the
+     garbage must be reclaimed as we go, without growing the table */
+  for (i = 0; i < 10 * MANY; i++) {
+    gpr_ltoa(i, buffer);
+    grpc_mdelem_unref(grpc_mdelem_from_strings(ctx, "dead", buffer));
+    max_free = GPR_MAX(max_free, grpc_mdctx_get_mdtab_free_test_only(ctx));
+  }
+  GPR_ASSERT(capacity == grpc_mdctx_get_mdtab_capacity_test_only(ctx));
+  GPR_ASSERT(max_free <= 2 * capacity);
+
+  grpc_mdctx_get_stats(ctx, &stats);
+  GPR_ASSERT(stats.mdtab_capacity == capacity);
+  GPR_ASSERT(stats.mdtab_count - stats.mdtab_free == MANY);
+  GPR_ASSERT(stats.mdtab_gc_steps > 0);
+  GPR_ASSERT(stats.mdtab_gc_freed + stats.mdtab_free >= 10 * MANY);
+  gpr_log(GPR_INFO,
+          "mdtab: capacity=%d max_free=%d gc_steps=%d "
+          "pause_total=%dus pause_max=%dus",
+          (int)capacity, (int)max_free, (int)stats.mdtab_gc_steps,
+          (int)(stats.mdtab_gc_pause_total.tv_sec * 1000000 +
+                stats.mdtab_gc_pause_total.tv_nsec / 1000),
+          (int)(stats.mdtab_gc_pause_max.tv_sec * 1000000 +
+                stats.mdtab_gc_pause_max.tv_nsec / 1000));
+
+  /* live elements survive collection */
+  for (i = 0; i < MANY; i++) {
+    gpr_ltoa(i, buffer);
+    md = grpc_mdelem_from_strings(ctx, "live", buffer);
+    GPR_ASSERT(md == created[i]);
+    grpc_mdelem_unref(md);
+    grpc_mdelem_unref(created[i]);
+  }
+  grpc_mdctx_unref(ctx);
+
+  gpr_free(created);
+}
+
+static void test_uninterned_metadata(void) {
+  grpc_mdctx *ctx;
+  grpc_mdelem *m1, *m2, *m3;
+  grpc_mdstr *value;
+  gpr_slice slice;
+  grpc_mdctx_stats stats;
+
+  LOG_TEST();
+
+  ctx = grpc_mdctx_create();
+  m1 = grpc_mdelem_from_uninterned_value(
+      ctx, grpc_mdstr_from_string(ctx, "a"), (const gpr_uint8 *)"b", 1);
+  m2 = grpc_mdelem_from_uninterned_value(
+      ctx, grpc_mdstr_from_string(ctx, "a"), (const gpr_uint8 *)"b", 1);
+  m3 = grpc_mdelem_from_strings(ctx, "a", "b");
+  GPR_ASSERT(!grpc_mdelem_is_interned(m1));
+  GPR_ASSERT(grpc_mdelem_is_interned(m3));
+  /* keys are shared, values are not */
+  GPR_ASSERT(m1 != m2);
+  GPR_ASSERT(m1->key == m2->key);
+  GPR_ASSERT(m1->key == m3->key);
+  GPR_ASSERT(m1->value != m2->value);
+  GPR_ASSERT(m1->value != m3->value);
+  GPR_ASSERT(0 == gpr_slice_str_cmp(m1->value->slice, "b"));
+  GPR_ASSERT(0 == strcmp(grpc_mdstr_as_c_string(m2->value), "b"));
+  /* nothing lands in the tables */
+  grpc_mdctx_get_stats(ctx, &stats);
+  GPR_ASSERT(stats.mdtab_count == 1);
+  GPR_ASSERT(stats.uninterned_count == 2);
+
+  /* the value outlives its element, and the context outlives the value */
+  value = grpc_mdstr_ref(m1->value);
+  slice = gpr_slice_ref(m2->value->slice);
+  GPR_ASSERT(grpc_mdelem_ref(m1) == m1);
+  grpc_mdelem_unref(m1);
+  grpc_mdelem_unref(m1);
+  grpc_mdelem_unref(m2);
+  grpc_mdelem_unref(m3);
+  grpc_mdctx_unref(ctx);
+  GPR_ASSERT(0 == gpr_slice_str_cmp(value->slice, "b"));
+  GPR_ASSERT(0 == gpr_slice_str_cmp(slice, "b"));
+  grpc_mdstr_unref(value);
+  gpr_slice_unref(slice);
+}
+
 static void test_things_stick_around(void) {
   grpc_mdctx *ctx;
   int i, j;
@@ -275,6 +377,8 @@ int main(int argc, char **argv) {
   test_create_many_ephemeral_metadata();
   test_create_many_persistant_metadata();
   test_spin_creating_the_same_thing();
+  test_incremental_gc();
+  test_uninterned_metadata();
   test_things_stick_around();
   test_slices_work();
   test_base64_and_huffman_works();
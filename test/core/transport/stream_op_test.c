@@ -36,6 +36,7 @@
 #include <string.h>
 
 #include <grpc/support/log.h>
+#include <grpc/support/useful.h>
 #include "test/core/util/test_config.h"
 
 static void flow_ctl_cb_fails(void *ignored, grpc_op_error error) {
@@ -54,6 +55,77 @@ static void assert_slices_equal(gpr_slice a, gpr_slice b) {
   }
 }
 
+/* grows sopb onto a heap op array with room for at least n ops, then empties
+   it */
+static void grow_sopb(grpc_stream_op_buffer *sopb, size_t n) {
+  size_t i;
+  for (i = 0; i < n; i++) {
+    grpc_sopb_add_no_op(sopb);
+  }
+  GPR_ASSERT(sopb->ops != sopb->inlined_ops);
+  grpc_sopb_reset(sopb);
+}
+
+static void test_storage_cache(void) {
+  grpc_sopb_storage_cache cache;
+  grpc_stream_op_buffer bufs[GRPC_SOPB_STORAGE_CACHE_SIZE + 1];
+  grpc_stream_op_buffer buf;
+  grpc_stream_op *ops;
+  size_t capacity;
+  size_t i;
+
+  grpc_sopb_storage_cache_init(&cache);
+  grpc_sopb_init(&buf);
+
+  /* a sopb on its inline storage has nothing to give */
+  GPR_ASSERT(!grpc_sopb_storage_cache_put(&cache, &buf));
+  GPR_ASSERT(cache.count == 0);
+
+  /* a grown array is reused as is by the next sopb */
+  grow_sopb(&buf, 2 * GRPC_SOPB_INLINE_ELEMENTS);
+  ops = buf.ops;
+  capacity = buf.capacity;
+  GPR_ASSERT(grpc_sopb_storage_cache_put(&cache, &buf));
+  GPR_ASSERT(cache.count == 1);
+  GPR_ASSERT(buf.ops == buf.inlined_ops);
+  grpc_sopb_storage_cache_take(&cache, &buf);
+  GPR_ASSERT(cache.count == 0);
+  GPR_ASSERT(buf.ops == ops);
+  GPR_ASSERT(buf.capacity == capacity);
+  /* ... without needing to grow again */
+  for (i = 0; i < 2 * GRPC_SOPB_INLINE_ELEMENTS; i++) {
+    grpc_sopb_add_no_op(&buf);
+  }
+  GPR_ASSERT(buf.ops == ops);
+  grpc_sopb_reset(&buf);
+
+  /* an empty cache leaves the sopb on its inline storage */
+  grpc_sopb_init(&bufs[0]);
+  grpc_sopb_storage_cache_take(&cache, &bufs[0]);
+  GPR_ASSERT(bufs[0].ops == bufs[0].inlined_ops);
+  grpc_sopb_destroy(&bufs[0]);
+
+  /* an outsized array is left to be freed with its sopb */
+  grow_sopb(&buf, GRPC_SOPB_STORAGE_CACHE_MAX_CAPACITY + 1);
+  GPR_ASSERT(!grpc_sopb_storage_cache_put(&cache, &buf));
+  GPR_ASSERT(cache.count == 0);
+  GPR_ASSERT(buf.ops != buf.inlined_ops);
+  grpc_sopb_destroy(&buf);
+
+  /* and so is anything beyond the cache's size */
+  for (i = 0; i < GPR_ARRAY_SIZE(bufs); i++) {
+    grpc_sopb_init(&bufs[i]);
+    grow_sopb(&bufs[i], GRPC_SOPB_INLINE_ELEMENTS + 1);
+    GPR_ASSERT(grpc_sopb_storage_cache_put(&cache, &bufs[i]) ==
+               (i < GRPC_SOPB_STORAGE_CACHE_SIZE));
+  }
+  GPR_ASSERT(cache.count == GRPC_SOPB_STORAGE_CACHE_SIZE);
+  for (i = 0; i < GPR_ARRAY_SIZE(bufs); i++) {
+    grpc_sopb_destroy(&bufs[i]);
+  }
+  grpc_sopb_storage_cache_destroy(&cache);
+}
+
 int main(int argc, char **argv) {
   /* some basic test data */
   gpr_slice test_slice_1 = gpr_slice_malloc(1);
@@ -121,5 +193,7 @@ int main(int argc, char **argv) {
   gpr_slice_unref(test_slice_3);
   gpr_slice_unref(test_slice_4);
 
+  test_storage_cache();
+
   return 0;
 }
@@ -217,6 +217,7 @@ static test_stream *find_test_stream(test_fixture *f, grpc_stream *stream) {
     if (s->client_stream == stream || s->server_stream == stream) {
       return s;
     }
+    s = s->next;
   } while (s != f->streams);
 
   GPR_ASSERT(0 && "found");
@@ -885,6 +886,39 @@ static void test_request_with_flow_ctl_cb(grpc_transport_test_config *config,
   grpc_sopb_destroy(&sopb);
 }
 
+/* Test that sequential requests carrying more metadata than fits in a sopb's
+   inline storage are delivered intact (exercises the reuse of grown op arrays
+   between streams) */
+static void test_requests_with_many_metadata(
+    grpc_transport_test_config *config) {
+  test_fixture f;
+  test_stream s;
+  grpc_stream_op_buffer sopb;
+  char key[32];
+  char value[32];
+  int i, j;
+
+  grpc_sopb_init(&sopb);
+  begin_test(&f, config, __FUNCTION__);
+  for (i = 0; i < 3; i++) {
+    begin_stream(&s, &f, "/Test", "foo.google.com", 10);
+    for (j = 0; j < 2 * GRPC_SOPB_INLINE_ELEMENTS; j++) {
+      sprintf(key, "key-%d", j);
+      sprintf(value, "value-%d-%d", i, j);
+      grpc_sopb_add_metadata(
+          &sopb, grpc_mdelem_from_strings(g_metadata_context, key, value));
+      expect_metadata(&s, 0, key, value);
+    }
+    grpc_transport_send_batch(f.server_transport, s.server_stream, sopb.ops,
+                              sopb.nops, 1);
+    sopb.nops = 0;
+    grpc_transport_send_batch(f.client_transport, s.client_stream, NULL, 0, 1);
+    wait_and_verify(&f);
+  }
+  end_test(&f);
+  grpc_sopb_destroy(&sopb);
+}
+
 /* Set an event on ping response */
 static void ping_cb(void *p) { gpr_event_set(p, (void *)1); }
 
@@ -920,6 +954,7 @@ void grpc_transport_end2end_tests(grpc_transport_test_config *config) {
   test_can_abort_client(config);
   test_can_abort_server(config);
   test_ping(config);
+  test_requests_with_many_metadata(config);
   for (i = 0; i < GPR_ARRAY_SIZE(interesting_message_lengths); i++) {
     test_request_with_data(config, interesting_message_lengths[i]);
     test_request_with_flow_ctl_cb(config, interesting_message_lengths[i]);
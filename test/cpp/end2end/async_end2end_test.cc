@@ -31,8 +31,14 @@
  *
  */
 
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "test/core/util/test_config.h"
 #include "test/cpp/util/echo_duplicate.pb.h"
@@ -61,6 +67,20 @@ using grpc::cpp::test::util::EchoRequest;
 using grpc::cpp::test::util::EchoResponse;
 using std::chrono::system_clock;
 
+// Counts every C++ heap allocation in the process.
+static std::atomic<int> g_cxx_allocs(0);
+
+void* operator new(std::size_t size) {
+  g_cxx_allocs++;
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
 namespace grpc {
 namespace testing {
 
@@ -166,6 +186,238 @@ TEST_F(AsyncEnd2endTest, SequentialRpcs) {
   SendRpc(10);
 }
 
+// Reuses one caller-owned reader for every rpc.
+TEST_F(AsyncEnd2endTest, InPlaceSequentialRpcs) {
+  ResetStub();
+  ClientAsyncResponseReader<EchoResponse> response_reader;
+  for (int i = 0; i < 10; i++) {
+    EchoRequest send_request;
+    EchoRequest recv_request;
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    Status recv_status;
+
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+
+    send_request.set_message("Hello");
+    stub_->AsyncEcho(&cli_ctx, send_request, &cli_cq_, &response_reader,
+                     tag(1));
+
+    service_.RequestEcho(&srv_ctx, &recv_request, &response_writer, &srv_cq_,
+                         tag(2));
+
+    server_ok(2);
+    EXPECT_EQ(send_request.message(), recv_request.message());
+    client_ok(1);
+
+    send_response.set_message(recv_request.message());
+    response_writer.Finish(send_response, Status::OK, tag(3));
+    server_ok(3);
+
+    response_reader.Finish(&recv_response, &recv_status, tag(4));
+    client_ok(4);
+
+    EXPECT_EQ(send_response.message(), recv_response.message());
+    EXPECT_TRUE(recv_status.IsOk());
+  }
+}
+
+// One request past GRPC_MAX_REQUESTED_CALLS is dropped rather than aborting
+// the server, and the requests already queued still take calls.
+TEST_F(AsyncEnd2endTest, RequestsBeyondLimitAreDropped) {
+  ResetStub();
+  struct PendingEcho {
+    PendingEcho() : writer(&ctx) {}
+    ServerContext ctx;
+    EchoRequest request;
+    grpc::ServerAsyncResponseWriter<EchoResponse> writer;
+  };
+  std::vector<std::unique_ptr<PendingEcho> > pending;
+  for (int i = 0; i <= GRPC_MAX_REQUESTED_CALLS; i++) {
+    pending.emplace_back(new PendingEcho);
+    service_.RequestEcho(&pending[i]->ctx, &pending[i]->request,
+                         &pending[i]->writer, &srv_cq_, pending[i].get());
+  }
+
+  EchoRequest send_request;
+  EchoResponse recv_response;
+  Status recv_status;
+  ClientContext cli_ctx;
+  send_request.set_message("Hello");
+  std::unique_ptr<ClientAsyncResponseReader<EchoResponse> > response_reader(
+      stub_->AsyncEcho(&cli_ctx, send_request, &cli_cq_, tag(1)));
+
+  void* got_tag;
+  bool ok = false;
+  EXPECT_TRUE(srv_cq_.Next(&got_tag, &ok));
+  EXPECT_TRUE(ok);
+  EXPECT_NE(pending.back().get(), got_tag);
+  PendingEcho* echo = static_cast<PendingEcho*>(got_tag);
+  EXPECT_EQ(send_request.message(), echo->request.message());
+  client_ok(1);
+
+  EchoResponse send_response;
+  send_response.set_message(echo->request.message());
+  echo->writer.Finish(send_response, Status::OK, tag(3));
+  server_ok(3);
+  response_reader->Finish(&recv_response, &recv_status, tag(4));
+  client_ok(4);
+  EXPECT_EQ(send_response.message(), recv_response.message());
+  EXPECT_TRUE(recv_status.IsOk());
+
+  // The requests that were queued fail when the server shuts down.
+  server_->Shutdown();
+  for (int i = 0; i < GRPC_MAX_REQUESTED_CALLS - 1; i++) {
+    EXPECT_TRUE(srv_cq_.Next(&got_tag, &ok));
+    EXPECT_FALSE(ok);
+  }
+}
+
+// With caller-owned readers and messages, steady state rpcs make no C++
+// heap allocations in the library: the rpc objects grpc++ creates per call
+// come from free lists.
+TEST_F(AsyncEnd2endTest, InPlaceRpcsDoNotAllocate) {
+  ResetStub();
+  ClientAsyncResponseReader<EchoResponse> response_reader;
+  EchoRequest send_request;
+  EchoRequest recv_request;
+  EchoResponse send_response;
+  EchoResponse recv_response;
+  send_request.set_message("Hello");
+  const int kWarmupRpcs = 3;
+  int allocs_before = 0;
+  for (int i = 0; i < kWarmupRpcs + 10; i++) {
+    if (i == kWarmupRpcs) {
+      allocs_before = g_cxx_allocs.load();
+    }
+    Status recv_status;
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+
+    stub_->AsyncEcho(&cli_ctx, send_request, &cli_cq_, &response_reader,
+                     tag(1));
+    service_.RequestEcho(&srv_ctx, &recv_request, &response_writer, &srv_cq_,
+                         tag(2));
+    server_ok(2);
+    client_ok(1);
+
+    send_response.set_message(recv_request.message());
+    response_writer.Finish(send_response, Status::OK, tag(3));
+    server_ok(3);
+    response_reader.Finish(&recv_response, &recv_status, tag(4));
+    client_ok(4);
+    EXPECT_TRUE(recv_status.IsOk());
+  }
+  EXPECT_EQ(0, g_cxx_allocs.load() - allocs_before);
+}
+
+// The overload the in_place_async plugin option generates. Naming its
+// exact type here fails the build if the generated signature changes.
+typedef void (grpc::cpp::test::util::TestService::Stub::*InPlaceAsyncEcho)(
+    ClientContext*, const EchoRequest&, CompletionQueue*,
+    ClientAsyncResponseReader<EchoResponse>*, void*);
+
+// Starts several rpcs through the in-place overload, each in its own reader
+// in one caller-owned array, and keeps them all in flight at once.
+TEST_F(AsyncEnd2endTest, InPlaceConcurrentRpcs) {
+  ResetStub();
+  const int kNumRpcs = 5;
+  InPlaceAsyncEcho async_echo =
+      &grpc::cpp::test::util::TestService::Stub::AsyncEcho;
+  ClientAsyncResponseReader<EchoResponse> readers[kNumRpcs];
+  ClientContext cli_ctx[kNumRpcs];
+  EchoResponse recv_response[kNumRpcs];
+  Status recv_status[kNumRpcs];
+  for (int i = 0; i < kNumRpcs; i++) {
+    EchoRequest send_request;
+    send_request.set_message("Hello " + std::to_string(i));
+    ((*stub_).*async_echo)(&cli_ctx[i], send_request, &cli_cq_, &readers[i],
+                           tag(100 + i));
+  }
+
+  for (int i = 0; i < kNumRpcs; i++) {
+    EchoRequest recv_request;
+    EchoResponse send_response;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+    service_.RequestEcho(&srv_ctx, &recv_request, &response_writer, &srv_cq_,
+                         tag(2));
+    server_ok(2);
+    send_response.set_message(recv_request.message());
+    response_writer.Finish(send_response, Status::OK, tag(3));
+    server_ok(3);
+  }
+
+  for (int i = 0; i < kNumRpcs; i++) {
+    readers[i].Finish(&recv_response[i], &recv_status[i], tag(200 + i));
+  }
+  // Starts and finishes of different rpcs may complete in any order.
+  std::set<void*> done;
+  for (int i = 0; i < 2 * kNumRpcs; i++) {
+    bool ok;
+    void* got_tag;
+    EXPECT_TRUE(cli_cq_.Next(&got_tag, &ok));
+    EXPECT_TRUE(ok);
+    EXPECT_TRUE(done.insert(got_tag).second);
+  }
+  for (int i = 0; i < kNumRpcs; i++) {
+    EXPECT_EQ(1u, done.count(tag(100 + i)));
+    EXPECT_EQ(1u, done.count(tag(200 + i)));
+    EXPECT_EQ("Hello " + std::to_string(i), recv_response[i].message());
+    EXPECT_TRUE(recv_status[i].IsOk());
+  }
+}
+
+// A reader whose rpc failed can start the next one.
+TEST_F(AsyncEnd2endTest, InPlaceReaderReusedAfterError) {
+  ResetStub();
+  ClientAsyncResponseReader<EchoResponse> response_reader;
+  for (int i = 0; i < 2; i++) {
+    EchoRequest send_request;
+    EchoRequest recv_request;
+    EchoResponse send_response;
+    EchoResponse recv_response;
+    Status recv_status;
+
+    ClientContext cli_ctx;
+    ServerContext srv_ctx;
+    grpc::ServerAsyncResponseWriter<EchoResponse> response_writer(&srv_ctx);
+
+    send_request.set_message("Hello");
+    stub_->AsyncEcho(&cli_ctx, send_request, &cli_cq_, &response_reader,
+                     tag(1));
+
+    service_.RequestEcho(&srv_ctx, &recv_request, &response_writer, &srv_cq_,
+                         tag(2));
+    server_ok(2);
+    client_ok(1);
+
+    if (i == 0) {
+      response_writer.FinishWithError(
+          Status(StatusCode::PERMISSION_DENIED, "denied"), tag(3));
+    } else {
+      send_response.set_message(recv_request.message());
+      response_writer.Finish(send_response, Status::OK, tag(3));
+    }
+    server_ok(3);
+
+    response_reader.Finish(&recv_response, &recv_status, tag(4));
+    if (i == 0) {
+      // No response message arrives, so the finish reports failure.
+      client_fail(4);
+      EXPECT_EQ(StatusCode::PERMISSION_DENIED, recv_status.code());
+      EXPECT_EQ("denied", recv_status.details());
+    } else {
+      client_ok(4);
+      EXPECT_TRUE(recv_status.IsOk());
+      EXPECT_EQ(send_request.message(), recv_response.message());
+    }
+  }
+}
+
 // Two pings and a final pong.
 TEST_F(AsyncEnd2endTest, SimpleClientStreaming) {
   ResetStub();
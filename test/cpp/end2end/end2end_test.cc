@@ -423,6 +423,41 @@ TEST_F(End2endTest, BadCredentials) {
   EXPECT_EQ("Rpc sent on a lame channel.", s.details());
 }
 
+// A thread pool bound no larger than the number of sync completion queues
+// would leave some queues without a thread; the builder raises it.
+TEST(End2endBuilderTest, ThreadPoolNoLargerThanQueueCount) {
+  int port = grpc_pick_unused_port_or_die();
+  std::ostringstream server_address;
+  server_address << "localhost:" << port;
+  TestServiceImpl service;
+  ServerBuilder builder;
+  builder.AddPort(server_address.str(), InsecureServerCredentials());
+  builder.RegisterService(&service);
+  builder.SetNumSyncCompletionQueues(4);
+  builder.SetThreadPoolSize(1, 1);
+  std::unique_ptr<Server> server = builder.BuildAndStart();
+  ASSERT_TRUE(server != nullptr);
+
+  std::shared_ptr<ChannelInterface> channel = CreateChannel(
+      server_address.str(), InsecureCredentials(), ChannelArguments());
+  std::unique_ptr<grpc::cpp::test::util::TestService::Stub> stub(
+      grpc::cpp::test::util::TestService::NewStub(channel));
+  EchoRequest request;
+  request.set_message("Hello");
+  // Enough rpcs to land on every queue; each is bounded so that a queue
+  // nobody serves fails the test instead of hanging it.
+  for (int i = 0; i < 20; i++) {
+    EchoResponse response;
+    ClientContext context;
+    context.set_absolute_deadline(std::chrono::system_clock::now() +
+                                  std::chrono::seconds(10));
+    Status s = stub->Echo(&context, request, &response);
+    EXPECT_TRUE(s.IsOk());
+    EXPECT_EQ(request.message(), response.message());
+  }
+  server->Shutdown();
+}
+
 }  // namespace testing
 }  // namespace grpc
 
@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Reports serialize and parse throughput of SerializeProto and
+// DeserializeProto across a range of message sizes.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include <grpc/grpc.h>
+#include <grpc/byte_buffer.h>
+#include <grpc/support/log.h>
+#include "src/cpp/proto/proto_utils.h"
+#include "test/cpp/util/messages.pb.h"
+
+using grpc::cpp::test::util::EchoRequest;
+
+namespace grpc {
+namespace {
+
+const size_t kSizes[] = {0,    1,     100,    1000,    4096,
+                         8192, 65536, 500000, 1048576, 3000000};
+
+void RunBenchmark(size_t size) {
+  EchoRequest request;
+  request.set_message(std::string(size, 'a'));
+  EchoRequest parsed;
+  const int iterations = static_cast<int>(
+      std::max<size_t>(10, 100000000 / (size + 100)) / 10);
+  std::chrono::duration<double> serialize_time(0);
+  std::chrono::duration<double> parse_time(0);
+  for (int i = 0; i < iterations; i++) {
+    grpc_byte_buffer* buffer = nullptr;
+    auto start = std::chrono::steady_clock::now();
+    GPR_ASSERT(SerializeProto(request, &buffer));
+    auto serialized = std::chrono::steady_clock::now();
+    GPR_ASSERT(DeserializeProto(buffer, &parsed));
+    auto parsed_time = std::chrono::steady_clock::now();
+    grpc_byte_buffer_destroy(buffer);
+    serialize_time += serialized - start;
+    parse_time += parsed_time - serialized;
+  }
+  gpr_log(GPR_INFO,
+          "size %8d: serialize %9.1f ns/msg %8.1f MB/s, "
+          "parse %9.1f ns/msg %8.1f MB/s",
+          static_cast<int>(size), 1e9 * serialize_time.count() / iterations,
+          size * iterations / serialize_time.count() / 1e6,
+          1e9 * parse_time.count() / iterations,
+          size * iterations / parse_time.count() / 1e6);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc_init();
+  for (size_t size : grpc::kSizes) {
+    grpc::RunBenchmark(size);
+  }
+  grpc_shutdown();
+  return 0;
+}
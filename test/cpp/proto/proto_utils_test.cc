@@ -0,0 +1,203 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <grpc/grpc.h>
+#include <grpc/byte_buffer.h>
+#include "src/cpp/proto/proto_utils.h"
+#include "test/cpp/util/messages.pb.h"
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/dynamic_message.h>
+#include <gtest/gtest.h>
+
+using grpc::cpp::test::util::EchoRequest;
+
+namespace grpc {
+namespace {
+
+const size_t kSizes[] = {0,    1,     100,    1000,    4096,
+                         8192, 65536, 500000, 1048576, 3000000};
+
+EchoRequest MakeRequest(size_t size) {
+  EchoRequest request;
+  request.set_message(std::string(size, 'a'));
+  return request;
+}
+
+TEST(ProtoUtilsTest, RoundTrip) {
+  for (size_t size : kSizes) {
+    EchoRequest request = MakeRequest(size);
+    grpc_byte_buffer* buffer = nullptr;
+    ASSERT_TRUE(SerializeProto(request, &buffer));
+    EXPECT_EQ(static_cast<size_t>(request.ByteSize()),
+              grpc_byte_buffer_length(buffer));
+    EchoRequest parsed;
+    ASSERT_TRUE(DeserializeProto(buffer, &parsed));
+    EXPECT_EQ(request.message(), parsed.message());
+    grpc_byte_buffer_destroy(buffer);
+  }
+}
+
+TEST(ProtoUtilsTest, SmallMessagesUseOneExactSlice) {
+  for (size_t size : kSizes) {
+    EchoRequest request = MakeRequest(size);
+    if (request.ByteSize() > 1024 * 1024) continue;
+    grpc_byte_buffer* buffer = nullptr;
+    ASSERT_TRUE(SerializeProto(request, &buffer));
+    gpr_slice_buffer* slices = &buffer->data.slice_buffer;
+    if (request.ByteSize() == 0) {
+      EXPECT_EQ(0u, slices->count);
+    } else {
+      ASSERT_EQ(1u, slices->count);
+      EXPECT_EQ(static_cast<size_t>(request.ByteSize()),
+                GPR_SLICE_LENGTH(slices->slices[0]));
+    }
+    grpc_byte_buffer_destroy(buffer);
+  }
+}
+
+TEST(ProtoUtilsTest, LargeMessagesUseFewSlices) {
+  EchoRequest request = MakeRequest(3000000);
+  grpc_byte_buffer* buffer = nullptr;
+  ASSERT_TRUE(SerializeProto(request, &buffer));
+  EXPECT_EQ(3u, buffer->data.slice_buffer.count);
+  grpc_byte_buffer_destroy(buffer);
+}
+
+// Deserializes request after splitting its encoding into chunk-sized slices,
+// exercising the coalescing and streaming parse paths.
+void CheckChunkedParse(const EchoRequest& request, size_t chunk) {
+  grpc::string encoded;
+  ASSERT_TRUE(request.SerializeToString(&encoded));
+  std::vector<gpr_slice> slices;
+  for (size_t i = 0; i < encoded.size(); i += chunk) {
+    slices.push_back(gpr_slice_from_copied_buffer(
+        encoded.data() + i, std::min(chunk, encoded.size() - i)));
+  }
+  grpc_byte_buffer* buffer =
+      grpc_byte_buffer_create(slices.data(), slices.size());
+  for (size_t i = 0; i < slices.size(); i++) {
+    gpr_slice_unref(slices[i]);
+  }
+  EchoRequest parsed;
+  EXPECT_TRUE(DeserializeProto(buffer, &parsed));
+  EXPECT_EQ(request.message(), parsed.message());
+  grpc_byte_buffer_destroy(buffer);
+}
+
+TEST(ProtoUtilsTest, MultiSliceParse) {
+  for (size_t size : kSizes) {
+    EchoRequest request = MakeRequest(size);
+    if (size <= 65536) {
+      CheckChunkedParse(request, 1);
+      CheckChunkedParse(request, 7);
+    }
+    CheckChunkedParse(request, 1000);
+  }
+}
+
+TEST(ProtoUtilsTest, RejectsTruncatedInput) {
+  EchoRequest request = MakeRequest(5000);
+  grpc::string encoded;
+  ASSERT_TRUE(request.SerializeToString(&encoded));
+  for (size_t length : {10u, 3000u, 4990u}) {
+    gpr_slice slice = gpr_slice_from_copied_buffer(encoded.data(), length);
+    grpc_byte_buffer* buffer = grpc_byte_buffer_create(&slice, 1);
+    gpr_slice_unref(slice);
+    EchoRequest parsed;
+    EXPECT_FALSE(DeserializeProto(buffer, &parsed));
+    grpc_byte_buffer_destroy(buffer);
+  }
+}
+
+TEST(ProtoUtilsTest, RejectsMissingRequiredFields) {
+  google::protobuf::FileDescriptorProto file;
+  file.set_name("required_test.proto");
+  google::protobuf::DescriptorProto* type = file.add_message_type();
+  type->set_name("WithRequired");
+  google::protobuf::FieldDescriptorProto* field = type->add_field();
+  field->set_name("value");
+  field->set_number(1);
+  field->set_label(google::protobuf::FieldDescriptorProto::LABEL_REQUIRED);
+  field->set_type(google::protobuf::FieldDescriptorProto::TYPE_INT32);
+  google::protobuf::DescriptorPool pool;
+  const google::protobuf::FileDescriptor* file_descriptor =
+      pool.BuildFile(file);
+  ASSERT_TRUE(file_descriptor != nullptr);
+  google::protobuf::DynamicMessageFactory factory(&pool);
+  std::unique_ptr<grpc::protobuf::Message> message(
+      factory.GetPrototype(file_descriptor->message_type(0))->New());
+
+  grpc_byte_buffer* buffer = nullptr;
+  EXPECT_FALSE(SerializeProto(*message, &buffer));
+
+  message->GetReflection()->SetInt32(
+      message.get(), file_descriptor->message_type(0)->field(0), 7);
+  ASSERT_TRUE(SerializeProto(*message, &buffer));
+  grpc_byte_buffer_destroy(buffer);
+}
+
+// Parses every size, growing then shrinking, into one message object, the
+// way a stream reuses its message between reads.
+TEST(ProtoUtilsTest, ReusedMessageRoundTrip) {
+  EchoRequest parsed;
+  std::vector<size_t> sizes(std::begin(kSizes), std::end(kSizes));
+  for (size_t i = sizes.size(); i > 0; i--) {
+    sizes.push_back(sizes[i - 1]);
+  }
+  for (size_t size : sizes) {
+    EchoRequest request = MakeRequest(size);
+    grpc_byte_buffer* buffer = nullptr;
+    ASSERT_TRUE(SerializeProto(request, &buffer));
+    ASSERT_TRUE(DeserializeProto(buffer, &parsed));
+    EXPECT_EQ(request.message(), parsed.message());
+    grpc_byte_buffer_destroy(buffer);
+  }
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc_init();
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
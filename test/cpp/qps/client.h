@@ -38,36 +38,47 @@
 #include "test/cpp/qps/timer.h"
 #include "test/cpp/qps/qpstest.pb.h"
 
-#include <condition_variable>
+#include <chrono>
 #include <mutex>
+#include <random>
+#include <thread>
 
 namespace grpc {
 namespace testing {
 
 class Client {
  public:
-  explicit Client(const ClientConfig& config) : timer_(new Timer) {
+  explicit Client(const ClientConfig& config)
+      : load_type_(config.load_type()),
+        offered_load_(config.offered_load()),
+        payload_size_(config.payload_size()),
+        timer_(new Timer) {
     for (int i = 0; i < config.client_channels(); i++) {
       channels_.push_back(ClientChannelInfo(
           config.server_targets(i % config.server_targets_size()), config));
     }
     request_.set_response_type(grpc::testing::PayloadType::COMPRESSABLE);
     request_.set_response_size(config.payload_size());
+    streaming_request_.set_response_type(
+        grpc::testing::PayloadType::COMPRESSABLE);
+    streaming_request_.add_response_parameters()->set_size(
+        config.payload_size());
+    streaming_request_.mutable_response_parameters(0)->set_interval_us(0);
+    server_streaming_request_.set_response_type(
+        grpc::testing::PayloadType::COMPRESSABLE);
+    for (int i = 0; i < config.messages_per_stream(); i++) {
+      auto* params = server_streaming_request_.add_response_parameters();
+      params->set_size(config.payload_size());
+      params->set_interval_us(0);
+    }
   }
   virtual ~Client() {}
 
   ClientStats Mark() {
     Histogram latencies;
-    std::vector<Histogram> to_merge(threads_.size());
-    for (size_t i = 0; i < threads_.size(); i++) {
-      threads_[i]->BeginSwap(&to_merge[i]);
-    }
     std::unique_ptr<Timer> timer(new Timer);
     timer_.swap(timer);
-    for (size_t i = 0; i < threads_.size(); i++) {
-      threads_[i]->EndSwap();
-      latencies.Merge(&to_merge[i]);
-    }
+    latencies_.DrainInto(&latencies);
 
     auto timer_result = timer->Mark();
 
@@ -76,11 +87,20 @@ class Client {
     stats.set_time_elapsed(timer_result.wall);
     stats.set_time_system(timer_result.system);
     stats.set_time_user(timer_result.user);
+    stats.set_context_switches(timer_result.context_switches);
+    stats.set_allocs(timer_result.allocs);
+    // every latency sample is one received response of payload_size bytes
+    stats.set_bytes_received(latencies.Count() * payload_size_);
     return stats;
   }
 
  protected:
+  // for UNARY rpcs
   SimpleRequest request_;
+  // for each ping-pong of a STREAMING rpc
+  StreamingOutputCallRequest streaming_request_;
+  // for STREAMING_FROM_SERVER rpcs
+  StreamingOutputCallRequest server_streaming_request_;
 
   class ClientChannelInfo {
    public:
@@ -96,7 +116,53 @@ class Client {
   };
   std::vector<ClientChannelInfo> channels_;
 
+  // The scheduled start times of the rpcs a thread issues under an open loop
+  // load
+  class IssueSchedule {
+   public:
+    IssueSchedule(LoadType type, double rate, unsigned seed, double start)
+        : type_(type),
+          interval_(1.0 / rate),
+          generator_(seed),
+          exponential_(rate),
+          next_(start) {}
+
+    double next() const { return next_; }
+    void Advance() {
+      next_ +=
+          type_ == LoadType::POISSON ? exponential_(generator_) : interval_;
+    }
+
+   private:
+    const LoadType type_;
+    const double interval_;
+    std::default_random_engine generator_;
+    std::exponential_distribution<double> exponential_;
+    double next_;
+  };
+
+  bool closed_loop() const { return load_type_ == LoadType::CLOSED_LOOP; }
+  IssueSchedule* schedule(size_t thread_idx) {
+    return schedules_[thread_idx].get();
+  }
+
+  static void SleepUntil(double t) {
+    double now = Timer::Now();
+    if (t > now) {
+      std::this_thread::sleep_for(std::chrono::duration<double>(t - now));
+    }
+  }
+
   void StartThreads(size_t num_threads) {
+    if (!closed_loop()) {
+      GPR_ASSERT(offered_load_ > 0);
+      // every thread offers an equal share of the load
+      double start = Timer::Now();
+      for (size_t i = 0; i < num_threads; i++) {
+        schedules_.emplace_back(new IssueSchedule(
+            load_type_, offered_load_ / num_threads, i, start));
+      }
+    }
     for (size_t i = 0; i < num_threads; i++) {
       threads_.emplace_back(new Thread(this, i));
     }
@@ -104,27 +170,21 @@ class Client {
 
   void EndThreads() { threads_.clear(); }
 
-  virtual void ThreadFunc(Histogram* histogram, size_t thread_idx) = 0;
+  virtual void ThreadFunc(ConcurrentHistogram* histogram,
+                          size_t thread_idx) = 0;
 
  private:
   class Thread {
    public:
     Thread(Client* client, size_t idx)
         : done_(false),
-          new_(nullptr),
           impl_([this, idx, client]() {
             for (;;) {
               // run the loop body
-              client->ThreadFunc(&histogram_, idx);
+              client->ThreadFunc(&client->latencies_, idx);
               // lock, see if we're done
               std::lock_guard<std::mutex> g(mu_);
               if (done_) return;
-              // also check if we're marking, and swap out the histogram if so
-              if (new_) {
-                new_->Swap(&histogram_);
-                new_ = nullptr;
-                cv_.notify_one();
-              }
             }
           }) {}
 
@@ -136,16 +196,6 @@ class Client {
       impl_.join();
     }
 
-    void BeginSwap(Histogram* n) {
-      std::lock_guard<std::mutex> g(mu_);
-      new_ = n;
-    }
-
-    void EndSwap() {
-      std::unique_lock<std::mutex> g(mu_);
-      cv_.wait(g, [this]() { return new_ == nullptr; });
-    }
-
    private:
     Thread(const Thread&);
     Thread& operator=(const Thread&);
@@ -153,13 +203,16 @@ class Client {
     TestService::Stub* stub_;
     ClientConfig config_;
     std::mutex mu_;
-    std::condition_variable cv_;
     bool done_;
-    Histogram* new_;
-    Histogram histogram_;
     std::thread impl_;
   };
 
+  const LoadType load_type_;
+  const double offered_load_;
+  const int payload_size_;
+  std::vector<std::unique_ptr<IssueSchedule>> schedules_;
+  // Shared by all threads, so Mark() never has to stop them.
+  ConcurrentHistogram latencies_;
   std::vector<std::unique_ptr<Thread>> threads_;
   std::unique_ptr<Timer> timer_;
 };
@@ -32,6 +32,7 @@
  */
 
 #include <cassert>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -46,6 +47,7 @@
 #include <grpc++/async_unary_call.h>
 #include <grpc++/client_context.h>
 #include <grpc++/status.h>
+#include <grpc++/stream.h>
 #include "test/core/util/grpc_profiler.h"
 #include "test/cpp/util/create_test_channel.h"
 #include "test/cpp/qps/qpstest.pb.h"
@@ -59,13 +61,13 @@ class ClientRpcContext {
  public:
   ClientRpcContext() {}
   virtual ~ClientRpcContext() {}
-  virtual bool RunNextState() = 0;  // do next state, return false if steps done
+  // do next state, return false if steps done
+  virtual bool RunNextState(bool ok, ConcurrentHistogram *hist) = 0;
   virtual void StartNewClone() = 0;
   static void *tag(ClientRpcContext *c) { return reinterpret_cast<void *>(c); }
   static ClientRpcContext *detag(void *t) {
     return reinterpret_cast<ClientRpcContext *>(t);
   }
-  virtual void report_stats(Histogram *hist) = 0;
 };
 
 template <class RequestType, class ResponseType>
@@ -77,7 +79,8 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
           std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>(
               TestService::Stub *, grpc::ClientContext *, const RequestType &,
               void *)> start_req,
-      std::function<void(grpc::Status, ResponseType *)> on_done)
+      std::function<void(grpc::Status, ResponseType *)> on_done,
+      double start)
       : context_(),
         stub_(stub),
         req_(req),
@@ -85,30 +88,31 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
         next_state_(&ClientRpcContextUnaryImpl::ReqSent),
         callback_(on_done),
         start_req_(start_req),
-        start_(Timer::Now()),
+        start_(start),
         response_reader_(
             start_req(stub_, &context_, req_, ClientRpcContext::tag(this))) {}
   ~ClientRpcContextUnaryImpl() GRPC_OVERRIDE {}
-  bool RunNextState() GRPC_OVERRIDE { return (this->*next_state_)(); }
-  void report_stats(Histogram *hist) GRPC_OVERRIDE {
-    hist->Add((Timer::Now() - start_) * 1e9);
+  bool RunNextState(bool ok, ConcurrentHistogram *hist) GRPC_OVERRIDE {
+    return (this->*next_state_)(hist);
   }
 
   void StartNewClone() GRPC_OVERRIDE {
-    new ClientRpcContextUnaryImpl(stub_, req_, start_req_, callback_);
+    new ClientRpcContextUnaryImpl(stub_, req_, start_req_, callback_,
+                                  Timer::Now());
   }
 
  private:
-  bool ReqSent() {
+  bool ReqSent(ConcurrentHistogram *) {
     next_state_ = &ClientRpcContextUnaryImpl::RespDone;
     response_reader_->Finish(&response_, &status_, ClientRpcContext::tag(this));
     return true;
   }
-  bool RespDone() {
+  bool RespDone(ConcurrentHistogram *hist) {
+    hist->Add((Timer::Now() - start_) * 1e9);
     next_state_ = &ClientRpcContextUnaryImpl::DoCallBack;
     return false;
   }
-  bool DoCallBack() {
+  bool DoCallBack(ConcurrentHistogram *) {
     callback_(status_, &response_);
     return false;
   }
@@ -116,7 +120,7 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
   TestService::Stub *stub_;
   RequestType req_;
   ResponseType response_;
-  bool (ClientRpcContextUnaryImpl::*next_state_)();
+  bool (ClientRpcContextUnaryImpl::*next_state_)(ConcurrentHistogram *);
   std::function<void(grpc::Status, ResponseType *)> callback_;
   std::function<std::unique_ptr<grpc::ClientAsyncResponseReader<ResponseType>>(
       TestService::Stub *, grpc::ClientContext *, const RequestType &, void *)>
@@ -127,6 +131,138 @@ class ClientRpcContextUnaryImpl : public ClientRpcContext {
       response_reader_;
 };
 
+// Ping-pongs requests and responses over a single stream until an operation
+// fails.
+template <class RequestType, class ResponseType>
+class ClientRpcContextStreamingImpl : public ClientRpcContext {
+ public:
+  typedef grpc::ClientAsyncReaderWriter<RequestType, ResponseType> StreamType;
+
+  ClientRpcContextStreamingImpl(
+      TestService::Stub *stub, const RequestType &req,
+      std::function<std::unique_ptr<StreamType>(
+          TestService::Stub *, grpc::ClientContext *, void *)> start_req)
+      : context_(),
+        stub_(stub),
+        req_(req),
+        response_(),
+        next_state_(&ClientRpcContextStreamingImpl::ReqSent),
+        start_req_(start_req),
+        start_(Timer::Now()),
+        stream_(start_req_(stub_, &context_, ClientRpcContext::tag(this))) {}
+  ~ClientRpcContextStreamingImpl() GRPC_OVERRIDE {}
+  bool RunNextState(bool ok, ConcurrentHistogram *hist) GRPC_OVERRIDE {
+    if (!ok) {
+      next_state_ = &ClientRpcContextStreamingImpl::Done;
+    }
+    return (this->*next_state_)(hist);
+  }
+
+  void StartNewClone() GRPC_OVERRIDE {
+    new ClientRpcContextStreamingImpl(stub_, req_, start_req_);
+  }
+
+ private:
+  bool ReqSent(ConcurrentHistogram *) { return StartWrite(); }
+  bool StartWrite() {
+    next_state_ = &ClientRpcContextStreamingImpl::WriteDone;
+    start_ = Timer::Now();
+    stream_->Write(req_, ClientRpcContext::tag(this));
+    return true;
+  }
+  bool WriteDone(ConcurrentHistogram *) {
+    next_state_ = &ClientRpcContextStreamingImpl::ReadDone;
+    stream_->Read(&response_, ClientRpcContext::tag(this));
+    return true;
+  }
+  bool ReadDone(ConcurrentHistogram *hist) {
+    hist->Add((Timer::Now() - start_) * 1e9);
+    return StartWrite();
+  }
+  bool Done(ConcurrentHistogram *) { return false; }
+
+  grpc::ClientContext context_;
+  TestService::Stub *stub_;
+  RequestType req_;
+  ResponseType response_;
+  bool (ClientRpcContextStreamingImpl::*next_state_)(ConcurrentHistogram *);
+  std::function<std::unique_ptr<StreamType>(TestService::Stub *,
+                                            grpc::ClientContext *, void *)>
+      start_req_;
+  double start_;
+  std::unique_ptr<StreamType> stream_;
+};
+
+// Reads a whole response stream, recording the time taken by each message.
+template <class RequestType, class ResponseType>
+class ClientRpcContextServerStreamingImpl : public ClientRpcContext {
+ public:
+  typedef grpc::ClientAsyncReader<ResponseType> StreamType;
+
+  ClientRpcContextServerStreamingImpl(
+      TestService::Stub *stub, const RequestType &req,
+      std::function<std::unique_ptr<StreamType>(
+          TestService::Stub *, grpc::ClientContext *, const RequestType &,
+          void *)> start_req)
+      : context_(),
+        stub_(stub),
+        req_(req),
+        response_(),
+        next_state_(&ClientRpcContextServerStreamingImpl::ReqSent),
+        start_req_(start_req),
+        start_(Timer::Now()),
+        stream_(start_req_(stub_, &context_, req_,
+                           ClientRpcContext::tag(this))) {}
+  ~ClientRpcContextServerStreamingImpl() GRPC_OVERRIDE {}
+  bool RunNextState(bool ok, ConcurrentHistogram *hist) GRPC_OVERRIDE {
+    return (this->*next_state_)(ok, hist);
+  }
+
+  void StartNewClone() GRPC_OVERRIDE {
+    new ClientRpcContextServerStreamingImpl(stub_, req_, start_req_);
+  }
+
+ private:
+  bool ReqSent(bool ok, ConcurrentHistogram *) {
+    if (!ok) return false;
+    next_state_ = &ClientRpcContextServerStreamingImpl::ReadDone;
+    stream_->Read(&response_, ClientRpcContext::tag(this));
+    return true;
+  }
+  bool ReadDone(bool ok, ConcurrentHistogram *hist) {
+    if (!ok) {
+      // end of stream
+      next_state_ = &ClientRpcContextServerStreamingImpl::FinishDone;
+      stream_->Finish(&status_, ClientRpcContext::tag(this));
+      return true;
+    }
+    double now = Timer::Now();
+    hist->Add((now - start_) * 1e9);
+    start_ = now;
+    stream_->Read(&response_, ClientRpcContext::tag(this));
+    return true;
+  }
+  bool FinishDone(bool ok, ConcurrentHistogram *) {
+    GPR_ASSERT(status_.IsOk());
+    next_state_ = &ClientRpcContextServerStreamingImpl::Done;
+    return false;
+  }
+  bool Done(bool ok, ConcurrentHistogram *) { return false; }
+
+  grpc::ClientContext context_;
+  TestService::Stub *stub_;
+  RequestType req_;
+  ResponseType response_;
+  bool (ClientRpcContextServerStreamingImpl::*next_state_)(
+      bool, ConcurrentHistogram *);
+  std::function<std::unique_ptr<StreamType>(
+      TestService::Stub *, grpc::ClientContext *, const RequestType &, void *)>
+      start_req_;
+  grpc::Status status_;
+  double start_;
+  std::unique_ptr<StreamType> stream_;
+};
+
 class AsyncClient GRPC_FINAL : public Client {
  public:
   explicit AsyncClient(const ClientConfig &config) : Client(config) {
@@ -134,28 +270,34 @@ class AsyncClient GRPC_FINAL : public Client {
       cli_cqs_.emplace_back(new CompletionQueue);
     }
 
-    auto payload_size = config.payload_size();
-    auto check_done = [payload_size](grpc::Status s, SimpleResponse *response) {
-      GPR_ASSERT(s.IsOk() && (response->payload().type() ==
-                              grpc::testing::PayloadType::COMPRESSABLE) &&
-                 (response->payload().body().length() ==
-                  static_cast<size_t>(payload_size)));
-    };
+    if (config.load_type() != LoadType::CLOSED_LOOP) {
+      // open loop rpcs are started by ThreadFunc as they fall due
+      GPR_ASSERT(config.rpc_type() == RpcType::UNARY);
+      for (int i = 0; i < config.async_client_threads(); i++) {
+        next_channel_.push_back(i % channels_.size());
+      }
+    }
 
     int t = 0;
-    for (int i = 0; i < config.outstanding_rpcs_per_channel(); i++) {
+    int outstanding = config.load_type() == LoadType::CLOSED_LOOP
+                          ? config.outstanding_rpcs_per_channel()
+                          : 0;
+    for (int i = 0; i < outstanding; i++) {
       for (auto &channel : channels_) {
         auto *cq = cli_cqs_[t].get();
         t = (t + 1) % cli_cqs_.size();
-        auto start_req = [cq](TestService::Stub *stub, grpc::ClientContext *ctx,
-                              const SimpleRequest &request, void *tag) {
-          return stub->AsyncUnaryCall(ctx, request, cq, tag);
-        };
-
         TestService::Stub *stub = channel.get_stub();
-        const SimpleRequest &request = request_;
-        new ClientRpcContextUnaryImpl<SimpleRequest, SimpleResponse>(
-            stub, request, start_req, check_done);
+        switch (config.rpc_type()) {
+          case RpcType::UNARY:
+            StartUnaryContext(stub, cq, Timer::Now());
+            break;
+          case RpcType::STREAMING:
+            StartStreamingContext(stub, cq);
+            break;
+          case RpcType::STREAMING_FROM_SERVER:
+            StartServerStreamingContext(stub, cq);
+            break;
+        }
       }
     }
 
@@ -175,22 +317,85 @@ class AsyncClient GRPC_FINAL : public Client {
     }
   }
 
-  void ThreadFunc(Histogram *histogram, size_t thread_idx) GRPC_OVERRIDE {
+  void ThreadFunc(ConcurrentHistogram *histogram,
+                  size_t thread_idx) GRPC_OVERRIDE {
     void *got_tag;
     bool ok;
-    cli_cqs_[thread_idx]->Next(&got_tag, &ok);
+    auto *cq = cli_cqs_[thread_idx].get();
+    if (closed_loop()) {
+      cq->Next(&got_tag, &ok);
+    } else {
+      auto *issue = schedule(thread_idx);
+      // start everything that is due, timing each rpc from when it was due
+      while (issue->next() <= Timer::Now()) {
+        size_t channel = next_channel_[thread_idx];
+        next_channel_[thread_idx] = (channel + 1) % channels_.size();
+        StartUnaryContext(channels_[channel].get_stub(), cq, issue->next());
+        issue->Advance();
+      }
+      auto deadline = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(
+              std::chrono::duration<double>(issue->next())));
+      if (cq->AsyncNext(&got_tag, &ok, deadline) !=
+          CompletionQueue::GOT_EVENT) {
+        return;
+      }
+    }
 
     ClientRpcContext *ctx = ClientRpcContext::detag(got_tag);
-    if (ctx->RunNextState() == false) {
+    if (ctx->RunNextState(ok, histogram) == false) {
       // call the callback and then delete it
-      ctx->report_stats(histogram);
-      ctx->RunNextState();
-      ctx->StartNewClone();
+      ctx->RunNextState(ok, histogram);
+      if (closed_loop()) {
+        ctx->StartNewClone();
+      }
       delete ctx;
     }
   }
 
+ private:
+  void StartUnaryContext(TestService::Stub *stub, CompletionQueue *cq,
+                         double start) {
+    auto payload_size = request_.response_size();
+    auto check_done = [payload_size](grpc::Status s, SimpleResponse *response) {
+      GPR_ASSERT(s.IsOk() && (response->payload().type() ==
+                              grpc::testing::PayloadType::COMPRESSABLE) &&
+                 (response->payload().body().length() ==
+                  static_cast<size_t>(payload_size)));
+    };
+    auto start_req = [cq](TestService::Stub *stub, grpc::ClientContext *ctx,
+                          const SimpleRequest &request, void *tag) {
+      return stub->AsyncUnaryCall(ctx, request, cq, tag);
+    };
+    new ClientRpcContextUnaryImpl<SimpleRequest, SimpleResponse>(
+        stub, request_, start_req, check_done, start);
+  }
+
+  void StartStreamingContext(TestService::Stub *stub, CompletionQueue *cq) {
+    auto start_req = [cq](TestService::Stub *stub, grpc::ClientContext *ctx,
+                          void *tag) {
+      return stub->AsyncFullDuplexCall(ctx, cq, tag);
+    };
+    new ClientRpcContextStreamingImpl<StreamingOutputCallRequest,
+                                      StreamingOutputCallResponse>(
+        stub, streaming_request_, start_req);
+  }
+
+  void StartServerStreamingContext(TestService::Stub *stub,
+                                   CompletionQueue *cq) {
+    auto start_req = [cq](TestService::Stub *stub, grpc::ClientContext *ctx,
+                          const StreamingOutputCallRequest &request,
+                          void *tag) {
+      return stub->AsyncStreamingOutputCall(ctx, request, cq, tag);
+    };
+    new ClientRpcContextServerStreamingImpl<StreamingOutputCallRequest,
+                                            StreamingOutputCallResponse>(
+        stub, server_streaming_request_, start_req);
+  }
+
   std::vector<std::unique_ptr<CompletionQueue>> cli_cqs_;
+  // for open loop loads, the channel each thread issues its next rpc on
+  std::vector<size_t> next_channel_;
 };
 
 std::unique_ptr<Client> CreateAsyncClient(const ClientConfig &args) {
@@ -49,6 +49,7 @@
 #include <gflags/gflags.h>
 #include <grpc++/client_context.h>
 #include <grpc++/status.h>
+#include <grpc++/stream.h>
 #include <grpc++/server.h>
 #include <grpc++/server_builder.h>
 #include "test/core/util/grpc_profiler.h"
@@ -63,26 +64,102 @@ namespace testing {
 
 class SynchronousClient GRPC_FINAL : public Client {
  public:
-  SynchronousClient(const ClientConfig& config) : Client(config) {
+  SynchronousClient(const ClientConfig& config)
+      : Client(config), rpc_type_(config.rpc_type()) {
     size_t num_threads =
         config.outstanding_rpcs_per_channel() * config.client_channels();
     responses_.resize(num_threads);
+    if (rpc_type_ == RpcType::STREAMING) {
+      for (size_t i = 0; i < num_threads; i++) {
+        streams_.emplace_back(
+            new PingPongStream(channels_[i % channels_.size()].get_stub()));
+      }
+    }
     StartThreads(num_threads);
   }
 
-  ~SynchronousClient() { EndThreads(); }
+  ~SynchronousClient() {
+    EndThreads();
+    streams_.clear();
+  }
 
-  void ThreadFunc(Histogram* histogram, size_t thread_idx) {
+  void ThreadFunc(ConcurrentHistogram* histogram, size_t thread_idx) {
     auto* stub = channels_[thread_idx % channels_.size()].get_stub();
-    double start = Timer::Now();
+    double start;
+    if (closed_loop()) {
+      start = Timer::Now();
+    } else {
+      // Latency is measured from when the rpc was due, so time spent behind
+      // schedule waiting for the previous rpc counts against this one.
+      auto* issue = schedule(thread_idx);
+      start = issue->next();
+      issue->Advance();
+      SleepUntil(start);
+    }
+    switch (rpc_type_) {
+      case RpcType::UNARY:
+        DoUnaryCall(stub, histogram, thread_idx, start);
+        break;
+      case RpcType::STREAMING:
+        DoPingPong(histogram, thread_idx, start);
+        break;
+      case RpcType::STREAMING_FROM_SERVER:
+        DoServerStreamingCall(stub, histogram, start);
+        break;
+    }
+  }
+
+ private:
+  // A FullDuplexCall kept open for the lifetime of the client
+  struct PingPongStream {
+    explicit PingPongStream(TestService::Stub* stub)
+        : stream(stub->FullDuplexCall(&context)) {}
+    ~PingPongStream() {
+      stream->WritesDone();
+      GPR_ASSERT(stream->Finish().IsOk());
+    }
+
+    grpc::ClientContext context;
+    std::unique_ptr<grpc::ClientReaderWriter<StreamingOutputCallRequest,
+                                             StreamingOutputCallResponse>>
+        stream;
+    StreamingOutputCallResponse response;
+  };
+
+  void DoUnaryCall(TestService::Stub* stub, ConcurrentHistogram* histogram,
+                   size_t thread_idx, double start) {
     grpc::ClientContext context;
     grpc::Status s =
         stub->UnaryCall(&context, request_, &responses_[thread_idx]);
     histogram->Add((Timer::Now() - start) * 1e9);
   }
 
- private:
+  void DoPingPong(ConcurrentHistogram* histogram, size_t thread_idx,
+                  double start) {
+    auto* s = streams_[thread_idx].get();
+    GPR_ASSERT(s->stream->Write(streaming_request_));
+    GPR_ASSERT(s->stream->Read(&s->response));
+    histogram->Add((Timer::Now() - start) * 1e9);
+  }
+
+  // Records the time taken by each message of the response stream
+  void DoServerStreamingCall(TestService::Stub* stub,
+                             ConcurrentHistogram* histogram, double start) {
+    grpc::ClientContext context;
+    StreamingOutputCallResponse response;
+    auto stream =
+        stub->StreamingOutputCall(&context, server_streaming_request_);
+    while (stream->Read(&response)) {
+      double now = Timer::Now();
+      histogram->Add((now - start) * 1e9);
+      start = now;
+    }
+    GPR_ASSERT(stream->Finish().IsOk());
+  }
+
+  const RpcType rpc_type_;
   std::vector<SimpleResponse> responses_;
+  std::vector<std::unique_ptr<PingPongStream>> streams_;
 };
 
 std::unique_ptr<Client> CreateSynchronousClient(const ClientConfig& config) {
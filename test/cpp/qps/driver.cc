@@ -186,14 +186,17 @@ ScenarioResult RunScenario(const ClientConfig& initial_client_config,
     GPR_ASSERT(server.stream->Read(&server_status));
     const auto& stats = server_status.stats();
     result.server_resources.push_back(ResourceUsage{
-        stats.time_elapsed(), stats.time_user(), stats.time_system()});
+        stats.time_elapsed(), stats.time_user(), stats.time_system(),
+        stats.context_switches(), stats.allocs()});
   }
   for (auto& client : clients) {
     GPR_ASSERT(client.stream->Read(&client_status));
     const auto& stats = client_status.stats();
     result.latencies.MergeProto(stats.latencies());
+    result.bytes_received += stats.bytes_received();
     result.client_resources.push_back(ResourceUsage{
-        stats.time_elapsed(), stats.time_user(), stats.time_system()});
+        stats.time_elapsed(), stats.time_user(), stats.time_system(),
+        stats.context_switches(), stats.allocs()});
   }
 
   for (auto& client : clients) {
@@ -43,10 +43,16 @@ struct ResourceUsage {
   double wall_time;
   double user_time;
   double system_time;
+  double context_switches;
+  double allocs;
 };
 
 struct ScenarioResult {
+  ScenarioResult() : bytes_received(0) {}
+
   Histogram latencies;
+  // payload bytes received by all clients
+  double bytes_received;
   std::vector<ResourceUsage> client_resources;
   std::vector<ResourceUsage> server_resources;
 };
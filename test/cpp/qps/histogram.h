@@ -35,11 +35,14 @@
 #define TEST_QPS_HISTOGRAM_H
 
 #include <grpc/support/histogram.h>
+#include <grpc/support/log.h>
 #include "test/cpp/qps/qpstest.pb.h"
 
 namespace grpc {
 namespace testing {
 
+class ConcurrentHistogram;
+
 class Histogram {
  public:
   Histogram() : impl_(gpr_histogram_create(0.01, 60e9)) {}
@@ -74,11 +77,33 @@ class Histogram {
   }
 
  private:
+  friend class ConcurrentHistogram;
+
   Histogram(const Histogram&);
   Histogram& operator=(const Histogram&);
 
   gpr_histogram* impl_;
 };
+
+// A histogram that any number of threads may Add() to at once; its contents
+// are collected by draining them into a Histogram.
+class ConcurrentHistogram {
+ public:
+  ConcurrentHistogram() : impl_(gpr_concurrent_histogram_create(0.01, 60e9)) {}
+  ~ConcurrentHistogram() { gpr_concurrent_histogram_destroy(impl_); }
+
+  void Add(double value) { gpr_concurrent_histogram_add(impl_, value); }
+  // Moves everything added since the previous call into h.
+  void DrainInto(Histogram* h) {
+    GPR_ASSERT(gpr_histogram_merge_and_reset_concurrent(h->impl_, impl_));
+  }
+
+ private:
+  ConcurrentHistogram(const ConcurrentHistogram&);
+  ConcurrentHistogram& operator=(const ConcurrentHistogram&);
+
+  gpr_concurrent_histogram* impl_;
+};
 }
 }
 
@@ -54,11 +54,22 @@ DEFINE_int32(client_channels, 1, "Number of client channels");
 DEFINE_int32(payload_size, 1, "Payload size");
 DEFINE_string(client_type, "SYNCHRONOUS_CLIENT", "Client type");
 DEFINE_int32(async_client_threads, 1, "Async client threads");
+DEFINE_string(rpc_type, "UNARY",
+              "Rpc type: UNARY, STREAMING (ping-pong) or "
+              "STREAMING_FROM_SERVER (bulk throughput)");
+DEFINE_int32(messages_per_stream, 1000,
+             "Responses per call for STREAMING_FROM_SERVER");
+DEFINE_string(load_type, "CLOSED_LOOP",
+              "Load type: CLOSED_LOOP, POISSON or CONSTANT_RATE");
+DEFINE_double(offered_load, 1000,
+              "Rpcs per second offered by each client for open loop loads");
 
 using grpc::testing::ClientConfig;
 using grpc::testing::ServerConfig;
 using grpc::testing::ClientType;
 using grpc::testing::ServerType;
+using grpc::testing::RpcType;
+using grpc::testing::LoadType;
 using grpc::testing::ResourceUsage;
 using grpc::testing::sum;
 
@@ -75,8 +86,12 @@ int main(int argc, char **argv) {
 
   ClientType client_type;
   ServerType server_type;
+  RpcType rpc_type;
+  LoadType load_type;
   GPR_ASSERT(ClientType_Parse(FLAGS_client_type, &client_type));
   GPR_ASSERT(ServerType_Parse(FLAGS_server_type, &server_type));
+  GPR_ASSERT(RpcType_Parse(FLAGS_rpc_type, &rpc_type));
+  GPR_ASSERT(LoadType_Parse(FLAGS_load_type, &load_type));
 
   ClientConfig client_config;
   client_config.set_client_type(client_type);
@@ -86,6 +101,10 @@ int main(int argc, char **argv) {
   client_config.set_client_channels(FLAGS_client_channels);
   client_config.set_payload_size(FLAGS_payload_size);
   client_config.set_async_client_threads(FLAGS_async_client_threads);
+  client_config.set_rpc_type(rpc_type);
+  client_config.set_messages_per_stream(FLAGS_messages_per_stream);
+  client_config.set_load_type(load_type);
+  client_config.set_offered_load(FLAGS_offered_load);
 
   ServerConfig server_config;
   server_config.set_server_type(server_type);
@@ -95,11 +114,21 @@ int main(int argc, char **argv) {
   auto result = RunScenario(client_config, FLAGS_num_clients, server_config,
                             FLAGS_num_servers);
 
+  if (load_type != LoadType::CLOSED_LOOP) {
+    gpr_log(GPR_INFO, "Offered load: %.1f qps",
+            FLAGS_offered_load * FLAGS_num_clients);
+  }
+
   gpr_log(GPR_INFO, "QPS: %.1f",
           result.latencies.Count() /
               average(result.client_resources,
                       [](ResourceUsage u) { return u.wall_time; }));
 
+  gpr_log(GPR_INFO, "Throughput: %.2f MB/s",
+          result.bytes_received / (1024 * 1024) /
+              average(result.client_resources,
+                      [](ResourceUsage u) { return u.wall_time; }));
+
   gpr_log(GPR_INFO, "Latencies (50/95/99/99.9%%-ile): %.1f/%.1f/%.1f/%.1f us",
           result.latencies.Percentile(50) / 1000,
           result.latencies.Percentile(95) / 1000,
@@ -127,6 +156,29 @@ int main(int argc, char **argv) {
               sum(result.client_resources,
                   [](ResourceUsage u) { return u.wall_time; }));
 
+  // costs per rpc, counting each response of a stream as one rpc
+  double rpcs = result.latencies.Count();
+  gpr_log(GPR_INFO, "Server CPU: %.1f us/rpc",
+          1e6 * sum(result.server_resources, [](ResourceUsage u) {
+            return u.user_time + u.system_time;
+          }) / rpcs);
+  gpr_log(GPR_INFO, "Client CPU: %.1f us/rpc",
+          1e6 * sum(result.client_resources, [](ResourceUsage u) {
+            return u.user_time + u.system_time;
+          }) / rpcs);
+  gpr_log(GPR_INFO, "Server context switches: %.2f/rpc",
+          sum(result.server_resources,
+              [](ResourceUsage u) { return u.context_switches; }) / rpcs);
+  gpr_log(GPR_INFO, "Client context switches: %.2f/rpc",
+          sum(result.client_resources,
+              [](ResourceUsage u) { return u.context_switches; }) / rpcs);
+  gpr_log(GPR_INFO, "Server allocations: %.2f/rpc",
+          sum(result.server_resources,
+              [](ResourceUsage u) { return u.allocs; }) / rpcs);
+  gpr_log(GPR_INFO, "Client allocations: %.2f/rpc",
+          sum(result.client_resources,
+              [](ResourceUsage u) { return u.allocs; }) / rpcs);
+
   grpc_shutdown();
   return 0;
 }
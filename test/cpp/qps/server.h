@@ -55,6 +55,8 @@ class Server {
     stats.set_time_elapsed(timer_result.wall);
     stats.set_time_system(timer_result.system);
     stats.set_time_user(timer_result.user);
+    stats.set_context_switches(timer_result.context_switches);
+    stats.set_allocs(timer_result.allocs);
     return stats;
   }
 
@@ -33,6 +33,7 @@
 
 #include <forward_list>
 #include <functional>
+#include <mutex>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/signal.h>
@@ -48,6 +49,7 @@
 #include <grpc++/server_context.h>
 #include <grpc++/server_credentials.h>
 #include <grpc++/status.h>
+#include <grpc++/stream.h>
 #include <gtest/gtest.h>
 #include "src/cpp/server/thread_pool.h"
 #include "test/core/util/grpc_profiler.h"
@@ -63,7 +65,8 @@ namespace testing {
 class AsyncQpsServerTest : public Server {
  public:
   AsyncQpsServerTest(const ServerConfig &config, int port)
-      : srv_cq_(), async_service_(&srv_cq_), server_(nullptr) {
+      : srv_cq_(), async_service_(&srv_cq_), server_(nullptr),
+        shutdown_(false) {
     char *server_address = NULL;
     gpr_join_host_port(&server_address, "::", port);
 
@@ -78,10 +81,24 @@ class AsyncQpsServerTest : public Server {
     using namespace std::placeholders;
     request_unary_ = std::bind(&TestService::AsyncService::RequestUnaryCall,
                                &async_service_, _1, _2, _3, &srv_cq_, _4);
+    request_streaming_ =
+        std::bind(&TestService::AsyncService::RequestFullDuplexCall,
+                  &async_service_, _1, _2, &srv_cq_, _3);
+    request_server_streaming_ =
+        std::bind(&TestService::AsyncService::RequestStreamingOutputCall,
+                  &async_service_, _1, _2, _3, &srv_cq_, _4);
     for (int i = 0; i < 100; i++) {
       contexts_.push_front(
           new ServerRpcContextUnaryImpl<SimpleRequest, SimpleResponse>(
               request_unary_, UnaryCall));
+      contexts_.push_front(
+          new ServerRpcContextStreamingImpl<StreamingOutputCallRequest,
+                                            StreamingOutputCallResponse>(
+              request_streaming_, StreamingCall));
+      contexts_.push_front(
+          new ServerRpcContextServerStreamingImpl<StreamingOutputCallRequest,
+                                                  StreamingOutputCallResponse>(
+              request_server_streaming_, ServerStreamingCall));
     }
     for (int i = 0; i < config.threads(); i++) {
       threads_.push_back(std::thread([=]() {
@@ -89,11 +106,12 @@ class AsyncQpsServerTest : public Server {
         bool ok;
         void *got_tag;
         while (srv_cq_.Next(&got_tag, &ok)) {
-          if (ok) {
-            ServerRpcContext *ctx = detag(got_tag);
-            // The tag is a pointer to an RPC context to invoke
-            if (ctx->RunNextState() == false) {
-              // this RPC context is done, so refresh it
+          ServerRpcContext *ctx = detag(got_tag);
+          // The tag is a pointer to an RPC context to invoke
+          if (ctx->RunNextState(ok) == false) {
+            // this RPC context is done, so refresh it
+            std::lock_guard<std::mutex> g(shutdown_mutex_);
+            if (!shutdown_) {
               ctx->Reset();
             }
           }
@@ -103,6 +121,10 @@ class AsyncQpsServerTest : public Server {
     }
   }
   ~AsyncQpsServerTest() {
+    {
+      std::lock_guard<std::mutex> g(shutdown_mutex_);
+      shutdown_ = true;
+    }
     server_->Shutdown();
     srv_cq_.Shutdown();
     for (auto &thr : threads_) {
@@ -119,7 +141,8 @@ class AsyncQpsServerTest : public Server {
    public:
     ServerRpcContext() {}
     virtual ~ServerRpcContext(){};
-    virtual bool RunNextState() = 0;  // do next state, return false if all done
+    // do next state, return false if all done
+    virtual bool RunNextState(bool ok) = 0;
     virtual void Reset() = 0;         // start this back at a clean state
   };
   static void *tag(ServerRpcContext *func) {
@@ -146,7 +169,9 @@ class AsyncQpsServerTest : public Server {
                       AsyncQpsServerTest::tag(this));
     }
     ~ServerRpcContextUnaryImpl() GRPC_OVERRIDE {}
-    bool RunNextState() GRPC_OVERRIDE { return (this->*next_state_)(); }
+    bool RunNextState(bool ok) GRPC_OVERRIDE {
+      return (this->*next_state_)(ok);
+    }
     void Reset() GRPC_OVERRIDE {
       srv_ctx_ = ServerContext();
       req_ = RequestType();
@@ -160,8 +185,10 @@ class AsyncQpsServerTest : public Server {
     }
 
    private:
-    bool finisher() { return false; }
-    bool invoker() {
+    bool finisher(bool) { return false; }
+    bool invoker(bool ok) {
+      if (!ok) return false;
+
       ResponseType response;
 
       // Call the RPC processing function
@@ -174,7 +201,7 @@ class AsyncQpsServerTest : public Server {
     }
     ServerContext srv_ctx_;
     RequestType req_;
-    bool (ServerRpcContextUnaryImpl::*next_state_)();
+    bool (ServerRpcContextUnaryImpl::*next_state_)(bool);
     std::function<void(ServerContext *, RequestType *,
                        grpc::ServerAsyncResponseWriter<ResponseType> *, void *)>
         request_method_;
@@ -183,6 +210,145 @@ class AsyncQpsServerTest : public Server {
     grpc::ServerAsyncResponseWriter<ResponseType> response_writer_;
   };
 
+  // Answers each request read from a bidirectional stream until the client
+  // half-closes it.
+  template <class RequestType, class ResponseType>
+  class ServerRpcContextStreamingImpl : public ServerRpcContext {
+   public:
+    typedef grpc::ServerAsyncReaderWriter<ResponseType, RequestType>
+        StreamType;
+
+    ServerRpcContextStreamingImpl(
+        std::function<void(ServerContext *, StreamType *, void *)>
+            request_method,
+        std::function<grpc::Status(const RequestType *, ResponseType *)>
+            invoke_method)
+        : request_method_(request_method), invoke_method_(invoke_method) {
+      Reset();
+    }
+    ~ServerRpcContextStreamingImpl() GRPC_OVERRIDE {}
+    bool RunNextState(bool ok) GRPC_OVERRIDE {
+      return (this->*next_state_)(ok);
+    }
+    void Reset() GRPC_OVERRIDE {
+      srv_ctx_.reset(new ServerContext);
+      stream_.reset(new StreamType(srv_ctx_.get()));
+      next_state_ = &ServerRpcContextStreamingImpl::request_done;
+      request_method_(srv_ctx_.get(), stream_.get(),
+                      AsyncQpsServerTest::tag(this));
+    }
+
+   private:
+    bool request_done(bool ok) {
+      if (!ok) return false;
+      return start_read();
+    }
+    bool start_read() {
+      next_state_ = &ServerRpcContextStreamingImpl::read_done;
+      stream_->Read(&req_, AsyncQpsServerTest::tag(this));
+      return true;
+    }
+    bool read_done(bool ok) {
+      if (!ok) {
+        // the client has finished sending
+        return finish(Status::OK);
+      }
+      grpc::Status status = invoke_method_(&req_, &response_);
+      if (!status.IsOk()) {
+        return finish(status);
+      }
+      next_state_ = &ServerRpcContextStreamingImpl::write_done;
+      stream_->Write(response_, AsyncQpsServerTest::tag(this));
+      return true;
+    }
+    bool write_done(bool ok) {
+      if (!ok) {
+        return finish(Status::OK);
+      }
+      return start_read();
+    }
+    bool finish(const grpc::Status &status) {
+      next_state_ = &ServerRpcContextStreamingImpl::finish_done;
+      stream_->Finish(status, AsyncQpsServerTest::tag(this));
+      return true;
+    }
+    bool finish_done(bool) { return false; }
+
+    std::unique_ptr<ServerContext> srv_ctx_;
+    RequestType req_;
+    ResponseType response_;
+    bool (ServerRpcContextStreamingImpl::*next_state_)(bool);
+    std::function<void(ServerContext *, StreamType *, void *)> request_method_;
+    std::function<grpc::Status(const RequestType *, ResponseType *)>
+        invoke_method_;
+    std::unique_ptr<StreamType> stream_;
+  };
+
+  // Writes one response per entry of the request's response_parameters.
+  template <class RequestType, class ResponseType>
+  class ServerRpcContextServerStreamingImpl : public ServerRpcContext {
+   public:
+    typedef grpc::ServerAsyncWriter<ResponseType> StreamType;
+
+    ServerRpcContextServerStreamingImpl(
+        std::function<void(ServerContext *, RequestType *, StreamType *,
+                           void *)> request_method,
+        std::function<grpc::Status(const RequestType *, int, ResponseType *)>
+            invoke_method)
+        : request_method_(request_method), invoke_method_(invoke_method) {
+      Reset();
+    }
+    ~ServerRpcContextServerStreamingImpl() GRPC_OVERRIDE {}
+    bool RunNextState(bool ok) GRPC_OVERRIDE {
+      return (this->*next_state_)(ok);
+    }
+    void Reset() GRPC_OVERRIDE {
+      srv_ctx_.reset(new ServerContext);
+      stream_.reset(new StreamType(srv_ctx_.get()));
+      req_ = RequestType();
+      next_response_ = 0;
+      next_state_ = &ServerRpcContextServerStreamingImpl::write_done;
+      request_method_(srv_ctx_.get(), &req_, stream_.get(),
+                      AsyncQpsServerTest::tag(this));
+    }
+
+   private:
+    // Also handles the arrival of the request, before anything is written.
+    bool write_done(bool ok) {
+      if (!ok) {
+        // request failed or the client went away
+        return next_response_ == 0 ? false : finish(Status::OK);
+      }
+      if (next_response_ == req_.response_parameters_size()) {
+        return finish(Status::OK);
+      }
+      grpc::Status status =
+          invoke_method_(&req_, next_response_++, &response_);
+      if (!status.IsOk()) {
+        return finish(status);
+      }
+      stream_->Write(response_, AsyncQpsServerTest::tag(this));
+      return true;
+    }
+    bool finish(const grpc::Status &status) {
+      next_state_ = &ServerRpcContextServerStreamingImpl::finish_done;
+      stream_->Finish(status, AsyncQpsServerTest::tag(this));
+      return true;
+    }
+    bool finish_done(bool) { return false; }
+
+    std::unique_ptr<ServerContext> srv_ctx_;
+    RequestType req_;
+    ResponseType response_;
+    int next_response_;
+    bool (ServerRpcContextServerStreamingImpl::*next_state_)(bool);
+    std::function<void(ServerContext *, RequestType *, StreamType *, void *)>
+        request_method_;
+    std::function<grpc::Status(const RequestType *, int, ResponseType *)>
+        invoke_method_;
+    std::unique_ptr<StreamType> stream_;
+  };
+
   static Status UnaryCall(const SimpleRequest *request,
                           SimpleResponse *response) {
     if (request->has_response_size() && request->response_size() > 0) {
@@ -193,6 +359,25 @@ class AsyncQpsServerTest : public Server {
     }
     return Status::OK;
   }
+  static Status StreamingCall(const StreamingOutputCallRequest *request,
+                              StreamingOutputCallResponse *response) {
+    for (int i = 0; i < request->response_parameters_size(); i++) {
+      Status status = ServerStreamingCall(request, i, response);
+      if (!status.IsOk()) return status;
+    }
+    return Status::OK;
+  }
+  // Builds the index'th response of a StreamingOutputCall
+  static Status ServerStreamingCall(const StreamingOutputCallRequest *request,
+                                    int index,
+                                    StreamingOutputCallResponse *response) {
+    if (!SetPayload(request->response_type(),
+                    request->response_parameters(index).size(),
+                    response->mutable_payload())) {
+      return Status(grpc::StatusCode::INTERNAL, "Error creating payload.");
+    }
+    return Status::OK;
+  }
   CompletionQueue srv_cq_;
   TestService::AsyncService async_service_;
   std::vector<std::thread> threads_;
@@ -200,7 +385,17 @@ class AsyncQpsServerTest : public Server {
   std::function<void(ServerContext *, SimpleRequest *,
                      grpc::ServerAsyncResponseWriter<SimpleResponse> *, void *)>
       request_unary_;
+  std::function<void(
+      ServerContext *,
+      grpc::ServerAsyncReaderWriter<StreamingOutputCallResponse,
+                                    StreamingOutputCallRequest> *,
+      void *)> request_streaming_;
+  std::function<void(ServerContext *, StreamingOutputCallRequest *,
+                     grpc::ServerAsyncWriter<StreamingOutputCallResponse> *,
+                     void *)> request_server_streaming_;
   std::forward_list<ServerRpcContext *> contexts_;
+  std::mutex shutdown_mutex_;
+  bool shutdown_;
 };
 
 std::unique_ptr<Server> CreateAsyncServer(const ServerConfig &config,
@@ -71,6 +71,36 @@ class TestServiceImpl GRPC_FINAL : public TestService::Service {
     }
     return Status::OK;
   }
+  Status StreamingOutputCall(
+      ServerContext* context, const StreamingOutputCallRequest* request,
+      ServerWriter<StreamingOutputCallResponse>* writer) GRPC_OVERRIDE {
+    StreamingOutputCallResponse response;
+    for (const auto& params : request->response_parameters()) {
+      if (!Server::SetPayload(request->response_type(), params.size(),
+                              response.mutable_payload())) {
+        return Status(grpc::StatusCode::INTERNAL, "Error creating payload.");
+      }
+      if (!writer->Write(response)) break;
+    }
+    return Status::OK;
+  }
+  Status FullDuplexCall(ServerContext* context,
+                        ServerReaderWriter<StreamingOutputCallResponse,
+                                           StreamingOutputCallRequest>* stream)
+      GRPC_OVERRIDE {
+    StreamingOutputCallRequest request;
+    StreamingOutputCallResponse response;
+    while (stream->Read(&request)) {
+      for (const auto& params : request.response_parameters()) {
+        if (!Server::SetPayload(request.response_type(), params.size(),
+                                response.mutable_payload())) {
+          return Status(grpc::StatusCode::INTERNAL, "Error creating payload.");
+        }
+        if (!stream->Write(response)) return Status::OK;
+      }
+    }
+    return Status::OK;
+  }
 };
 
 class SynchronousServer GRPC_FINAL : public grpc::testing::Server {
@@ -1,6 +1,15 @@
 #!/bin/sh
 
 # performs a single qps run with one client and one server
+#
+# arguments are passed on to qps_driver, eg. to benchmark streams:
+#   single_run_localhost.sh --rpc_type=STREAMING
+#   single_run_localhost.sh --rpc_type=STREAMING_FROM_SERVER \
+#       --payload_size=65536 --messages_per_stream=1000
+# a synchronous server needs at least as many --server_threads as there are
+# concurrent streams, since each stream holds a thread for its lifetime
+# open loop loads take latency from when each rpc was due to be sent:
+#   single_run_localhost.sh --load_type=POISSON --offered_load=5000
 
 set -ex
 
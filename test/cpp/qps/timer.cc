@@ -35,6 +35,7 @@
 
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <grpc/support/alloc.h>
 #include <grpc/support/time.h>
 
 Timer::Timer() : start_(Sample()) {}
@@ -51,13 +52,17 @@ static double time_double(struct timeval* tv) {
 Timer::Result Timer::Sample() {
   struct rusage usage;
   struct timeval tv;
+  gpr_alloc_stats alloc_stats;
   gettimeofday(&tv, nullptr);
   getrusage(RUSAGE_SELF, &usage);
+  gpr_alloc_get_stats(&alloc_stats);
 
   Result r;
   r.wall = time_double(&tv);
   r.user = time_double(&usage.ru_utime);
   r.system = time_double(&usage.ru_stime);
+  r.context_switches = usage.ru_nvcsw + usage.ru_nivcsw;
+  r.allocs = alloc_stats.allocs;
   return r;
 }
 
@@ -67,5 +72,7 @@ Timer::Result Timer::Mark() {
   r.wall = s.wall - start_.wall;
   r.user = s.user - start_.user;
   r.system = s.system - start_.system;
+  r.context_switches = s.context_switches - start_.context_switches;
+  r.allocs = s.allocs - start_.allocs;
   return r;
 }
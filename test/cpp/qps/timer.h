@@ -42,6 +42,10 @@ class Timer {
     double wall;
     double user;
     double system;
+    // voluntary plus involuntary context switches
+    double context_switches;
+    // gpr_malloc calls, when counting is enabled
+    double allocs;
   };
 
   Result Mark();
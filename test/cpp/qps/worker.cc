@@ -61,6 +61,7 @@
 
 DEFINE_int32(driver_port, 0, "Driver server port.");
 DEFINE_int32(server_port, 0, "Spawned server port.");
+DEFINE_bool(count_allocs, true, "Report gpr_malloc calls in stats.");
 
 // In some distros, gflags is in the namespace google, and in some others,
 // in gflags. This hack is enabling us to find both.
@@ -228,6 +229,7 @@ static void RunServer() {
 int main(int argc, char** argv) {
   grpc_init();
   ParseCommandLineFlags(&argc, &argv, true);
+  gpr_alloc_enable_counting(FLAGS_count_allocs);
 
   grpc::testing::RunServer();
 
@@ -0,0 +1,110 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Several threads outside a pool of four schedule small callbacks as fast as
+// they can; reports the rate at which the pool runs them.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpc/support/log.h>
+#include "src/cpp/server/thread_pool.h"
+
+namespace grpc {
+namespace {
+
+// Counts completed producers and lets the benchmark wait for all of them.
+class Counter {
+ public:
+  Counter() : count_(0) {}
+
+  void Increment() {
+    std::unique_lock<std::mutex> lock(mu_);
+    count_++;
+    cv_.notify_all();
+  }
+
+  void WaitFor(int count) {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (count_ < count) {
+      cv_.wait(lock);
+    }
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  int count_;
+};
+
+void RunBenchmark() {
+  ThreadPool thread_pool(4);
+  const int kProducers = 4;
+  const int kCallbacksPerProducer = 100000;
+  std::atomic<int> count(0);
+  Counter done;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kProducers; i++) {
+    producers.emplace_back([&thread_pool, &count, &done]() {
+      for (int j = 0; j < kCallbacksPerProducer; j++) {
+        thread_pool.ScheduleCallback([&count, &done]() {
+          if (++count % kCallbacksPerProducer == 0) {
+            done.Increment();
+          }
+        });
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  done.WaitFor(kProducers);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  gpr_log(GPR_INFO, "Ran %d callbacks in %.3fs: %.0f callbacks/s",
+          kProducers * kCallbacksPerProducer, elapsed.count(),
+          kProducers * kCallbacksPerProducer / elapsed.count());
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::RunBenchmark();
+  return 0;
+}
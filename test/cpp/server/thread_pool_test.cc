@@ -31,13 +31,30 @@
  *
  */
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdlib>
 #include <functional>
 #include <mutex>
+#include <new>
 
 #include "src/cpp/server/thread_pool.h"
 #include <gtest/gtest.h>
 
+// Counts every C++ heap allocation in the process.
+static std::atomic<int> g_cxx_allocs(0);
+
+void* operator new(std::size_t size) {
+  g_cxx_allocs++;
+  void* p = malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
 namespace grpc {
 
 class ThreadPoolTest : public ::testing::Test {
@@ -68,6 +85,141 @@ TEST_F(ThreadPoolTest, ScheduleCallback) {
   }
 }
 
+// Counts completed callbacks and lets the test wait for a target count.
+class Counter {
+ public:
+  Counter() : count_(0) {}
+
+  void Increment() {
+    std::unique_lock<std::mutex> lock(mu_);
+    count_++;
+    cv_.notify_all();
+  }
+
+  void WaitFor(int count) {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (count_ < count) {
+      cv_.wait(lock);
+    }
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  int count_;
+};
+
+// Each callback schedules two more until depth reaches zero, exercising
+// scheduling from pool threads onto their own queues and stealing.
+void FanOut(ThreadPool* pool, Counter* counter, int depth) {
+  if (depth > 0) {
+    pool->ScheduleCallback(std::bind(FanOut, pool, counter, depth - 1));
+    pool->ScheduleCallback(std::bind(FanOut, pool, counter, depth - 1));
+  }
+  counter->Increment();
+}
+
+TEST_F(ThreadPoolTest, ScheduleFromCallbacks) {
+  const int kDepth = 10;
+  Counter counter;
+  thread_pool_.ScheduleCallback(
+      std::bind(FanOut, &thread_pool_, &counter, kDepth));
+  counter.WaitFor((1 << (kDepth + 1)) - 1);
+}
+
+TEST_F(ThreadPoolTest, DrainsOnDestruction) {
+  const int kCallbacks = 1000;
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i < kCallbacks; i++) {
+      pool.ScheduleCallback([&count]() { count++; });
+    }
+  }
+  EXPECT_EQ(kCallbacks, count);
+}
+
+// Callbacks that only finish once all of them are running at the same time
+// can only complete if the pool grows to fit them.
+TEST_F(ThreadPoolTest, GrowsWhenBusy) {
+  const int kCallbacks = 4;
+  ThreadPool pool(1, kCallbacks);
+  EXPECT_EQ(1, pool.num_threads());
+  std::mutex mu;
+  std::condition_variable cv;
+  int running = 0;
+  Counter done;
+  for (int i = 0; i < kCallbacks; i++) {
+    pool.ScheduleCallback([&mu, &cv, &running, &done]() {
+      std::unique_lock<std::mutex> lock(mu);
+      running++;
+      cv.notify_all();
+      while (running < kCallbacks) {
+        cv.wait(lock);
+      }
+      lock.unlock();
+      done.Increment();
+    });
+  }
+  done.WaitFor(kCallbacks);
+  EXPECT_EQ(kCallbacks, pool.num_threads());
+}
+
+// More callbacks than the queues hold wait in the overflow queue while the
+// only thread is busy, and all of them still run.
+TEST_F(ThreadPoolTest, RunsCallbacksBeyondQueueCapacity) {
+  const int kCallbacks = 2000;
+  ThreadPool pool(1);
+  std::mutex mu;
+  std::condition_variable cv;
+  bool blocked = true;
+  pool.ScheduleCallback([&mu, &cv, &blocked]() {
+    std::unique_lock<std::mutex> lock(mu);
+    while (blocked) {
+      cv.wait(lock);
+    }
+  });
+  std::atomic<int> count(0);
+  Counter done;
+  for (int i = 0; i < kCallbacks; i++) {
+    pool.ScheduleCallback([&count, &done]() {
+      if (++count == kCallbacks) {
+        done.Increment();
+      }
+    });
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu);
+    blocked = false;
+    cv.notify_all();
+  }
+  done.WaitFor(1);
+  EXPECT_EQ(kCallbacks, count);
+}
+
+// Once the queues have been used, scheduling a callback small enough for
+// std::function to store inline makes no heap allocation.
+TEST_F(ThreadPoolTest, ScheduleDoesNotAllocate) {
+  const int kCallbacks = 1000;
+  std::atomic<int> count(0);
+  Counter done;
+  auto callback = [&count, &done]() {
+    if (++count % kCallbacks == 0) {
+      done.Increment();
+    }
+  };
+  for (int i = 0; i < kCallbacks; i++) {
+    thread_pool_.ScheduleCallback(callback);
+  }
+  done.WaitFor(1);
+  int allocs_before = g_cxx_allocs.load();
+  for (int i = 0; i < kCallbacks; i++) {
+    thread_pool_.ScheduleCallback(callback);
+  }
+  done.WaitFor(2);
+  EXPECT_EQ(0, g_cxx_allocs.load() - allocs_before);
+}
+
 }  // namespace grpc
 
 int main(int argc, char** argv) {
@@ -0,0 +1,131 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+// Reports FreeList allocation cost with many threads allocating at once,
+// against the heap and a single mutex guarded list.
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <grpc/support/log.h>
+#include "src/cpp/util/free_list.h"
+
+namespace grpc {
+namespace {
+
+struct Item {
+  char payload[96];
+};
+
+// The free list this replaced: one list per type behind one mutex.
+class SharedFreeList {
+ public:
+  void* Allocate() {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (free_.empty()) {
+      return ::operator new(sizeof(Item));
+    }
+    void* p = free_.back();
+    free_.pop_back();
+    return p;
+  }
+  void Free(void* p) {
+    std::lock_guard<std::mutex> lock(mu_);
+    free_.push_back(p);
+  }
+  ~SharedFreeList() {
+    for (void* p : free_) {
+      ::operator delete(p);
+    }
+  }
+
+ private:
+  std::mutex mu_;
+  std::vector<void*> free_;
+};
+
+// Runs kThreads threads that each keep a few blocks live, the way a server
+// thread holds a few rpcs at once, and returns the time per allocation.
+template <class Allocate, class Free>
+double TimeConcurrent(Allocate allocate, Free free) {
+  const int kThreads = 8;
+  const int kRounds = 100000;
+  const int kLive = 4;
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&allocate, &free]() {
+      void* live[kLive];
+      for (int j = 0; j < kRounds; j++) {
+        for (int k = 0; k < kLive; k++) {
+          live[k] = allocate();
+          static_cast<Item*>(live[k])->payload[0] = static_cast<char>(j);
+        }
+        for (int k = 0; k < kLive; k++) {
+          free(live[k]);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return 1e9 * elapsed.count() / (kThreads * kRounds * kLive);
+}
+
+void RunBenchmark() {
+  SharedFreeList shared;
+  double per_thread = TimeConcurrent(
+      []() { return FreeList<Item>::Allocate(sizeof(Item)); },
+      [](void* p) { FreeList<Item>::Free(p, sizeof(Item)); });
+  double heap = TimeConcurrent([]() { return ::operator new(sizeof(Item)); },
+                               [](void* p) { ::operator delete(p); });
+  double locked = TimeConcurrent([&shared]() { return shared.Allocate(); },
+                                 [&shared](void* p) { shared.Free(p); });
+  gpr_log(GPR_INFO,
+          "8 threads: per-thread lists %.1f ns/alloc, heap %.1f ns/alloc, "
+          "shared locked list %.1f ns/alloc",
+          per_thread, heap, locked);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::RunBenchmark();
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ *
+ * Copyright 2015, Google Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer
+ * in the documentation and/or other materials provided with the
+ * distribution.
+ *     * Neither the name of Google Inc. nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <thread>
+#include <vector>
+
+#include "src/cpp/util/free_list.h"
+#include <gtest/gtest.h>
+
+namespace grpc {
+namespace {
+
+struct Item {
+  char payload[96];
+};
+
+struct OtherItem {
+  char payload[96];
+};
+
+const size_t kMaxFree = FreeList<Item>::kMaxFreePerThread;
+
+TEST(FreeListTest, ReusesFreedBlock) {
+  void* p = FreeList<Item>::Allocate(sizeof(Item));
+  FreeList<Item>::Free(p, sizeof(Item));
+  void* q = FreeList<Item>::Allocate(sizeof(Item));
+  EXPECT_EQ(p, q);
+  FreeList<Item>::Free(q, sizeof(Item));
+}
+
+TEST(FreeListTest, KeepsAtMostMaxFreePerThread) {
+  std::thread([]() {
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < kMaxFree + 8; i++) {
+      blocks.push_back(FreeList<Item>::Allocate(sizeof(Item)));
+    }
+    for (void* p : blocks) {
+      FreeList<Item>::Free(p, sizeof(Item));
+    }
+    // The list is last in, first out, and the last eight frees went back
+    // to the heap because it was full.
+    std::vector<void*> reused;
+    for (size_t i = 0; i < kMaxFree; i++) {
+      reused.push_back(FreeList<Item>::Allocate(sizeof(Item)));
+      EXPECT_EQ(blocks[kMaxFree - 1 - i], reused.back());
+    }
+    for (void* p : reused) {
+      FreeList<Item>::Free(p, sizeof(Item));
+    }
+  }).join();
+}
+
+TEST(FreeListTest, ThreadsDoNotShareBlocks) {
+  void* p = FreeList<OtherItem>::Allocate(sizeof(OtherItem));
+  FreeList<OtherItem>::Free(p, sizeof(OtherItem));
+  void* other = nullptr;
+  std::thread([&other]() {
+    other = FreeList<OtherItem>::Allocate(sizeof(OtherItem));
+    // Freed here, so it stays in this thread's list until the thread exits.
+    FreeList<OtherItem>::Free(other, sizeof(OtherItem));
+  }).join();
+  EXPECT_NE(p, other);
+  void* q = FreeList<OtherItem>::Allocate(sizeof(OtherItem));
+  EXPECT_EQ(p, q);
+  FreeList<OtherItem>::Free(q, sizeof(OtherItem));
+}
+
+TEST(FreeListTest, ReleaseThreadCacheReturnsBlocksToHeap) {
+  std::thread([]() {
+    void* p = FreeList<Item>::Allocate(sizeof(Item));
+    FreeList<Item>::Free(p, sizeof(Item));
+    FreeList<Item>::ReleaseThreadCache();
+    // Later frees on this thread go straight to the heap.
+    void* q = FreeList<Item>::Allocate(sizeof(Item));
+    FreeList<Item>::Free(q, sizeof(Item));
+    void* r = FreeList<Item>::Allocate(sizeof(Item));
+    FreeList<Item>::Free(r, sizeof(Item));
+  }).join();
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  int result = RUN_ALL_TESTS();
+  return result;
+}